@@ -0,0 +1,58 @@
+// ----------------------------------------------------------------------------
+// Constants.cpp
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#include "Constants.h"
+
+
+namespace constants
+{
+const char socket_path[] = "/tmp/host_device";
+// milliseconds
+const int poll_timeout = 100;
+
+// microseconds
+const unsigned long farm_test_timeout = 1000000;
+const char farm_test_request[] = "[\"getDeviceId\"]\n";
+
+CONSTANT_STRING(device_name,"host_device");
+
+CONSTANT_STRING(firmware_name,"HostDevice");
+// Use semantic versioning http://semver.org/
+const modular_server::FirmwareInfo firmware_info =
+{
+  .name_ptr=&firmware_name,
+  .version_major=1,
+  .version_minor=0,
+  .version_patch=0,
+};
+
+CONSTANT_STRING(form_factor,"");
+CONSTANT_STRING(hardware_name,"Host");
+const modular_server::HardwareInfo hardware_info =
+{
+  .name_ptr=&hardware_name,
+  .part_number=0,
+  .version_major=0,
+  .version_minor=0,
+};
+
+// Pins
+
+// Units
+
+// Properties
+
+// Parameters
+CONSTANT_STRING(message_parameter_name,"message");
+
+// Functions
+CONSTANT_STRING(echo_function_name,"echo");
+
+// Callbacks
+
+// Errors
+}
@@ -0,0 +1,60 @@
+// ----------------------------------------------------------------------------
+// Constants.h
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#ifndef HOST_DEVICE_CONSTANTS_H
+#define HOST_DEVICE_CONSTANTS_H
+#include <ConstantVariable.h>
+#include <ModularServer.h>
+
+
+namespace constants
+{
+//MAX values must be >= 1, >= created/copied count, < RAM limit
+enum{PROPERTY_COUNT_MAX=1};
+enum{PARAMETER_COUNT_MAX=1};
+enum{FUNCTION_COUNT_MAX=1};
+enum{CALLBACK_COUNT_MAX=1};
+
+enum{PIN_COUNT_MAX=1};
+
+extern const char socket_path[];
+extern const int poll_timeout;
+
+enum{STRING_LENGTH_PATH=108};
+enum{FARM_EVENT_COUNT_MAX=64};
+enum{FARM_RESPONSE_LENGTH_MAX=256};
+extern const unsigned long farm_test_timeout;
+extern const char farm_test_request[];
+enum{DOUBLE_BENCH_ARRAY_LENGTH=32};
+
+extern ConstantString device_name;
+
+extern ConstantString firmware_name;
+extern const modular_server::FirmwareInfo firmware_info;
+
+extern ConstantString form_factor;
+extern ConstantString hardware_name;
+extern const modular_server::HardwareInfo hardware_info;
+
+// Pins
+
+// Units
+
+// Properties
+// Property values must be long, double, bool, long[], double[], bool[], char[], ConstantString *, (ConstantString *)[]
+
+// Parameters
+extern ConstantString message_parameter_name;
+
+// Functions
+extern ConstantString echo_function_name;
+
+// Callbacks
+
+// Errors
+}
+#endif
@@ -0,0 +1,119 @@
+// ----------------------------------------------------------------------------
+// DoubleBench.cpp
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#include "DoubleBench.h"
+
+
+bool DoubleBench::run(size_t value_count,
+  Print & report)
+{
+  size_t array_count = value_count / constants::DOUBLE_BENCH_ARRAY_LENGTH;
+  if (array_count == 0)
+  {
+    return false;
+  }
+  value_count = array_count * constants::DOUBLE_BENCH_ARRAY_LENGTH;
+  char value_str[JsonStream::STRING_LENGTH_DOUBLE];
+  unsigned long seed;
+  unsigned long time;
+
+  seed = 1;
+  time = micros();
+  for (size_t a=0; a<array_count; ++a)
+  {
+    fillValues(seed);
+    for (size_t i=0; i<constants::DOUBLE_BENCH_ARRAY_LENGTH; ++i)
+    {
+      dtostrf(values_[i],0,JsonStream::DOUBLE_DIGITS_DEFAULT,value_str);
+    }
+  }
+  printDuration(report,F("dtostrf"),micros() - time,value_count);
+
+  seed = 1;
+  time = micros();
+  for (size_t a=0; a<array_count; ++a)
+  {
+    fillValues(seed);
+    for (size_t i=0; i<constants::DOUBLE_BENCH_ARRAY_LENGTH; ++i)
+    {
+      modular_server::DoubleFormatter::format(value_str,JsonStream::STRING_LENGTH_DOUBLE,values_[i]);
+    }
+  }
+  printDuration(report,F("DoubleFormatter"),micros() - time,value_count);
+
+  JsonStream json_stream(null_stream_);
+
+  seed = 1;
+  time = micros();
+  for (size_t a=0; a<array_count; ++a)
+  {
+    fillValues(seed);
+    json_stream.writeArray(values_,constants::DOUBLE_BENCH_ARRAY_LENGTH);
+  }
+  printDuration(report,F("JsonStream array"),micros() - time,value_count);
+
+  seed = 1;
+  time = micros();
+  for (size_t a=0; a<array_count; ++a)
+  {
+    fillValues(seed);
+    json_stream.beginArray();
+    for (size_t i=0; i<constants::DOUBLE_BENCH_ARRAY_LENGTH; ++i)
+    {
+      json_stream.write(modular_server::FormattedDouble(values_[i]));
+    }
+    json_stream.endArray();
+  }
+  printDuration(report,F("FormattedDouble array"),micros() - time,value_count);
+
+  size_t mismatch_count = 0;
+  seed = 1;
+  for (size_t a=0; a<array_count; ++a)
+  {
+    fillValues(seed);
+    for (size_t i=0; i<constants::DOUBLE_BENCH_ARRAY_LENGTH; ++i)
+    {
+      modular_server::DoubleFormatter::format(value_str,JsonStream::STRING_LENGTH_DOUBLE,values_[i]);
+      if (strtod(value_str,NULL) != values_[i])
+      {
+        ++mismatch_count;
+      }
+    }
+  }
+  report.print(F("round trip mismatches "));
+  report.println(mismatch_count);
+  return mismatch_count == 0;
+}
+
+// private
+void DoubleBench::fillValues(unsigned long & seed)
+{
+  // values spread over the magnitudes properties use, from 1e-6 to 1e6, with
+  // both signs and mostly non terminating binary fractions
+  for (size_t i=0; i<constants::DOUBLE_BENCH_ARRAY_LENGTH; ++i)
+  {
+    seed = seed * 1103515245UL + 12345UL;
+    double mantissa = (double)((seed >> 8) & 0xFFFFF) / 0xFFFFF;
+    int exponent = (int)((seed >> 28) % 13) - 6;
+    double value = mantissa * pow(10,exponent);
+    values_[i] = (seed & 0x80) ? -value : value;
+  }
+}
+
+void DoubleBench::printDuration(Print & report,
+  const __FlashStringHelper * name,
+  unsigned long duration,
+  size_t value_count)
+{
+  report.print(name);
+  report.print(F(" values "));
+  report.print(value_count);
+  report.print(F(" duration "));
+  report.print(duration);
+  report.print(F(" us mean "));
+  report.print((duration * 1000UL) / value_count);
+  report.println(F(" ns per value"));
+}
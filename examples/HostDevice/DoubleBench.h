@@ -0,0 +1,37 @@
+// ----------------------------------------------------------------------------
+// DoubleBench.h
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#ifndef DOUBLE_BENCH_H
+#define DOUBLE_BENCH_H
+#include <Arduino.h>
+#include <JsonStream.h>
+#include <ModularServer.h>
+#include <ModularServer/NullStream.h>
+#include <ModularServer/FormattedDouble.h>
+
+#include "Constants.h"
+
+
+// Times writing doubles with dtostrf, the way a json stream writes them, against
+// DoubleFormatter, one value at a time and as arrays the size of a property
+// array, and checks that every shortest value reads back as the same double
+class DoubleBench
+{
+public:
+  bool run(size_t value_count,
+    Print & report);
+
+private:
+  modular_server::NullStream null_stream_;
+  double values_[constants::DOUBLE_BENCH_ARRAY_LENGTH];
+  void fillValues(unsigned long & seed);
+  void printDuration(Print & report,
+    const __FlashStringHelper * name,
+    unsigned long duration,
+    size_t value_count);
+};
+
+#endif
@@ -0,0 +1,131 @@
+// ----------------------------------------------------------------------------
+// HostDevice.cpp
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#include "HostDevice.h"
+
+
+void HostDevice::setup()
+{
+  // Server Setup
+  modular_server_.setup();
+
+  // Pin Setup
+
+  // Add Server Streams
+  // added by listen or replay
+
+  // Set Device ID
+  modular_server_.setDeviceName(constants::device_name);
+  modular_server_.setFormFactor(constants::form_factor);
+
+  // Add Hardware
+  modular_server_.addHardware(constants::hardware_info,
+    pins_);
+
+  // Pins
+
+  // Add Firmware
+  modular_server_.addFirmware(constants::firmware_info,
+    properties_,
+    parameters_,
+    functions_,
+    callbacks_);
+
+  // Properties
+
+  // Parameters
+  modular_server::Parameter & message_parameter = modular_server_.createParameter(constants::message_parameter_name);
+  message_parameter.setTypeString();
+
+  // Functions
+  modular_server::Function & echo_function = modular_server_.createFunction(constants::echo_function_name);
+  echo_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&HostDevice::echoHandler));
+  echo_function.addParameter(message_parameter);
+  echo_function.setResultTypeString();
+
+  // Callbacks
+}
+
+bool HostDevice::listen(const char * address)
+{
+  // each socket client becomes a server stream
+  socket_host_.attach(modular_server_);
+  // an address made only of digits is a loopback tcp port
+  if (strspn(address,"0123456789") == strlen(address))
+  {
+    return socket_host_.listenTcp(atoi(address));
+  }
+  return socket_host_.listenUnix(address);
+}
+
+int HostDevice::connectPair()
+{
+  // attaching again adds no server streams
+  socket_host_.attach(modular_server_);
+  return socket_host_.connectPair();
+}
+
+bool HostDevice::replay(const char * capture_path)
+{
+  capture_replay_.attach(modular_server_);
+  if (!capture_replay_.load(capture_path))
+  {
+    return false;
+  }
+  return capture_replay_.run(Serial);
+}
+
+void HostDevice::startServer()
+{
+  // Start Modular Device Server
+  modular_server_.startServer();
+}
+
+void HostDevice::update()
+{
+  // waits at most poll_timeout for request data
+  poll(constants::poll_timeout);
+}
+
+void HostDevice::poll(int timeout)
+{
+  socket_host_.poll(timeout);
+}
+
+int HostDevice::getEpollFd()
+{
+  return socket_host_.getEpollFd();
+}
+
+bool HostDevice::dataBuffered()
+{
+  return socket_host_.dataBuffered();
+}
+
+// Handlers must be non-blocking (avoid 'delay')
+//
+// modular_server_.parameter(parameter_name).getValue(value) value type must be either:
+// fixed-point number (int, long, etc.)
+// floating-point number (float, double)
+// bool
+// const char *
+// ArduinoJson::JsonArray
+// ArduinoJson::JsonObject
+// const ConstantString *
+//
+// For more info read about ArduinoJson parsing https://github.com/janelia-arduino/ArduinoJson
+//
+// modular_server_.property(property_name).getValue(value) value type must match the property default type
+// modular_server_.property(property_name).setValue(value) value type must match the property default type
+// modular_server_.property(property_name).getElementValue(element_index,value) value type must match the property array element default type
+// modular_server_.property(property_name).setElementValue(element_index,value) value type must match the property array element default type
+
+void HostDevice::echoHandler()
+{
+  const char * message;
+  modular_server_.parameter(constants::message_parameter_name).getValue(message);
+  modular_server_.response().returnResult(message);
+}
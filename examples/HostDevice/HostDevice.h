@@ -0,0 +1,49 @@
+// ----------------------------------------------------------------------------
+// HostDevice.h
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#ifndef HOST_DEVICE_H
+#define HOST_DEVICE_H
+#if !defined(EPOXY_DUINO)
+#error HostDevice only builds on Linux with EpoxyDuino
+#endif
+#include <Functor.h>
+#include <ModularServer.h>
+#include <ModularServer/SocketHost.h>
+#include <ModularServer/CaptureReplay.h>
+
+#include "Constants.h"
+
+
+class HostDevice
+{
+public:
+  void setup();
+  bool listen(const char * address);
+  int connectPair();
+  bool replay(const char * capture_path);
+  void startServer();
+  void update();
+  void poll(int timeout);
+  int getEpollFd();
+  bool dataBuffered();
+
+private:
+  modular_server::ModularServer modular_server_;
+  modular_server::SocketHost socket_host_;
+  modular_server::CaptureReplay capture_replay_;
+
+  modular_server::Pin pins_[constants::PIN_COUNT_MAX];
+
+  modular_server::Property properties_[constants::PROPERTY_COUNT_MAX];
+  modular_server::Parameter parameters_[constants::PARAMETER_COUNT_MAX];
+  modular_server::Function functions_[constants::FUNCTION_COUNT_MAX];
+  modular_server::Callback callbacks_[constants::CALLBACK_COUNT_MAX];
+
+  // Handlers
+  void echoHandler();
+};
+
+#endif
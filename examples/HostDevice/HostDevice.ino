@@ -0,0 +1,71 @@
+#include "HostDevice.h"
+#include "HostFarm.h"
+#include "DoubleBench.h"
+
+
+HostDevice dev;
+HostFarm farm;
+DoubleBench double_bench;
+bool farm_running = false;
+
+void setup()
+{
+  // HostDevice.out --farm device_count [unix socket path prefix]
+  if ((epoxy_argc > 2) && (strcmp(epoxy_argv[1],"--farm") == 0))
+  {
+    const char * path_prefix = (epoxy_argc > 3) ? epoxy_argv[3] : constants::socket_path;
+    if (!farm.setup(atoi(epoxy_argv[2])) || !farm.listen(path_prefix))
+    {
+      Serial.print(F("cannot listen on "));
+      Serial.println(path_prefix);
+      exit(1);
+    }
+    farm.startServers();
+    farm_running = true;
+    return;
+  }
+  // HostDevice.out --farm-test device_count round_count
+  if ((epoxy_argc > 3) && (strcmp(epoxy_argv[1],"--farm-test") == 0))
+  {
+    if (!farm.setup(atoi(epoxy_argv[2])) || !farm.connectPairs())
+    {
+      Serial.println(F("cannot connect socketpairs"));
+      exit(1);
+    }
+    farm.startServers();
+    exit(farm.test(atoi(epoxy_argv[3]),Serial) ? 0 : 1);
+  }
+
+  // HostDevice.out --double-bench value_count
+  if ((epoxy_argc > 2) && (strcmp(epoxy_argv[1],"--double-bench") == 0))
+  {
+    exit(double_bench.run(atol(epoxy_argv[2]),Serial) ? 0 : 1);
+  }
+
+  dev.setup();
+  // HostDevice.out --replay capture_path
+  if ((epoxy_argc > 2) && (strcmp(epoxy_argv[1],"--replay") == 0))
+  {
+    dev.startServer();
+    exit(dev.replay(epoxy_argv[2]) ? 0 : 1);
+  }
+  // HostDevice.out [unix socket path or tcp port]
+  const char * address = (epoxy_argc > 1) ? epoxy_argv[1] : constants::socket_path;
+  if (!dev.listen(address))
+  {
+    Serial.print(F("cannot listen on "));
+    Serial.println(address);
+    exit(1);
+  }
+  dev.startServer();
+}
+
+void loop()
+{
+  if (farm_running)
+  {
+    farm.update(constants::poll_timeout);
+    return;
+  }
+  dev.update();
+}
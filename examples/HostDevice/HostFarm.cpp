@@ -0,0 +1,213 @@
+// ----------------------------------------------------------------------------
+// HostFarm.cpp
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#include "HostFarm.h"
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+
+
+HostFarm::HostFarm()
+{
+  devices_ = NULL;
+  client_fds_ = NULL;
+  device_count_ = 0;
+  epoll_fd_ = -1;
+}
+
+HostFarm::~HostFarm()
+{
+  for (size_t i=0; i<device_count_; ++i)
+  {
+    if (client_fds_[i] >= 0)
+    {
+      ::close(client_fds_[i]);
+    }
+  }
+  if (epoll_fd_ >= 0)
+  {
+    ::close(epoll_fd_);
+  }
+  delete [] client_fds_;
+  delete [] devices_;
+}
+
+bool HostFarm::setup(size_t device_count)
+{
+  if ((devices_ != NULL) || (device_count == 0))
+  {
+    return false;
+  }
+  devices_ = new HostDevice[device_count];
+  client_fds_ = new int[device_count];
+  device_count_ = device_count;
+  for (size_t i=0; i<device_count_; ++i)
+  {
+    devices_[i].setup();
+    client_fds_[i] = -1;
+  }
+  epoll_fd_ = ::epoll_create1(0);
+  return (epoll_fd_ >= 0);
+}
+
+bool HostFarm::listen(const char * path_prefix)
+{
+  char path[constants::STRING_LENGTH_PATH];
+  for (size_t i=0; i<device_count_; ++i)
+  {
+    snprintf(path,sizeof(path),"%s%u",path_prefix,(unsigned)i);
+    if (!devices_[i].listen(path))
+    {
+      return false;
+    }
+  }
+  return watch();
+}
+
+bool HostFarm::connectPairs()
+{
+  for (size_t i=0; i<device_count_; ++i)
+  {
+    client_fds_[i] = devices_[i].connectPair();
+    if (client_fds_[i] < 0)
+    {
+      return false;
+    }
+  }
+  return watch();
+}
+
+void HostFarm::startServers()
+{
+  for (size_t i=0; i<device_count_; ++i)
+  {
+    devices_[i].startServer();
+  }
+}
+
+void HostFarm::update(int timeout)
+{
+  // requests already buffered must not wait on the next socket event
+  for (size_t i=0; i<device_count_; ++i)
+  {
+    if (devices_[i].dataBuffered())
+    {
+      timeout = 0;
+      break;
+    }
+  }
+  struct epoll_event events[constants::FARM_EVENT_COUNT_MAX];
+  int event_count = ::epoll_wait(epoll_fd_,events,constants::FARM_EVENT_COUNT_MAX,timeout);
+  for (int i=0; i<event_count; ++i)
+  {
+    static_cast<HostDevice *>(events[i].data.ptr)->poll(0);
+  }
+  for (size_t i=0; i<device_count_; ++i)
+  {
+    if (devices_[i].dataBuffered())
+    {
+      devices_[i].poll(0);
+    }
+  }
+}
+
+bool HostFarm::test(size_t round_count,
+  Print & report)
+{
+  if ((client_fds_ == NULL) || (client_fds_[0] < 0) || (round_count == 0))
+  {
+    return false;
+  }
+  size_t request_length = strlen(constants::farm_test_request);
+  bool * received = new bool[device_count_];
+  bool success = true;
+  unsigned long duration_max = 0;
+  unsigned long time = micros();
+  for (size_t round=0; success && (round<round_count); ++round)
+  {
+    // every device gets a request before any response is read, so the
+    // devices have requests pending at the same time
+    unsigned long round_time = micros();
+    for (size_t i=0; i<device_count_; ++i)
+    {
+      received[i] = false;
+      if (::send(client_fds_[i],constants::farm_test_request,request_length,0) != (ssize_t)request_length)
+      {
+        success = false;
+      }
+    }
+    while (success && !receiveResponses(received))
+    {
+      update(0);
+      if ((micros() - round_time) > constants::farm_test_timeout)
+      {
+        success = false;
+      }
+    }
+    unsigned long round_duration = micros() - round_time;
+    if (round_duration > duration_max)
+    {
+      duration_max = round_duration;
+    }
+  }
+  unsigned long duration = micros() - time;
+  delete [] received;
+
+  unsigned long request_count = device_count_ * round_count;
+  report.print(F("devices "));
+  report.print(device_count_);
+  report.print(F(" requests "));
+  report.print(request_count);
+  report.print(F(" duration "));
+  report.print(duration);
+  report.print(F(" us mean "));
+  report.print(duration / request_count);
+  report.print(F(" us per request max round "));
+  report.print(duration_max);
+  report.println(success ? F(" us") : F(" us timed out"));
+  return success;
+}
+
+// private
+bool HostFarm::watch()
+{
+  for (size_t i=0; i<device_count_; ++i)
+  {
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.ptr = &devices_[i];
+    if (::epoll_ctl(epoll_fd_,EPOLL_CTL_ADD,devices_[i].getEpollFd(),&event) < 0)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool HostFarm::receiveResponses(bool * received)
+{
+  // compact responses end with the only newline they contain
+  bool all_received = true;
+  char response[constants::FARM_RESPONSE_LENGTH_MAX];
+  for (size_t i=0; i<device_count_; ++i)
+  {
+    if (received[i])
+    {
+      continue;
+    }
+    ssize_t length = ::recv(client_fds_[i],response,sizeof(response),MSG_DONTWAIT);
+    if ((length > 0) && (memchr(response,'\n',length) != NULL))
+    {
+      received[i] = true;
+    }
+    else
+    {
+      all_received = false;
+    }
+  }
+  return all_received;
+}
@@ -0,0 +1,42 @@
+// ----------------------------------------------------------------------------
+// HostFarm.h
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#ifndef HOST_FARM_H
+#define HOST_FARM_H
+#include <Arduino.h>
+
+#include "HostDevice.h"
+#include "Constants.h"
+
+
+// Runs many HostDevice instances in one program, each an independent virtual
+// device with its own server and sockets, and waits on all of them at once.
+// The devices share one thread since the pin pulse timer and the emulated
+// EEPROM are process wide.
+class HostFarm
+{
+public:
+  HostFarm();
+  ~HostFarm();
+
+  bool setup(size_t device_count);
+  bool listen(const char * path_prefix);
+  bool connectPairs();
+  void startServers();
+  void update(int timeout);
+  bool test(size_t round_count,
+    Print & report);
+
+private:
+  HostDevice * devices_;
+  int * client_fds_;
+  size_t device_count_;
+  int epoll_fd_;
+  bool watch();
+  bool receiveResponses(bool * received);
+};
+
+#endif
@@ -0,0 +1,428 @@
+#!/usr/bin/env python3
+# ----------------------------------------------------------------------------
+# generate_api_tables.py
+#
+#
+# Authors:
+# Peter Polidoro peterpolidoro@gmail.com
+# ----------------------------------------------------------------------------
+"""Generate ModularServer API tables from an api/*.json file.
+
+Reads a getApi response with DETAILED verbosity, saved from a device with
+the request ["getApi","DETAILED",["ALL"]], and writes ApiTables.h and
+ApiTables.cpp. They contain the function, parameter, property and callback
+name constant strings, units, subsets, property default values and the
+ParameterInfo, FunctionInfo, PropertyInfo and CallbackInfo tables that may be
+passed to createParameters, createFunctions, setupProperties and
+createCallbacks. Elements of the ModularServer firmware itself are skipped.
+
+Usage:
+  python3 generate_api_tables.py StringController_detailed.json [output_directory]
+"""
+import argparse
+import json
+import os
+import re
+import sys
+
+
+JSON_TYPES = {
+    'long': 'JsonStream::LONG_TYPE',
+    'double': 'JsonStream::DOUBLE_TYPE',
+    'bool': 'JsonStream::BOOL_TYPE',
+    'null': 'JsonStream::NULL_TYPE',
+    'string': 'JsonStream::STRING_TYPE',
+    'object': 'JsonStream::OBJECT_TYPE',
+    'array': 'JsonStream::ARRAY_TYPE',
+    'any': 'JsonStream::ANY_TYPE',
+}
+
+HEADER_COMMENT = '''// ----------------------------------------------------------------------------
+// {file_name}
+//
+// Generated by extras/generate_api_tables.py from {api_file_name}, do not edit.
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------'''
+
+
+SERVER_FIRMWARE = 'ModularServer'
+
+
+class ApiError(Exception):
+    pass
+
+
+def snake_case(name):
+    name = re.sub(r'([a-z0-9])([A-Z])', r'\1_\2', name)
+    name = re.sub(r'[^0-9A-Za-z]+', '_', name)
+    return name.strip('_').lower()
+
+
+def json_type(type_name, context):
+    try:
+        return JSON_TYPES[type_name]
+    except KeyError:
+        raise ApiError('{0}: unknown type "{1}"'.format(context, type_name))
+
+
+def c_string(value):
+    return json.dumps(value)
+
+
+def number_literal(value, type_name):
+    if type_name == 'double':
+        return '{{.d={0}}}'.format(repr(float(value)))
+    return '{{.l={0}}}'.format(int(value))
+
+
+def value_literal(value, type_name, context):
+    if type_name == 'long':
+        return str(int(value))
+    if type_name == 'double':
+        return repr(float(value))
+    if type_name == 'bool':
+        return 'true' if value else 'false'
+    raise ApiError('{0}: default values of type "{1}" are not supported'.format(context, type_name))
+
+
+def firmware_elements(result, key):
+    # elements only carry their firmware name when more than one firmware is requested
+    return [element for element in result.get(key, []) if element.get('firmware') != SERVER_FIRMWARE]
+
+
+class ApiTables:
+    def __init__(self, api, namespace):
+        self.namespace = namespace
+        result = api.get('result', api)
+        verbosity = result.get('verbosity')
+        if verbosity != 'DETAILED':
+            raise ApiError('verbosity is {0}, save the response to ["getApi","DETAILED",["ALL"]] instead'.format(verbosity))
+        self.functions = firmware_elements(result, 'functions')
+        self.parameters = firmware_elements(result, 'parameters')
+        self.properties = firmware_elements(result, 'properties')
+        self.callbacks = firmware_elements(result, 'callbacks')
+        self.units = []
+        self.subset_strings = []
+        self.subsets = {}
+        self._check()
+
+    def _check(self):
+        parameter_names = [parameter['name'] for parameter in self.parameters]
+        for function in self.functions:
+            for parameter_name in function.get('parameters', []):
+                if parameter_name not in parameter_names:
+                    raise ApiError('function {0}: parameter {1} is not defined by this firmware'.format(function['name'], parameter_name))
+        for parameter in self.parameters:
+            self._add_units(parameter.get('units'))
+            self._add_subset(self.subset_name(parameter['name']), parameter, 'parameter')
+        for prop in self.properties:
+            self._add_units(prop.get('units'))
+            self._add_subset(self.property_subset_name(prop['name']), prop, 'property')
+        for function in self.functions:
+            self._add_units(function.get('result_info', {}).get('units'))
+
+    def _add_units(self, units):
+        if units and units not in self.units:
+            self.units.append(units)
+
+    def _add_subset(self, subset_name, element, kind):
+        subset = element.get('subset', element.get('array_element_subset'))
+        if subset is None:
+            return
+        element_type = element['type']
+        if element_type == 'array':
+            element_type = element.get('array_element_type', 'any')
+        if element_type == 'string':
+            for member in subset:
+                if member not in self.subset_strings:
+                    self.subset_strings.append(member)
+        elif element_type != 'long':
+            raise ApiError('{0} {1}: subsets must be long or string'.format(kind, element['name']))
+        self.subsets[subset_name] = (element_type, subset)
+
+    def function_name(self, name):
+        return '{0}_function_name'.format(snake_case(name))
+
+    def parameter_name(self, name):
+        return '{0}_parameter_name'.format(snake_case(name))
+
+    def units_name(self, units):
+        return '{0}_units'.format(snake_case(units))
+
+    def subset_string_name(self, member):
+        return '{0}_subset_string'.format(snake_case(member))
+
+    def subset_name(self, parameter_name):
+        return '{0}_subset'.format(snake_case(parameter_name))
+
+    def property_name(self, name):
+        return '{0}_property_name'.format(snake_case(name))
+
+    def property_subset_name(self, property_name):
+        return '{0}_property_subset'.format(snake_case(property_name))
+
+    def property_default_name(self, property_name):
+        return '{0}_default'.format(snake_case(property_name))
+
+    def callback_name(self, name):
+        return '{0}_callback_name'.format(snake_case(name))
+
+    def header(self, api_file_name):
+        lines = [HEADER_COMMENT.format(file_name='ApiTables.h', api_file_name=api_file_name)]
+        lines.append('#ifndef _API_TABLES_H_')
+        lines.append('#define _API_TABLES_H_')
+        lines.append('#include <ModularServer.h>')
+        lines.append('')
+        lines.append('')
+        lines.append('namespace {0}'.format(self.namespace))
+        lines.append('{')
+        lines.append('enum{{API_FUNCTION_COUNT={0}}};'.format(len(self.functions)))
+        lines.append('enum{{API_PARAMETER_COUNT={0}}};'.format(len(self.parameters)))
+        lines.append('enum{{API_PROPERTY_COUNT={0}}};'.format(len(self.properties)))
+        lines.append('enum{{API_CALLBACK_COUNT={0}}};'.format(len(self.callbacks)))
+        lines.append('')
+        lines.append('// Units')
+        for units in self.units:
+            lines.append('extern ConstantString {0};'.format(self.units_name(units)))
+        lines.append('')
+        lines.append('// Properties')
+        for prop in self.properties:
+            lines.append('extern ConstantString {0};'.format(self.property_name(prop['name'])))
+            lines.append('extern {0};'.format(self._property_default_declaration(prop)))
+        lines.append('')
+        lines.append('// Parameters')
+        for parameter in self.parameters:
+            lines.append('extern ConstantString {0};'.format(self.parameter_name(parameter['name'])))
+        lines.append('')
+        lines.append('// Functions')
+        for function in self.functions:
+            lines.append('extern ConstantString {0};'.format(self.function_name(function['name'])))
+        lines.append('')
+        lines.append('// Callbacks')
+        for callback in self.callbacks:
+            lines.append('extern ConstantString {0};'.format(self.callback_name(callback['name'])))
+        lines.append('')
+        # zero length tables are not valid C++
+        if self.properties:
+            lines.append('extern const modular_server::PropertyInfo property_info_table[API_PROPERTY_COUNT];')
+        if self.parameters:
+            lines.append('extern const modular_server::ParameterInfo parameter_info_table[API_PARAMETER_COUNT];')
+        if self.functions:
+            lines.append('extern const modular_server::FunctionInfo function_info_table[API_FUNCTION_COUNT];')
+        if self.callbacks:
+            lines.append('extern const modular_server::CallbackInfo callback_info_table[API_CALLBACK_COUNT];')
+        lines.append('}')
+        lines.append('#endif')
+        lines.append('')
+        return '\n'.join(lines)
+
+    def source(self, api_file_name):
+        lines = [HEADER_COMMENT.format(file_name='ApiTables.cpp', api_file_name=api_file_name)]
+        lines.append('#include "ApiTables.h"')
+        lines.append('')
+        lines.append('')
+        lines.append('namespace {0}'.format(self.namespace))
+        lines.append('{')
+        lines.append('// Units')
+        for units in self.units:
+            lines.append('CONSTANT_STRING({0},{1});'.format(self.units_name(units), c_string(units)))
+        if self.subset_strings:
+            lines.append('')
+            lines.append('// Subsets')
+            for member in self.subset_strings:
+                lines.append('CONSTANT_STRING({0},{1});'.format(self.subset_string_name(member), c_string(member)))
+        for subset_name, (element_type, subset) in self.subsets.items():
+            lines.append('')
+            lines.append('modular_server::SubsetMemberType {0}[{1}] ='.format(subset_name, len(subset)))
+            lines.append('{')
+            for member in subset:
+                if element_type == 'string':
+                    lines.append('  {{.cs_ptr=&{0}}},'.format(self.subset_string_name(member)))
+                else:
+                    lines.append('  {{.l={0}}},'.format(int(member)))
+            lines.append('};')
+        lines.append('')
+        lines.append('// Properties')
+        for prop in self.properties:
+            lines.append('CONSTANT_STRING({0},{1});'.format(self.property_name(prop['name']), c_string(prop['name'])))
+            lines.append('{0} = {1};'.format(self._property_default_declaration(prop), self._property_default_value(prop)))
+        if self.properties:
+            lines.append('')
+            lines.append('const modular_server::PropertyInfo property_info_table[API_PROPERTY_COUNT] PROGMEM =')
+            lines.append('{')
+            for prop in self.properties:
+                lines.extend(self._parameter_info(prop, self.property_name(prop['name']), self.property_subset_name(prop['name'])))
+            lines.append('};')
+        lines.append('')
+        lines.append('// Parameters')
+        for parameter in self.parameters:
+            lines.append('CONSTANT_STRING({0},{1});'.format(self.parameter_name(parameter['name']), c_string(parameter['name'])))
+        if self.parameters:
+            lines.append('')
+            lines.append('const modular_server::ParameterInfo parameter_info_table[API_PARAMETER_COUNT] PROGMEM =')
+            lines.append('{')
+            for parameter in self.parameters:
+                lines.extend(self._parameter_info(parameter, self.parameter_name(parameter['name']), self.subset_name(parameter['name'])))
+            lines.append('};')
+        lines.append('')
+        lines.append('// Functions')
+        for function in self.functions:
+            lines.append('CONSTANT_STRING({0},{1});'.format(self.function_name(function['name']), c_string(function['name'])))
+        for function in self.functions:
+            parameter_names = function.get('parameters', [])
+            if parameter_names:
+                lines.append('')
+                lines.append('const ConstantString * const {0}_parameter_names[{1}] PROGMEM ='.format(snake_case(function['name']), len(parameter_names)))
+                lines.append('{')
+                for parameter_name in parameter_names:
+                    lines.append('  &{0},'.format(self.parameter_name(parameter_name)))
+                lines.append('};')
+        if self.functions:
+            lines.append('')
+            lines.append('const modular_server::FunctionInfo function_info_table[API_FUNCTION_COUNT] PROGMEM =')
+            lines.append('{')
+            for function in self.functions:
+                lines.extend(self._function_info(function))
+            lines.append('};')
+        lines.append('')
+        lines.append('// Callbacks')
+        for callback in self.callbacks:
+            lines.append('CONSTANT_STRING({0},{1});'.format(self.callback_name(callback['name']), c_string(callback['name'])))
+        if self.callbacks:
+            lines.append('')
+            lines.append('const modular_server::CallbackInfo callback_info_table[API_CALLBACK_COUNT] PROGMEM =')
+            lines.append('{')
+            for callback in self.callbacks:
+                lines.append('  {{.name_ptr=&{0}}},'.format(self.callback_name(callback['name'])))
+            lines.append('};')
+        lines.append('}')
+        lines.append('')
+        return '\n'.join(lines)
+
+    def _property_default(self, prop):
+        if 'default_value' not in prop:
+            raise ApiError('property {0}: no default_value, the api file must have DETAILED verbosity'.format(prop['name']))
+        return prop['default_value']
+
+    def _property_default_declaration(self, prop):
+        # array property capacities are the lengths of their default values
+        name = self.property_default_name(prop['name'])
+        default_value = self._property_default(prop)
+        type_name = prop['type']
+        has_subset = self.property_subset_name(prop['name']) in self.subsets
+        if type_name == 'string':
+            if has_subset:
+                return 'const ConstantString * const {0}'.format(name)
+            length = int(prop.get('string_length_max', len(default_value))) + 1
+            return 'const char {0}[{1}]'.format(name, length)
+        if type_name == 'array':
+            element_type_name = prop.get('array_element_type', 'any')
+            if (element_type_name == 'string') and has_subset:
+                return 'const ConstantString * const {0}[{1}]'.format(name, len(default_value))
+            if element_type_name not in ('long', 'double', 'bool'):
+                raise ApiError('property {0}: default values of type "{1}" are not supported'.format(prop['name'], element_type_name))
+            return 'const {0} {1}[{2}]'.format(element_type_name, name, len(default_value))
+        if type_name not in ('long', 'double', 'bool'):
+            raise ApiError('property {0}: default values of type "{1}" are not supported'.format(prop['name'], type_name))
+        return 'const {0} {1}'.format(type_name, name)
+
+    def _property_default_value(self, prop):
+        default_value = self._property_default(prop)
+        type_name = prop['type']
+        context = 'property ' + prop['name']
+        if type_name == 'string':
+            if self.property_subset_name(prop['name']) in self.subsets:
+                return '&' + self.subset_string_name(default_value)
+            return c_string(default_value)
+        if type_name == 'array':
+            element_type_name = prop.get('array_element_type', 'any')
+            if element_type_name == 'string':
+                values = ['&' + self.subset_string_name(value) for value in default_value]
+            else:
+                values = [value_literal(value, element_type_name, context) for value in default_value]
+            return '{' + ','.join(values) + '}'
+        return value_literal(default_value, type_name, context)
+
+    def _parameter_info(self, parameter, name_ref, subset_name):
+        name = parameter['name']
+        type_name = parameter['type']
+        element_type_name = parameter.get('array_element_type', type_name)
+        json_type(type_name, 'parameter ' + name)
+        json_type(element_type_name, 'parameter ' + name)
+        number_type_name = element_type_name if (type_name == 'array') else type_name
+        prefix = 'array_element_' if (type_name == 'array') else ''
+        range_is_set = ((prefix + 'min') in parameter) and ((prefix + 'max') in parameter)
+        array_length_range_is_set = ('array_length_min' in parameter) and ('array_length_max' in parameter)
+        has_subset = subset_name in self.subsets
+        units = parameter.get('units')
+        lines = ['  {']
+        lines.append('    .name_ptr=&{0},'.format(name_ref))
+        lines.append('    .type={0},'.format(json_type(type_name, 'parameter ' + name)))
+        lines.append('    .array_element_type={0},'.format(json_type(element_type_name, 'parameter ' + name)))
+        lines.append('    .units_ptr={0},'.format('&' + self.units_name(units) if units else 'NULL'))
+        lines.append('    .range_is_set={0},'.format('true' if range_is_set else 'false'))
+        if range_is_set:
+            lines.append('    .min={0},'.format(number_literal(parameter[prefix + 'min'], number_type_name)))
+            lines.append('    .max={0},'.format(number_literal(parameter[prefix + 'max'], number_type_name)))
+        else:
+            lines.append('    .min={.l=0},')
+            lines.append('    .max={.l=0},')
+        lines.append('    .array_length_range_is_set={0},'.format('true' if array_length_range_is_set else 'false'))
+        lines.append('    .array_length_min={0},'.format(int(parameter.get('array_length_min', 0))))
+        lines.append('    .array_length_max={0},'.format(int(parameter.get('array_length_max', 0))))
+        if has_subset:
+            lines.append('    .subset_ptr={0},'.format(subset_name))
+            lines.append('    .subset_size=sizeof({0})/sizeof({0}[0]),'.format(subset_name))
+        else:
+            lines.append('    .subset_ptr=NULL,')
+            lines.append('    .subset_size=0,')
+        lines.append('  },')
+        return lines
+
+    def _function_info(self, function):
+        name = function['name']
+        parameter_names = function.get('parameters', [])
+        result_info = function.get('result_info', {})
+        result_type_name = result_info.get('type', 'null')
+        result_element_type_name = result_info.get('array_element_type', result_type_name)
+        units = result_info.get('units')
+        lines = ['  {']
+        lines.append('    .name_ptr=&{0},'.format(self.function_name(name)))
+        if parameter_names:
+            lines.append('    .parameter_name_ptrs={0}_parameter_names,'.format(snake_case(name)))
+        else:
+            lines.append('    .parameter_name_ptrs=NULL,')
+        lines.append('    .parameter_count={0},'.format(len(parameter_names)))
+        lines.append('    .result_type={0},'.format(json_type(result_type_name, 'function ' + name)))
+        lines.append('    .result_array_element_type={0},'.format(json_type(result_element_type_name, 'function ' + name)))
+        lines.append('    .result_units_ptr={0},'.format('&' + self.units_name(units) if units else 'NULL'))
+        lines.append('  },')
+        return lines
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate ModularServer API tables from an api/*.json file.')
+    parser.add_argument('api_file', help='getApi response saved as json')
+    parser.add_argument('output_directory', nargs='?', default='.', help='directory to write ApiTables.h and ApiTables.cpp')
+    # a namespace of its own so the names never collide with the firmware constants
+    parser.add_argument('--namespace', default='api_tables', help='namespace of the generated tables')
+    args = parser.parse_args()
+
+    with open(args.api_file) as api_file:
+        api = json.load(api_file)
+    try:
+        api_tables = ApiTables(api, args.namespace)
+    except ApiError as error:
+        sys.exit('{0}: {1}'.format(args.api_file, error))
+
+    api_file_name = os.path.basename(args.api_file)
+    with open(os.path.join(args.output_directory, 'ApiTables.h'), 'w') as header_file:
+        header_file.write(api_tables.header(api_file_name))
+    with open(os.path.join(args.output_directory, 'ApiTables.cpp'), 'w') as source_file:
+        source_file.write(api_tables.source(api_file_name))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,413 @@
+#!/usr/bin/env python3
+# ----------------------------------------------------------------------------
+# latency_search.py
+#
+#
+# Authors:
+# Peter Polidoro peterpolidoro@gmail.com
+# ----------------------------------------------------------------------------
+"""Search for ModularServer requests with the worst case handling time.
+
+Mutates valid requests built from the api the device reports to
+["getApi","DETAILED",["ALL"]] (long arrays, ?? on every function, parameter
+and property, every subset member, large firmware lists), sends each one to a
+device over a serial port or to a host build over a unix or tcp socket, and
+reads back the server side timing from getRequestTrace and the stack high
+water mark from getMemoryUsage. The mark is cleared with resetStackHighWater
+before every request, so each request is measured on its own.
+
+The requests that took the longest to handle and the ones that used the most
+stack are saved as a json corpus together with their recorded timings. A
+saved corpus may be replayed to check a new build for regressions.
+
+getRequestTrace is only built when the device is compiled with
+MODULAR_SERVER_REQUEST_TRACE_COUNT_MAX set to 2 or more.
+
+Usage:
+  python3 latency_search.py --unix /tmp/modular_device
+  python3 latency_search.py --serial /dev/ttyACM0 -o corpus.json
+  python3 latency_search.py --replay corpus.json --tcp 127.0.0.1:8080
+"""
+import argparse
+import json
+import random
+import socket
+import sys
+import time
+
+
+BUILTIN_FUNCTIONS = [
+    'getDeviceId',
+    'getDeviceInfo',
+    'getApi',
+    'getPropertyDefaultValues',
+    'setPropertiesToDefaults',
+    'getPropertyValues',
+    'getPinInfo',
+    'getMemoryUsage',
+]
+
+SERVER_FIRMWARE = 'ModularServer'
+
+VERBOSITIES = ['NAMES', 'GENERAL', 'DETAILED']
+
+ARRAY_FUNCTIONS = [
+    'getElementValue',
+    'setElementValue',
+    'getElementValues',
+    'setElementValues',
+    'setAllElementValues',
+    'getArrayLength',
+    'setArrayLength',
+]
+
+LONG_EXTREMES = [0, 1, -1, 2147483647, -2147483648]
+DOUBLE_EXTREMES = [0.0, -1.0, 1.0e38, -1.0e38, 1.0e-38]
+STRING_LENGTH_MAX = 256
+ARRAY_LENGTH_DEFAULT = 64
+FIRMWARE_COUNT_MAX = 32
+
+
+class TransportError(Exception):
+    pass
+
+
+class SocketTransport:
+    def __init__(self, sock, timeout):
+        self.sock = sock
+        self.sock.settimeout(timeout)
+        self.buffer = b''
+
+    def request(self, request):
+        self.sock.sendall(request.encode() + b'\n')
+        while b'\n' not in self.buffer:
+            try:
+                data = self.sock.recv(4096)
+            except socket.timeout:
+                raise TransportError('response timeout')
+            if not data:
+                raise TransportError('connection closed')
+            self.buffer += data
+        line, self.buffer = self.buffer.split(b'\n', 1)
+        return line.decode(errors='replace').strip()
+
+    def close(self):
+        self.sock.close()
+
+
+class SerialTransport:
+    def __init__(self, port, baud, timeout):
+        try:
+            import serial
+        except ImportError:
+            raise TransportError('pyserial is required for serial ports')
+        self.serial = serial.Serial(port, baud, timeout=timeout)
+        time.sleep(2)
+        self.serial.reset_input_buffer()
+
+    def request(self, request):
+        self.serial.write(request.encode() + b'\n')
+        line = self.serial.readline()
+        if not line.endswith(b'\n'):
+            raise TransportError('response timeout')
+        return line.decode(errors='replace').strip()
+
+    def close(self):
+        self.serial.close()
+
+
+def open_transport(args):
+    if args.unix:
+        sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        sock.connect(args.unix)
+        return SocketTransport(sock, args.timeout)
+    if args.tcp:
+        host, port = args.tcp.rsplit(':', 1)
+        sock = socket.create_connection((host, int(port)))
+        return SocketTransport(sock, args.timeout)
+    return SerialTransport(args.serial, args.baud, args.timeout)
+
+
+class Probe:
+    """Sends a request then reads its server side trace and stack usage."""
+
+    def __init__(self, transport):
+        self.transport = transport
+        # getMemoryUsage adds its own stack use to every reading
+        self.call(['resetStackHighWater'])
+        self.stack_baseline = self._stack_high_water()
+        self.stack_high_water = 0
+
+    def call(self, request):
+        response = self.transport.request(json.dumps(request, separators=(',', ':')))
+        try:
+            return json.loads(response)
+        except ValueError:
+            raise TransportError('invalid response: {0}'.format(response[:80]))
+
+    def _stack_high_water(self):
+        response = self.call(['getMemoryUsage'])
+        return response.get('result', {}).get('stack_high_water', 0)
+
+    def measure(self, request):
+        self.call(['resetStackHighWater'])
+        started = time.monotonic()
+        response = self.transport.request(request)
+        round_trip = int((time.monotonic() - started) * 1000000)
+        stack_high_water = self._stack_high_water()
+        stack_increase = max(0, stack_high_water - self.stack_baseline)
+        self.stack_high_water = max(stack_high_water, self.stack_high_water)
+        # the request is traced just before getMemoryUsage
+        response = self.call(['getRequestTrace'])
+        if 'error' in response:
+            raise TransportError('getRequestTrace is not available, build the device '
+                                 'with MODULAR_SERVER_REQUEST_TRACE_COUNT_MAX of 2 or more')
+        traces = response.get('result', [])
+        if len(traces) < 2:
+            raise TransportError('getRequestTrace returned too few traces')
+        trace = traces[-2]
+        server_duration = sum(trace.get(key, 0) for key in
+                              ('read_duration', 'sanitize_duration', 'deserialize_duration',
+                               'lookup_duration', 'check_duration', 'handler_duration',
+                               'end_duration'))
+        return {
+            'request': request,
+            'server_duration': server_duration,
+            'handler_duration': trace.get('handler_duration', 0),
+            'end_duration': trace.get('end_duration', 0),
+            'bytes_read': trace.get('bytes_read', 0),
+            'error_code': trace.get('error_code', 0),
+            'round_trip': round_trip,
+            'stack_high_water': stack_high_water,
+            'stack_increase': stack_increase,
+            'response_length': len(response),
+        }
+
+
+def firmware_elements(result, key):
+    # server functions such as setResponseFraming would change the transport
+    return [element for element in result.get(key, []) if element.get('firmware') != SERVER_FIRMWARE]
+
+
+class Mutator:
+    """Builds valid requests from a DETAILED api and mutates them toward worst cases."""
+
+    def __init__(self, api, rng):
+        result = api.get('result', api)
+        self.rng = rng
+        self.functions = firmware_elements(result, 'functions')
+        self.parameters = dict((parameter['name'], parameter) for parameter in firmware_elements(result, 'parameters'))
+        self.properties = firmware_elements(result, 'properties')
+        self.firmware = sorted(set(element['firmware'] for key in ('functions', 'parameters', 'properties', 'callbacks')
+                                   for element in firmware_elements(result, key) if 'firmware' in element))
+
+    def seeds(self):
+        requests = [['??'], ['?']]
+        for name in BUILTIN_FUNCTIONS:
+            requests.append([name])
+        for verbosity in VERBOSITIES:
+            requests.append(['getApi', verbosity, ['ALL']])
+            requests.append(['getApi', verbosity, self.firmware_list()])
+        for function in self.functions:
+            requests.append([function['name'], '??'])
+            requests.append([function['name']] + [self.value(self.parameters.get(name, {}), 'max')
+                                                  for name in function.get('parameters', [])])
+            for name in function.get('parameters', []):
+                requests.append([function['name'], name, '??'])
+        for parameter_name in self.parameters:
+            requests.append([parameter_name, '??'])
+        for prop in self.properties:
+            requests.extend(self.property_requests(prop))
+        return requests
+
+    def firmware_list(self):
+        names = list(self.firmware) + ['ModularServer', 'ALL']
+        return [names[i % len(names)] for i in range(FIRMWARE_COUNT_MAX)]
+
+    def subset(self, parameter):
+        return parameter.get('subset', parameter.get('array_element_subset'))
+
+    def element(self, parameter, extreme):
+        subset = self.subset(parameter)
+        if subset:
+            return subset[-1] if extreme == 'max' else self.rng.choice(subset)
+        element_type = parameter.get('array_element_type', parameter.get('type'))
+        if element_type == 'long':
+            if extreme == 'max' and 'max' in parameter:
+                return parameter['max']
+            return self.rng.choice(LONG_EXTREMES)
+        if element_type == 'double':
+            if extreme == 'max' and 'max' in parameter:
+                return parameter['max']
+            return self.rng.choice(DOUBLE_EXTREMES)
+        if element_type == 'bool':
+            return self.rng.choice([True, False])
+        if element_type == 'string':
+            length = STRING_LENGTH_MAX if extreme == 'max' else self.rng.randint(0, STRING_LENGTH_MAX)
+            return 'x' * length
+        return None
+
+    def array_length(self, parameter, extreme):
+        length_max = parameter.get('array_length_max', ARRAY_LENGTH_DEFAULT)
+        if extreme == 'max':
+            return length_max
+        return self.rng.randint(parameter.get('array_length_min', 0), length_max)
+
+    def value(self, parameter, extreme):
+        if parameter.get('type') == 'array':
+            length = self.array_length(parameter, extreme)
+            return [self.element(parameter, extreme) for _ in range(length)]
+        if parameter.get('type') == 'object':
+            return dict(('k{0}'.format(i), i) for i in range(self.rng.randint(0, 32)))
+        return self.element(parameter, extreme)
+
+    def property_requests(self, prop):
+        name = prop['name']
+        requests = [[name, '??'], [name, 'getValue'], [name, 'getDefaultValue'],
+                    [name, 'setValue', self.value(prop, 'max')]]
+        subset = self.subset(prop)
+        if subset:
+            for member in subset:
+                if prop.get('type') == 'array':
+                    requests.append([name, 'setAllElementValues', member])
+                else:
+                    requests.append([name, 'setValue', member])
+        if prop.get('type') == 'array':
+            length = prop.get('array_length_max', ARRAY_LENGTH_DEFAULT)
+            requests.append([name, 'getElementValues', 0, length])
+            requests.append([name, 'setElementValues', 0, self.value(prop, 'max')])
+            requests.append([name, 'setArrayLength', length])
+            for function_name in ARRAY_FUNCTIONS:
+                requests.append([name, function_name, '??'])
+        return requests
+
+    def mutate(self, request):
+        request = json.loads(json.dumps(request))
+        choice = self.rng.randrange(5)
+        if (choice == 0) and (len(request) > 1):
+            index = self.rng.randrange(1, len(request))
+            request[index] = '??'
+        elif choice == 1:
+            for index, value in enumerate(request):
+                if isinstance(value, list) and value:
+                    request[index] = value + value
+        elif choice == 2:
+            for index, value in enumerate(request):
+                if isinstance(value, str) and (index > 0) and (value not in ('??', '?')):
+                    request[index] = value * 2
+        elif choice == 3:
+            request.append('??')
+        else:
+            for index, value in enumerate(request):
+                if isinstance(value, list):
+                    request[index] = [self.rng.choice(value)] * len(value) if value else value
+        return request
+
+
+def encode(request):
+    return json.dumps(request, separators=(',', ':'))
+
+
+def keep_worst(corpus, measurement, key, count):
+    corpus.append(measurement)
+    corpus.sort(key=lambda entry: entry[key], reverse=True)
+    del corpus[count:]
+
+
+def search(probe, mutator, iterations, count, request_length_max):
+    by_duration = []
+    by_stack = []
+    seen = set()
+    pool = []
+
+    def run(request):
+        encoded = encode(request)
+        if (encoded in seen) or (len(encoded) > request_length_max):
+            return
+        seen.add(encoded)
+        measurement = probe.measure(encoded)
+        keep_worst(by_duration, measurement, 'server_duration', count)
+        if measurement['stack_increase'] > 0:
+            keep_worst(by_stack, measurement, 'stack_increase', count)
+        pool.append((measurement['server_duration'], request))
+
+    for request in mutator.seeds():
+        run(request)
+    for _ in range(iterations):
+        if not pool:
+            break
+        pool.sort(key=lambda entry: entry[0], reverse=True)
+        del pool[count * 4:]
+        parent = mutator.rng.choice(pool[:count])[1]
+        run(mutator.mutate(parent))
+    return by_duration, by_stack
+
+
+def replay(probe, corpus, tolerance):
+    regressions = 0
+    for entry in corpus.get('duration', []) + corpus.get('stack', []):
+        measurement = probe.measure(entry['request'])
+        limit = entry['server_duration'] * (1.0 + tolerance)
+        regressed = measurement['server_duration'] > limit
+        regressions += regressed
+        print('{0} {1:8d} us (recorded {2:8d} us) {3}'.format(
+            'REGRESSED' if regressed else 'ok       ',
+            measurement['server_duration'], entry['server_duration'], entry['request'][:60]))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Search for ModularServer requests with the worst case handling time.')
+    connection = parser.add_mutually_exclusive_group(required=True)
+    connection.add_argument('--serial', help='serial port of a device')
+    connection.add_argument('--unix', help='unix socket path of a host build')
+    connection.add_argument('--tcp', help='host:port of a host build')
+    parser.add_argument('--baud', type=int, default=115200, help='serial baud rate')
+    parser.add_argument('--timeout', type=float, default=2.0, help='response timeout in seconds')
+    parser.add_argument('--iterations', type=int, default=1000, help='number of mutated requests to try')
+    parser.add_argument('--count', type=int, default=16, help='number of worst case requests to keep')
+    parser.add_argument('--request-length-max', type=int, default=256, help='longest request to send, MODULAR_SERVER_STRING_LENGTH_REQUEST - 1')
+    parser.add_argument('--seed', type=int, default=0, help='random seed')
+    parser.add_argument('-o', '--output', default='latency_corpus.json', help='corpus file to write')
+    parser.add_argument('--replay', help='corpus file to replay instead of searching')
+    parser.add_argument('--tolerance', type=float, default=0.25, help='allowed slowdown when replaying')
+    args = parser.parse_args()
+
+    try:
+        transport = open_transport(args)
+    except (OSError, TransportError) as error:
+        sys.exit('connection failed: {0}'.format(error))
+    try:
+        probe = Probe(transport)
+        if args.replay:
+            with open(args.replay) as corpus_file:
+                corpus = json.load(corpus_file)
+            regressions = replay(probe, corpus, args.tolerance)
+            sys.exit(1 if regressions else 0)
+        api = probe.call(['getApi', 'DETAILED', ['ALL']])
+        if 'result' not in api:
+            raise TransportError('getApi failed: {0}'.format(api.get('error')))
+        mutator = Mutator(api, random.Random(args.seed))
+        by_duration, by_stack = search(probe, mutator, args.iterations, args.count, args.request_length_max)
+    except TransportError as error:
+        sys.exit('request failed: {0}'.format(error))
+    finally:
+        transport.close()
+
+    corpus = {
+        'firmware': mutator.firmware,
+        'recorded': time.strftime('%Y-%m-%dT%H:%M:%S'),
+        'duration': by_duration,
+        'stack': by_stack,
+    }
+    with open(args.output, 'w') as corpus_file:
+        json.dump(corpus, corpus_file, indent=2)
+        corpus_file.write('\n')
+    if by_duration:
+        worst = by_duration[0]
+        print('worst server duration {0} us: {1}'.format(worst['server_duration'], worst['request'][:80]))
+    print('stack high water {0} bytes'.format(probe.stack_high_water))
+
+
+if __name__ == '__main__':
+    main()
@@ -14,6 +14,10 @@ namespace modular_server
 {
 using FirmwareInfo = constants::FirmwareInfo;
 using HardwareInfo = constants::HardwareInfo;
+using ParameterInfo = constants::ParameterInfo;
+using FunctionInfo = constants::FunctionInfo;
+using PropertyInfo = constants::PropertyInfo;
+using CallbackInfo = constants::CallbackInfo;
 using SubsetMemberType = constants::SubsetMemberType;
 
 class ModularServer
@@ -60,23 +64,34 @@ public:
   Property & createProperty(const ConstantString & property_name,
     const T (&default_value)[N]);
   Property & property(const ConstantString & property_name);
+  template <size_t N>
+  void setupProperties(const PropertyInfo (&property_info_table)[N]);
   template <typename T>
   void setPropertiesToDefaults(T & firmware_name_array);
 
   // Parameters
   Parameter & createParameter(const ConstantString & parameter_name);
+  Parameter & createParameter(const ParameterInfo & parameter_info);
+  template <size_t N>
+  void createParameters(const ParameterInfo (&parameter_info_table)[N]);
   Parameter & parameter(const ConstantString & parameter_name);
   Parameter & copyParameter(Parameter & parameter,
     const ConstantString & parameter_name);
 
   // Functions
   Function & createFunction(const ConstantString & function_name);
+  Function & createFunction(const FunctionInfo & function_info);
+  template <size_t N>
+  void createFunctions(const FunctionInfo (&function_info_table)[N]);
   Function & function(const ConstantString & function_name);
   Function & copyFunction(Function & function,
     const ConstantString & function_name);
 
   // Callbacks
   Callback & createCallback(const ConstantString & callback_name);
+  Callback & createCallback(const CallbackInfo & callback_info);
+  template <size_t N>
+  void createCallbacks(const CallbackInfo (&callback_info_table)[N]);
   Callback & callback(const ConstantString & callback_name);
 
   // Response
@@ -87,6 +102,11 @@ public:
   void stopServer();
   void handleServerRequests();
 
+  // Timing Monitor
+  void enableTimingMonitor(unsigned long loop_period_deadline);
+  void disableTimingMonitor();
+  void resetTimingMonitor();
+
 private:
   Server server_;
 };
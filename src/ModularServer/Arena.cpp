@@ -0,0 +1,184 @@
+// ----------------------------------------------------------------------------
+// Arena.cpp
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#include "Arena.h"
+
+
+namespace modular_server
+{
+
+// public
+Arena::Arena()
+{
+  storage_ = NULL;
+  size_ = 0;
+  used_ = 0;
+  high_water_ = 0;
+  tail_size_ = 0;
+}
+
+void Arena::setStorage(char * storage,
+  size_t size)
+{
+  storage_ = storage;
+  size_ = size;
+  used_ = 0;
+  high_water_ = 0;
+  tail_size_ = 0;
+}
+
+void * Arena::allocate(size_t size)
+{
+  uintptr_t address = (uintptr_t)(storage_ + used_);
+  size_t padding = (constants::ARENA_ALIGNMENT - (address % constants::ARENA_ALIGNMENT)) % constants::ARENA_ALIGNMENT;
+  if ((storage_ == NULL) || !makeRoom(padding + size))
+  {
+    return NULL;
+  }
+  void * pointer = storage_ + used_ + padding;
+  used_ += padding + size;
+  updateHighWater();
+  return pointer;
+}
+
+char * Arena::allocateString(size_t length)
+{
+  if ((storage_ == NULL) || !makeRoom(length + 1))
+  {
+    return NULL;
+  }
+  char * str = storage_ + used_;
+  used_ += length + 1;
+  updateHighWater();
+  str[0] = '\0';
+  return str;
+}
+
+char * Arena::allocateString(const ConstantString & constant_string)
+{
+  char * str = allocateString(constant_string.length());
+  if (str)
+  {
+    constant_string.copy(str);
+  }
+  return str;
+}
+
+size_t Arena::getMark()
+{
+  return used_;
+}
+
+void Arena::rewind(size_t mark)
+{
+  if (mark < used_)
+  {
+    used_ = mark;
+  }
+}
+
+// the tail is kept until it is released, so a response collected there may
+// still be written after the allocations it was built from are reset
+void Arena::reset()
+{
+  used_ = 0;
+}
+
+// the tail contents stay at the start of the returned buffer as it grows
+char * Arena::growTail(size_t size)
+{
+  if ((storage_ == NULL) || ((used_ + size) > size_))
+  {
+    return NULL;
+  }
+  if (size > tail_size_)
+  {
+    memmove(storage_ + size_ - size,storage_ + size_ - tail_size_,tail_size_);
+    tail_size_ = size;
+    updateHighWater();
+  }
+  return storage_ + size_ - tail_size_;
+}
+
+void Arena::releaseTail()
+{
+  tail_size_ = 0;
+}
+
+void Arena::attachTailReleaseFunctor(const Functor0 & functor)
+{
+  tail_release_functor_ = functor;
+}
+
+size_t Arena::getSize()
+{
+  return size_;
+}
+
+size_t Arena::getUsed()
+{
+  return used_;
+}
+
+size_t Arena::getHighWater()
+{
+  return high_water_;
+}
+
+// private
+bool Arena::makeRoom(size_t size)
+{
+  if ((used_ + size) <= (size_ - tail_size_))
+  {
+    return true;
+  }
+  if (tail_size_ > 0)
+  {
+    if (tail_release_functor_)
+    {
+      tail_release_functor_();
+    }
+    releaseTail();
+  }
+  return ((used_ + size) <= size_);
+}
+
+void Arena::updateHighWater()
+{
+  if ((used_ + tail_size_) > high_water_)
+  {
+    high_water_ = used_ + tail_size_;
+  }
+}
+
+ArenaAllocator::ArenaAllocator(Arena * arena_ptr) :
+  arena_ptr_(arena_ptr)
+{
+}
+
+void * ArenaAllocator::allocate(size_t size)
+{
+  if (!arena_ptr_)
+  {
+    return NULL;
+  }
+  return arena_ptr_->allocate(size);
+}
+
+void ArenaAllocator::deallocate(void * pointer)
+{
+  // arena memory is released all at once when the arena is reset
+}
+
+void * ArenaAllocator::reallocate(void * pointer,
+  size_t new_size)
+{
+  // arena allocations cannot be resized in place
+  return NULL;
+}
+
+}
@@ -0,0 +1,76 @@
+// ----------------------------------------------------------------------------
+// Arena.h
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_ARENA_H_
+#define _MODULAR_SERVER_ARENA_H_
+#include <Arduino.h>
+#include <ConstantVariable.h>
+#include <ArduinoJson.h>
+#include <Functor.h>
+
+#include "Constants.h"
+
+
+namespace modular_server
+{
+// Preallocated memory that request processing draws from instead of the
+// stack, released all at once by reset or back to a mark by rewind. A tail at
+// the end of the storage may hold one growing buffer, which is given up
+// through the tail release functor before any allocation fails.
+class Arena
+{
+public:
+  Arena();
+  template <size_t SIZE>
+  void setStorage(char (&storage)[SIZE]);
+  void setStorage(char * storage,
+    size_t size);
+
+  void * allocate(size_t size);
+  char * allocateString(size_t length);
+  char * allocateString(const ConstantString & constant_string);
+  size_t getMark();
+  void rewind(size_t mark);
+  void reset();
+
+  char * growTail(size_t size);
+  void releaseTail();
+  void attachTailReleaseFunctor(const Functor0 & functor);
+
+  size_t getSize();
+  size_t getUsed();
+  size_t getHighWater();
+
+private:
+  char * storage_;
+  size_t size_;
+  size_t used_;
+  size_t high_water_;
+  size_t tail_size_;
+  Functor0 tail_release_functor_;
+  bool makeRoom(size_t size);
+  void updateHighWater();
+};
+
+// Lets ArduinoJson documents allocate their memory pool from an Arena
+struct ArenaAllocator
+{
+  ArenaAllocator(Arena * arena_ptr=NULL);
+
+  void * allocate(size_t size);
+  void deallocate(void * pointer);
+  void * reallocate(void * pointer,
+    size_t new_size);
+
+  Arena * arena_ptr_;
+};
+
+typedef ArduinoJson::BasicJsonDocument<ArenaAllocator> ArenaJsonDocument;
+}
+#include "ArenaDefinitions.h"
+
+#endif
@@ -0,0 +1,22 @@
+// ----------------------------------------------------------------------------
+// ArenaDefinitions.h
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_ARENA_DEFINITIONS_H_
+#define _MODULAR_SERVER_ARENA_DEFINITIONS_H_
+
+
+namespace modular_server
+{
+// public
+template <size_t SIZE>
+void Arena::setStorage(char (&storage)[SIZE])
+{
+  setStorage(storage,SIZE);
+}
+
+}
+#endif
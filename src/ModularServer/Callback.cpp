@@ -6,6 +6,7 @@
 // Peter Polidoro peterpolidoro@gmail.com
 // ----------------------------------------------------------------------------
 #include "Callback.h"
+#include "PinIndex.h"
 
 
 namespace modular_server
@@ -28,41 +29,35 @@ CONSTANT_STRING(attach_to_function_name,"attachTo");
 CONSTANT_STRING(detach_from_function_name,"detachFrom");
 }
 
-Array<Parameter,callback::PARAMETER_COUNT_MAX> Callback::parameters_;
-Array<Function,callback::FUNCTION_COUNT_MAX> Callback::functions_;
-Array<constants::SubsetMemberType,constants::PIN_COUNT_MAX+1> * Callback::pin_name_array_ptr_;
-Functor1wRet<const char *,Pin *> Callback::find_pin_ptr_by_chars_functor_;
-Functor1wRet<const ConstantString &,Pin *> Callback::find_pin_ptr_by_constant_string_functor_;
-Functor1wRet<const ConstantString &,ArduinoJson::JsonVariant> Callback::get_parameter_value_functor_;
-
 Parameter & Callback::createParameter(const ConstantString & parameter_name)
 {
   int parameter_index = findParameterIndex(parameter_name);
   if (parameter_index < 0)
   {
-    parameters_.push_back(Parameter(parameter_name));
-    parameters_.back().setFirmwareName(constants::firmware_name);
-    return parameters_.back();
+    tables().parameters.push_back(Parameter(parameter_name));
+    tables().parameters.back().setFirmwareName(constants::firmware_name);
+    tables().parameters.back().setContext(*context_ptr_);
+    return tables().parameters.back();
   }
-  return parameters_[0]; // bad reference
+  return tables().parameters[0]; // bad reference
 }
 
 Parameter & Callback::parameter(const ConstantString & parameter_name)
 {
   int parameter_index = findParameterIndex(parameter_name);
-  if ((parameter_index >= 0) && (parameter_index < (int)parameters_.size()))
+  if ((parameter_index >= 0) && (parameter_index < (int)tables().parameters.size()))
   {
-    return parameters_[parameter_index];
+    return tables().parameters[parameter_index];
   }
-  return parameters_[0]; // bad reference
+  return tables().parameters[0]; // bad reference
 }
 
 Parameter & Callback::copyParameter(Parameter parameter,
   const ConstantString & parameter_name)
 {
-  parameters_.push_back(parameter);
-  parameters_.back().setName(parameter_name);
-  return parameters_.back();
+  tables().parameters.push_back(parameter);
+  tables().parameters.back().setName(parameter_name);
+  return tables().parameters.back();
 }
 
 Function & Callback::createFunction(const ConstantString & function_name)
@@ -70,21 +65,22 @@ Function & Callback::createFunction(const ConstantString & function_name)
   int function_index = findFunctionIndex(function_name);
   if (function_index < 0)
   {
-    functions_.push_back(Function(function_name));
-    functions_.back().setFirmwareName(constants::firmware_name);
-    return functions_.back();
+    tables().functions.push_back(Function(function_name));
+    tables().functions.back().setFirmwareName(constants::firmware_name);
+    tables().functions.back().setContext(*context_ptr_);
+    return tables().functions.back();
   }
-  return functions_[0]; // bad reference
+  return tables().functions[0]; // bad reference
 }
 
 Function & Callback::function(const ConstantString & function_name)
 {
   int function_index = findFunctionIndex(function_name);
-  if ((function_index >= 0) && (function_index < (int)functions_.size()))
+  if ((function_index >= 0) && (function_index < (int)tables().functions.size()))
   {
-    return functions_[function_index];
+    return tables().functions[function_index];
   }
-  return functions_[0]; // bad reference
+  return tables().functions[0]; // bad reference
 }
 
 // public
@@ -149,7 +145,7 @@ void Callback::attachTo(const ConstantString & pin_name,
     attachToAll(pin_mode);
     return;
   }
-  Pin * pin_ptr = find_pin_ptr_by_constant_string_functor_(pin_name);
+  Pin * pin_ptr = context_ptr_->pin_index_ptr->findPinPtr(pin_name);
   if (!pin_ptr)
   {
     return;
@@ -160,24 +156,8 @@ void Callback::attachTo(const ConstantString & pin_name,
 void Callback::attachTo(const char * pin_name,
   const char * pin_mode)
 {
-  const ConstantString * pin_mode_ptr = NULL;
-  if (pin_mode == constants::pin_mode_interrupt_low)
-  {
-    pin_mode_ptr = &constants::pin_mode_interrupt_low;
-  }
-  else if (pin_mode == constants::pin_mode_interrupt_change)
-  {
-    pin_mode_ptr = &constants::pin_mode_interrupt_change;
-  }
-  else if (pin_mode == constants::pin_mode_interrupt_rising)
-  {
-    pin_mode_ptr = &constants::pin_mode_interrupt_rising;
-  }
-  else if (pin_mode == constants::pin_mode_interrupt_falling)
-  {
-    pin_mode_ptr = &constants::pin_mode_interrupt_falling;
-  }
-  else
+  const ConstantString * pin_mode_ptr = findPinModePtr(pin_mode);
+  if (!pin_mode_ptr)
   {
     return;
   }
@@ -186,7 +166,7 @@ void Callback::attachTo(const char * pin_name,
     attachToAll(*pin_mode_ptr);
     return;
   }
-  Pin * pin_ptr = find_pin_ptr_by_chars_functor_(pin_name);
+  Pin * pin_ptr = context_ptr_->pin_index_ptr->findPinPtr(pin_name);
   if (!pin_ptr)
   {
     return;
@@ -196,25 +176,19 @@ void Callback::attachTo(const char * pin_name,
 
 void Callback::attachToAll(const ConstantString & pin_mode)
 {
-  for (size_t i=0; i<pin_name_array_ptr_->size(); ++i)
+  PinIndex & pin_index = *(context_ptr_->pin_index_ptr);
+  for (size_t i=0; i<pin_index.size(); ++i)
   {
-    const ConstantString * name_ptr = pin_name_array_ptr_->at(i).cs_ptr;
-    if (name_ptr != &constants::all_constant_string)
-    {
-      attachTo(*name_ptr,pin_mode);
-    }
+    attachTo(pin_index[i],pin_mode);
   }
 }
 
 void Callback::attachToAll(const char * pin_mode)
 {
-  for (size_t i=0; i<pin_name_array_ptr_->size(); ++i)
+  const ConstantString * pin_mode_ptr = findPinModePtr(pin_mode);
+  if (pin_mode_ptr)
   {
-    const ConstantString * name_ptr = pin_name_array_ptr_->at(i).cs_ptr;
-    if (name_ptr != &constants::all_constant_string)
-    {
-      attachTo(*name_ptr,pin_mode);
-    }
+    attachToAll(*pin_mode_ptr);
   }
 }
 
@@ -332,18 +306,18 @@ void Callback::writeApi(Response & response,
 
   response.writeKey(constants::functions_constant_string);
   response.beginArray();
-  for (size_t i=0; i<Callback::functions_.size(); ++i)
+  for (size_t i=0; i<tables().functions.size(); ++i)
   {
-    Function & function = Callback::functions_[i];
+    Function & function = tables().functions[i];
     function.writeApi(response,!write_function_parameter_pin_details,false,false);
   }
   response.endArray();
 
   response.writeKey(constants::parameters_constant_string);
   response.beginArray();
-  for (size_t i=0; i<Callback::parameters_.size(); ++i)
+  for (size_t i=0; i<tables().parameters.size(); ++i)
   {
-    Parameter & parameter = Callback::parameters_[i];
+    Parameter & parameter = tables().parameters[i];
     parameter.writeApi(response,!write_function_parameter_pin_details,false,false,write_instance_details);
   }
   response.endArray();
@@ -378,6 +352,11 @@ int Callback::findPropertyIndex(const ConstantString & property_name)
   return property_index;
 }
 
+CallbackTables & Callback::tables()
+{
+  return *(context_ptr_->callback_tables_ptr);
+}
+
 size_t Callback::getPropertyCount()
 {
   return property_ptrs_.size();
@@ -402,36 +381,44 @@ int Callback::findPinPtrIndex(Pin & pin)
 
 int Callback::findPinPtrIndex(const ConstantString & pin_name)
 {
-  int pin_ptr_index = -1;
-  for (size_t i=0; i<pin_ptrs_.max_size(); ++i)
+  Pin * pin_ptr = context_ptr_->pin_index_ptr->findPinPtr(pin_name);
+  if ((pin_ptr == NULL) || (pin_ptr->getCallbackPtr() != this))
   {
-    if (pin_ptrs_.indexHasValue(i))
-    {
-      if (pin_ptrs_[i]->compareName(pin_name))
-      {
-        pin_ptr_index = i;
-        break;
-      }
-    }
+    return -1;
   }
-  return pin_ptr_index;
+  return findPinPtrIndex(*pin_ptr);
 }
 
 int Callback::findPinPtrIndex(const char * pin_name)
 {
-  int pin_ptr_index = -1;
-  for (size_t i=0; i<pin_ptrs_.max_size(); ++i)
+  Pin * pin_ptr = context_ptr_->pin_index_ptr->findPinPtr(pin_name);
+  if ((pin_ptr == NULL) || (pin_ptr->getCallbackPtr() != this))
   {
-    if (pin_ptrs_.indexHasValue(i))
-    {
-      if (pin_ptrs_[i]->compareName(pin_name))
-      {
-        pin_ptr_index = i;
-        break;
-      }
-    }
+    return -1;
   }
-  return pin_ptr_index;
+  return findPinPtrIndex(*pin_ptr);
+}
+
+const ConstantString * Callback::findPinModePtr(const char * pin_mode)
+{
+  const ConstantString * pin_mode_ptr = NULL;
+  if (pin_mode == constants::pin_mode_interrupt_low)
+  {
+    pin_mode_ptr = &constants::pin_mode_interrupt_low;
+  }
+  else if (pin_mode == constants::pin_mode_interrupt_change)
+  {
+    pin_mode_ptr = &constants::pin_mode_interrupt_change;
+  }
+  else if (pin_mode == constants::pin_mode_interrupt_rising)
+  {
+    pin_mode_ptr = &constants::pin_mode_interrupt_rising;
+  }
+  else if (pin_mode == constants::pin_mode_interrupt_falling)
+  {
+    pin_mode_ptr = &constants::pin_mode_interrupt_falling;
+  }
+  return pin_mode_ptr;
 }
 
 void Callback::functor(Pin * pin_ptr)
@@ -445,20 +432,20 @@ void Callback::functor(Pin * pin_ptr)
 void Callback::updateFunctionsAndParameters()
 {
   // Parameters
-  parameters_.clear();
+  tables().parameters.clear();
 
   Parameter & pin_name_parameter = createParameter(constants::pin_name_parameter_name);
   pin_name_parameter.setTypeString();
-  pin_name_parameter.setSubset(pin_name_array_ptr_->data(),
-    pin_name_array_ptr_->max_size(),
-    pin_name_array_ptr_->size());
+  pin_name_parameter.setSubset(context_ptr_->pin_name_array_ptr->data(),
+    context_ptr_->pin_name_array_ptr->max_size(),
+    context_ptr_->pin_name_array_ptr->size());
 
   Parameter & pin_mode_parameter = createParameter(constants::pin_mode_constant_string);
   pin_mode_parameter.setTypeString();
   pin_mode_parameter.setSubset(callback::pin_mode_ptr_subset);
 
   // Functions
-  functions_.clear();
+  tables().functions.clear();
 
   Function & trigger_function = createFunction(callback::trigger_function_name);
   trigger_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Callback::triggerHandler));
@@ -480,14 +467,14 @@ void Callback::triggerHandler()
 
 void Callback::attachToHandler()
 {
-  const char * pin_name = get_parameter_value_functor_(constants::pin_name_parameter_name);
-  const char * pin_mode = get_parameter_value_functor_(constants::pin_mode_constant_string);
+  const char * pin_name = context_ptr_->get_parameter_value_functor(constants::pin_name_parameter_name);
+  const char * pin_mode = context_ptr_->get_parameter_value_functor(constants::pin_mode_constant_string);
   attachTo(pin_name,pin_mode);
 }
 
 void Callback::detachFromHandler()
 {
-  const char * pin_str = get_parameter_value_functor_(constants::pin_name_parameter_name);
+  const char * pin_str = context_ptr_->get_parameter_value_functor(constants::pin_name_parameter_name);
   detachFrom(pin_str);
 }
 
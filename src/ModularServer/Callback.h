@@ -39,6 +39,14 @@ extern ConstantString attach_to_function_name;
 extern ConstantString detach_from_function_name;
 }
 
+// Callback functions and parameters are rebuilt in these tables for each
+// request, one set per server
+struct CallbackTables
+{
+  Array<Parameter,callback::PARAMETER_COUNT_MAX> parameters;
+  Array<Function,callback::FUNCTION_COUNT_MAX> functions;
+};
+
 class Pin;
 
 class Callback : private FirmwareElement
@@ -70,21 +78,15 @@ public:
     bool write_instance_details);
 
 private:
-  static Array<Parameter,callback::PARAMETER_COUNT_MAX> parameters_;
-  static Array<Function,callback::FUNCTION_COUNT_MAX> functions_;
-  static Array<constants::SubsetMemberType,constants::PIN_COUNT_MAX+1> * pin_name_array_ptr_;
-  static Functor1wRet<const char *,Pin *> find_pin_ptr_by_chars_functor_;
-  static Functor1wRet<const ConstantString &,Pin *> find_pin_ptr_by_constant_string_functor_;
-  static Functor1wRet<const char *,Pin *> find_pin_ptr_functor_;
-  static Functor1wRet<const ConstantString &,ArduinoJson::JsonVariant> get_parameter_value_functor_;
+  CallbackTables & tables();
 
   template <typename T>
-  static int findParameterIndex(T const & parameter_name)
+  int findParameterIndex(T const & parameter_name)
   {
     int parameter_index = -1;
-    for (size_t i=0; i<parameters_.size(); ++i)
+    for (size_t i=0; i<tables().parameters.size(); ++i)
     {
-      if (parameters_[i].compareName(parameter_name))
+      if (tables().parameters[i].compareName(parameter_name))
       {
         parameter_index = i;
         break;
@@ -92,18 +94,18 @@ private:
     }
     return parameter_index;
   };
-  static Parameter & createParameter(const ConstantString & parameter_name);
-  static Parameter & parameter(const ConstantString & parameter_name);
-  static Parameter & copyParameter(Parameter parameter,
+  Parameter & createParameter(const ConstantString & parameter_name);
+  Parameter & parameter(const ConstantString & parameter_name);
+  Parameter & copyParameter(Parameter parameter,
     const ConstantString & parameter_name);
 
   template <typename T>
-  static int findFunctionIndex(T const & function_name)
+  int findFunctionIndex(T const & function_name)
   {
     int function_index = -1;
-    for (size_t i=0; i<functions_.size(); ++i)
+    for (size_t i=0; i<tables().functions.size(); ++i)
     {
-      if (functions_[i].compareName(function_name))
+      if (tables().functions[i].compareName(function_name))
       {
         function_index = i;
         break;
@@ -111,8 +113,8 @@ private:
     }
     return function_index;
   };
-  static Function & createFunction(const ConstantString & function_name);
-  static Function & function(const ConstantString & function_name);
+  Function & createFunction(const ConstantString & function_name);
+  Function & function(const ConstantString & function_name);
 
   Functor1<Pin *> functor_;
   Array<Property *,constants::CALLBACK_PROPERTY_COUNT_MAX> property_ptrs_;
@@ -125,6 +127,7 @@ private:
   int findPinPtrIndex(Pin & pin);
   int findPinPtrIndex(const ConstantString & pin_name);
   int findPinPtrIndex(const char * pin_name);
+  const ConstantString * findPinModePtr(const char * pin_mode);
   void functor(Pin * pin_ptr);
   void updateFunctionsAndParameters();
 
@@ -135,6 +138,7 @@ private:
 
   friend class Server;
   friend class Pin;
+  friend class RuleEngine;
 };
 }
 #endif
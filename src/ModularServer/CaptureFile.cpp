@@ -0,0 +1,57 @@
+// ----------------------------------------------------------------------------
+// CaptureFile.cpp
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#include "CaptureFile.h"
+#if defined(EPOXY_DUINO)
+
+
+namespace modular_server
+{
+// public
+CaptureFile::CaptureFile()
+{
+  file_ptr_ = NULL;
+}
+
+CaptureFile::~CaptureFile()
+{
+  close();
+}
+
+bool CaptureFile::open(const char * path)
+{
+  close();
+  file_ptr_ = fopen(path,"wb");
+  return (file_ptr_ != NULL);
+}
+
+void CaptureFile::close()
+{
+  if (file_ptr_)
+  {
+    fclose(file_ptr_);
+    file_ptr_ = NULL;
+  }
+}
+
+void CaptureFile::writeRecord(uint8_t direction,
+  unsigned long time,
+  const uint8_t * data,
+  size_t length)
+{
+  if (!file_ptr_)
+  {
+    return;
+  }
+  uint8_t header[constants::CAPTURE_RECORD_HEADER_SIZE];
+  encodeHeader(header,direction,time,length);
+  fwrite(header,1,constants::CAPTURE_RECORD_HEADER_SIZE,file_ptr_);
+  fwrite(data,1,length,file_ptr_);
+}
+
+}
+#endif
@@ -0,0 +1,41 @@
+// ----------------------------------------------------------------------------
+// CaptureFile.h
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_CAPTURE_FILE_H_
+#define _MODULAR_SERVER_CAPTURE_FILE_H_
+#if defined(EPOXY_DUINO)
+#include <Arduino.h>
+#include <stdio.h>
+
+#include "CaptureStream.h"
+#include "Constants.h"
+
+
+namespace modular_server
+{
+// Appends capture records to a file on host builds
+class CaptureFile : public CaptureSink
+{
+public:
+  CaptureFile();
+  ~CaptureFile();
+
+  bool open(const char * path);
+  void close();
+
+  virtual void writeRecord(uint8_t direction,
+    unsigned long time,
+    const uint8_t * data,
+    size_t length);
+
+private:
+  FILE * file_ptr_;
+};
+}
+
+#endif
+#endif
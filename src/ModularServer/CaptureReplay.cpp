@@ -0,0 +1,270 @@
+// ----------------------------------------------------------------------------
+// CaptureReplay.cpp
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#include "CaptureReplay.h"
+#if defined(EPOXY_DUINO)
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../ModularServer.h"
+
+
+namespace modular_server
+{
+// public
+ReplayStream::ReplayStream()
+{
+  input_ptr_ = NULL;
+  input_length_ = 0;
+  input_position_ = 0;
+  output_ptr_ = NULL;
+  output_length_ = 0;
+  output_size_ = 0;
+}
+
+ReplayStream::~ReplayStream()
+{
+  free(output_ptr_);
+}
+
+void ReplayStream::setInput(const uint8_t * input,
+  size_t length)
+{
+  input_ptr_ = input;
+  input_length_ = length;
+  input_position_ = 0;
+}
+
+void ReplayStream::clearOutput()
+{
+  output_length_ = 0;
+}
+
+const uint8_t * ReplayStream::getOutput()
+{
+  return output_ptr_;
+}
+
+size_t ReplayStream::getOutputLength()
+{
+  return output_length_;
+}
+
+int ReplayStream::available()
+{
+  return input_length_ - input_position_;
+}
+
+int ReplayStream::read()
+{
+  if (input_position_ == input_length_)
+  {
+    return -1;
+  }
+  return input_ptr_[input_position_++];
+}
+
+int ReplayStream::peek()
+{
+  if (input_position_ == input_length_)
+  {
+    return -1;
+  }
+  return input_ptr_[input_position_];
+}
+
+size_t ReplayStream::write(uint8_t byte)
+{
+  if (output_length_ == output_size_)
+  {
+    size_t output_size = (output_size_ > 0) ? (2 * output_size_) : 256;
+    uint8_t * output_ptr = (uint8_t *)realloc(output_ptr_,output_size);
+    if (output_ptr == NULL)
+    {
+      return 0;
+    }
+    output_ptr_ = output_ptr;
+    output_size_ = output_size;
+  }
+  output_ptr_[output_length_++] = byte;
+  return 1;
+}
+
+CaptureReplay::CaptureReplay()
+{
+  modular_server_ptr_ = NULL;
+  capture_ptr_ = NULL;
+  capture_length_ = 0;
+  request_count_ = 0;
+  mismatch_count_ = 0;
+}
+
+CaptureReplay::~CaptureReplay()
+{
+  free(capture_ptr_);
+}
+
+void CaptureReplay::attach(ModularServer & modular_server)
+{
+  modular_server_ptr_ = &modular_server;
+  modular_server.addServerStream(replay_stream_);
+}
+
+bool CaptureReplay::load(const char * path)
+{
+  free(capture_ptr_);
+  capture_ptr_ = NULL;
+  capture_length_ = 0;
+  FILE * file_ptr = fopen(path,"rb");
+  if (file_ptr == NULL)
+  {
+    return false;
+  }
+  fseek(file_ptr,0,SEEK_END);
+  long file_length = ftell(file_ptr);
+  fseek(file_ptr,0,SEEK_SET);
+  if (file_length > 0)
+  {
+    capture_ptr_ = (uint8_t *)malloc(file_length);
+  }
+  if (capture_ptr_)
+  {
+    capture_length_ = fread(capture_ptr_,1,file_length,file_ptr);
+  }
+  fclose(file_ptr);
+  return (capture_length_ > 0);
+}
+
+bool CaptureReplay::run(Print & report)
+{
+  request_count_ = 0;
+  mismatch_count_ = 0;
+  if ((modular_server_ptr_ == NULL) || (capture_ptr_ == NULL))
+  {
+    return false;
+  }
+  uint8_t * request_ptr = NULL;
+  size_t request_length = 0;
+  size_t request_size = 0;
+  uint8_t * response_ptr = NULL;
+  size_t response_length = 0;
+  size_t response_size = 0;
+  unsigned long duration_total = 0;
+  unsigned long duration_max = 0;
+
+  size_t position = 0;
+  while (position < capture_length_)
+  {
+    // a request is every request record up to the next response record and
+    // its response every response record up to the next request record
+    request_length = 0;
+    response_length = 0;
+    position = collect(position,constants::CAPTURE_REQUEST,request_ptr,request_length,request_size);
+    position = collect(position,constants::CAPTURE_RESPONSE,response_ptr,response_length,response_size);
+    if (request_length == 0)
+    {
+      continue;
+    }
+
+    replay_stream_.setInput(request_ptr,request_length);
+    replay_stream_.clearOutput();
+    // every call reading the replay stream consumes at least one byte
+    size_t call_count_max = constants::SERVER_STREAM_COUNT_MAX + request_length;
+    unsigned long time = micros();
+    for (size_t i=0; (i<call_count_max) && (replay_stream_.available() > 0); ++i)
+    {
+      modular_server_ptr_->handleServerRequests();
+    }
+    unsigned long duration = micros() - time;
+
+    bool match = ((replay_stream_.getOutputLength() == response_length) &&
+      (memcmp(replay_stream_.getOutput(),response_ptr,response_length) == 0));
+    if (!match)
+    {
+      ++mismatch_count_;
+    }
+    ++request_count_;
+    duration_total += duration;
+    if (duration > duration_max)
+    {
+      duration_max = duration;
+    }
+
+    report.print(request_count_);
+    report.print(F(" "));
+    report.print(duration);
+    report.print(F(" us "));
+    report.println(match ? F("match") : F("mismatch"));
+  }
+  free(request_ptr);
+  free(response_ptr);
+
+  report.print(F("requests "));
+  report.print(request_count_);
+  report.print(F(" mismatches "));
+  report.print(mismatch_count_);
+  report.print(F(" mean "));
+  report.print((request_count_ > 0) ? (duration_total / request_count_) : 0);
+  report.print(F(" us max "));
+  report.print(duration_max);
+  report.println(F(" us"));
+  return (mismatch_count_ == 0);
+}
+
+size_t CaptureReplay::getRequestCount()
+{
+  return request_count_;
+}
+
+size_t CaptureReplay::getMismatchCount()
+{
+  return mismatch_count_;
+}
+
+// private
+size_t CaptureReplay::collect(size_t position,
+  uint8_t direction,
+  uint8_t * & buffer_ptr,
+  size_t & buffer_length,
+  size_t & buffer_size)
+{
+  while ((position + constants::CAPTURE_RECORD_HEADER_SIZE) <= capture_length_)
+  {
+    uint8_t record_direction;
+    unsigned long record_time;
+    size_t record_length;
+    CaptureSink::decodeHeader(capture_ptr_ + position,record_direction,record_time,record_length);
+    if (record_direction != direction)
+    {
+      return position;
+    }
+    size_t data_position = position + constants::CAPTURE_RECORD_HEADER_SIZE;
+    if ((data_position + record_length) > capture_length_)
+    {
+      // truncated record at the end of the capture
+      return capture_length_;
+    }
+    if ((buffer_length + record_length) > buffer_size)
+    {
+      size_t size = 2 * (buffer_length + record_length);
+      uint8_t * ptr = (uint8_t *)realloc(buffer_ptr,size);
+      if (ptr == NULL)
+      {
+        return capture_length_;
+      }
+      buffer_ptr = ptr;
+      buffer_size = size;
+    }
+    memcpy(buffer_ptr + buffer_length,capture_ptr_ + data_position,record_length);
+    buffer_length += record_length;
+    position = data_position + record_length;
+  }
+  return capture_length_;
+}
+
+}
+#endif
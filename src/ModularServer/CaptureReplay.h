@@ -0,0 +1,79 @@
+// ----------------------------------------------------------------------------
+// CaptureReplay.h
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_CAPTURE_REPLAY_H_
+#define _MODULAR_SERVER_CAPTURE_REPLAY_H_
+#if defined(EPOXY_DUINO)
+#include <Arduino.h>
+
+#include "CaptureStream.h"
+#include "Constants.h"
+
+
+namespace modular_server
+{
+class ModularServer;
+
+// Server stream fed from memory that collects everything written to it
+class ReplayStream : public Stream
+{
+public:
+  ReplayStream();
+  ~ReplayStream();
+
+  void setInput(const uint8_t * input,
+    size_t length);
+  void clearOutput();
+  const uint8_t * getOutput();
+  size_t getOutputLength();
+
+  virtual int available();
+  virtual int read();
+  virtual int peek();
+  virtual size_t write(uint8_t byte);
+  using Print::write;
+
+private:
+  const uint8_t * input_ptr_;
+  size_t input_length_;
+  size_t input_position_;
+  uint8_t * output_ptr_;
+  size_t output_length_;
+  size_t output_size_;
+};
+
+// Feeds the requests of a capture file back through a server on host builds,
+// checks the responses match the captured ones and reports request timing
+class CaptureReplay
+{
+public:
+  CaptureReplay();
+  ~CaptureReplay();
+
+  void attach(ModularServer & modular_server);
+  bool load(const char * path);
+  bool run(Print & report);
+  size_t getRequestCount();
+  size_t getMismatchCount();
+
+private:
+  ModularServer * modular_server_ptr_;
+  ReplayStream replay_stream_;
+  uint8_t * capture_ptr_;
+  size_t capture_length_;
+  size_t request_count_;
+  size_t mismatch_count_;
+  size_t collect(size_t position,
+    uint8_t direction,
+    uint8_t * & buffer_ptr,
+    size_t & buffer_length,
+    size_t & buffer_size);
+};
+}
+
+#endif
+#endif
@@ -0,0 +1,112 @@
+// ----------------------------------------------------------------------------
+// CaptureRing.cpp
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#include "CaptureRing.h"
+
+
+namespace modular_server
+{
+// public
+CaptureRing::CaptureRing()
+{
+  storage_ = NULL;
+  size_ = 0;
+  clear();
+}
+
+void CaptureRing::setStorage(uint8_t * storage,
+  size_t size)
+{
+  storage_ = storage;
+  size_ = size;
+  clear();
+}
+
+void CaptureRing::writeRecord(uint8_t direction,
+  unsigned long time,
+  const uint8_t * data,
+  size_t length)
+{
+  size_t record_size = constants::CAPTURE_RECORD_HEADER_SIZE + length;
+  if ((storage_ == NULL) || (record_size > size_))
+  {
+    return;
+  }
+  while ((size_ - used_) < record_size)
+  {
+    dropOldestRecord();
+  }
+  uint8_t header[constants::CAPTURE_RECORD_HEADER_SIZE];
+  encodeHeader(header,direction,time,length);
+  push(header,constants::CAPTURE_RECORD_HEADER_SIZE);
+  push(data,length);
+  ++record_count_;
+}
+
+size_t CaptureRing::getRecordCount()
+{
+  return record_count_;
+}
+
+size_t CaptureRing::getUsed()
+{
+  return used_;
+}
+
+void CaptureRing::clear()
+{
+  head_ = 0;
+  tail_ = 0;
+  used_ = 0;
+  record_count_ = 0;
+}
+
+size_t CaptureRing::writeTo(Print & print)
+{
+  // records are stored in capture file format so they may be written out as is
+  for (size_t i=0; i<used_; ++i)
+  {
+    print.write(at(i));
+  }
+  return used_;
+}
+
+// private
+void CaptureRing::push(const uint8_t * data,
+  size_t length)
+{
+  for (size_t i=0; i<length; ++i)
+  {
+    storage_[head_] = data[i];
+    head_ = (head_ + 1) % size_;
+  }
+  used_ += length;
+}
+
+uint8_t CaptureRing::at(size_t offset)
+{
+  return storage_[(tail_ + offset) % size_];
+}
+
+void CaptureRing::dropOldestRecord()
+{
+  uint8_t header[constants::CAPTURE_RECORD_HEADER_SIZE];
+  for (size_t i=0; i<constants::CAPTURE_RECORD_HEADER_SIZE; ++i)
+  {
+    header[i] = at(i);
+  }
+  uint8_t direction;
+  unsigned long time;
+  size_t length;
+  decodeHeader(header,direction,time,length);
+  size_t record_size = constants::CAPTURE_RECORD_HEADER_SIZE + length;
+  tail_ = (tail_ + record_size) % size_;
+  used_ -= record_size;
+  --record_count_;
+}
+
+}
@@ -0,0 +1,53 @@
+// ----------------------------------------------------------------------------
+// CaptureRing.h
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_CAPTURE_RING_H_
+#define _MODULAR_SERVER_CAPTURE_RING_H_
+#include <Arduino.h>
+
+#include "CaptureStream.h"
+#include "Constants.h"
+
+
+namespace modular_server
+{
+// Keeps the most recent capture records in preallocated memory, dropping the
+// oldest records when full
+class CaptureRing : public CaptureSink
+{
+public:
+  CaptureRing();
+  template <size_t SIZE>
+  void setStorage(uint8_t (&storage)[SIZE]);
+  void setStorage(uint8_t * storage,
+    size_t size);
+
+  virtual void writeRecord(uint8_t direction,
+    unsigned long time,
+    const uint8_t * data,
+    size_t length);
+  size_t getRecordCount();
+  size_t getUsed();
+  void clear();
+  size_t writeTo(Print & print);
+
+private:
+  uint8_t * storage_;
+  size_t size_;
+  size_t head_;
+  size_t tail_;
+  size_t used_;
+  size_t record_count_;
+  void push(const uint8_t * data,
+    size_t length);
+  uint8_t at(size_t offset);
+  void dropOldestRecord();
+};
+}
+#include "CaptureRingDefinitions.h"
+
+#endif
@@ -0,0 +1,22 @@
+// ----------------------------------------------------------------------------
+// CaptureRingDefinitions.h
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_CAPTURE_RING_DEFINITIONS_H_
+#define _MODULAR_SERVER_CAPTURE_RING_DEFINITIONS_H_
+
+
+namespace modular_server
+{
+// public
+template <size_t SIZE>
+void CaptureRing::setStorage(uint8_t (&storage)[SIZE])
+{
+  setStorage(storage,SIZE);
+}
+
+}
+#endif
@@ -0,0 +1,143 @@
+// ----------------------------------------------------------------------------
+// CaptureStream.cpp
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#include "CaptureStream.h"
+
+
+namespace modular_server
+{
+// public
+void CaptureSink::encodeHeader(uint8_t * header,
+  uint8_t direction,
+  unsigned long time,
+  size_t length)
+{
+  header[0] = direction;
+  header[1] = time;
+  header[2] = time >> 8;
+  header[3] = time >> 16;
+  header[4] = time >> 24;
+  header[5] = length;
+}
+
+void CaptureSink::decodeHeader(const uint8_t * header,
+  uint8_t & direction,
+  unsigned long & time,
+  size_t & length)
+{
+  direction = header[0];
+  time = (unsigned long)header[1] |
+    ((unsigned long)header[2] << 8) |
+    ((unsigned long)header[3] << 16) |
+    ((unsigned long)header[4] << 24);
+  length = header[5];
+}
+
+CaptureStream::CaptureStream()
+{
+  stream_ptr_ = NULL;
+  sink_ptr_ = NULL;
+  record_length_ = 0;
+  record_direction_ = constants::CAPTURE_REQUEST;
+  record_time_ = 0;
+}
+
+void CaptureStream::setStream(Stream & stream)
+{
+  stream_ptr_ = &stream;
+}
+
+void CaptureStream::setSink(CaptureSink & sink)
+{
+  flushRecord();
+  sink_ptr_ = &sink;
+}
+
+void CaptureStream::flushRecord()
+{
+  if ((record_length_ > 0) && sink_ptr_)
+  {
+    sink_ptr_->writeRecord(record_direction_,record_time_,record_,record_length_);
+  }
+  record_length_ = 0;
+}
+
+int CaptureStream::available()
+{
+  if (!stream_ptr_)
+  {
+    return 0;
+  }
+  return stream_ptr_->available();
+}
+
+int CaptureStream::read()
+{
+  if (!stream_ptr_)
+  {
+    return -1;
+  }
+  int c = stream_ptr_->read();
+  if (c >= 0)
+  {
+    capture(constants::CAPTURE_REQUEST,c);
+  }
+  return c;
+}
+
+int CaptureStream::peek()
+{
+  if (!stream_ptr_)
+  {
+    return -1;
+  }
+  return stream_ptr_->peek();
+}
+
+size_t CaptureStream::write(uint8_t byte)
+{
+  if (!stream_ptr_)
+  {
+    return 0;
+  }
+  size_t bytes_written = stream_ptr_->write(byte);
+  if (bytes_written > 0)
+  {
+    capture(constants::CAPTURE_RESPONSE,byte);
+  }
+  return bytes_written;
+}
+
+void CaptureStream::flush()
+{
+  if (stream_ptr_)
+  {
+    stream_ptr_->flush();
+  }
+}
+
+// private
+void CaptureStream::capture(uint8_t direction,
+  uint8_t byte)
+{
+  if ((record_length_ > 0) && (direction != record_direction_))
+  {
+    flushRecord();
+  }
+  if (record_length_ == 0)
+  {
+    record_direction_ = direction;
+    record_time_ = micros();
+  }
+  record_[record_length_++] = byte;
+  if ((record_length_ == constants::CAPTURE_RECORD_SIZE_MAX) || (byte == '\n'))
+  {
+    flushRecord();
+  }
+}
+
+}
@@ -0,0 +1,66 @@
+// ----------------------------------------------------------------------------
+// CaptureStream.h
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_CAPTURE_STREAM_H_
+#define _MODULAR_SERVER_CAPTURE_STREAM_H_
+#include <Arduino.h>
+
+#include "Constants.h"
+
+
+namespace modular_server
+{
+// Destination of captured traffic records
+class CaptureSink
+{
+public:
+  virtual void writeRecord(uint8_t direction,
+    unsigned long time,
+    const uint8_t * data,
+    size_t length) = 0;
+
+  static void encodeHeader(uint8_t * header,
+    uint8_t direction,
+    unsigned long time,
+    size_t length);
+  static void decodeHeader(const uint8_t * header,
+    uint8_t & direction,
+    unsigned long & time,
+    size_t & length);
+};
+
+// Wraps a server stream and records the bytes read from it as requests and
+// the bytes written to it as responses, one record per line or full record
+class CaptureStream : public Stream
+{
+public:
+  CaptureStream();
+
+  void setStream(Stream & stream);
+  void setSink(CaptureSink & sink);
+  void flushRecord();
+
+  virtual int available();
+  virtual int read();
+  virtual int peek();
+  virtual size_t write(uint8_t byte);
+  virtual void flush();
+  using Print::write;
+
+private:
+  Stream * stream_ptr_;
+  CaptureSink * sink_ptr_;
+  uint8_t record_[constants::CAPTURE_RECORD_SIZE_MAX];
+  size_t record_length_;
+  uint8_t record_direction_;
+  unsigned long record_time_;
+  void capture(uint8_t direction,
+    uint8_t byte);
+};
+}
+
+#endif
@@ -21,7 +21,8 @@ const FirmwareInfo firmware_info =
   .version_patch=4,
 };
 
-const long response_pipe_read_max = 100000;
+// milliseconds without a downstream byte before a pipe gives up
+const unsigned long response_pipe_timeout = 100;
 
 const double epsilon = 0.000000001;
 
@@ -75,6 +76,29 @@ CONSTANT_STRING(pin_value_parameter_name,"pin_value");
 const long pin_value_min = 0;
 const long pin_value_max = 255;
 
+CONSTANT_STRING(response_framing_parameter_name,"response_framing");
+
+CONSTANT_STRING(sequence_name_parameter_name,"sequence_name");
+CONSTANT_STRING(sequence_steps_parameter_name,"sequence_steps");
+CONSTANT_STRING(sequence_arguments_parameter_name,"sequence_arguments");
+
+CONSTANT_STRING(ms_units,"ms");
+CONSTANT_STRING(telemetry_request_parameter_name,"telemetry_request");
+CONSTANT_STRING(telemetry_period_parameter_name,"telemetry_period");
+const long telemetry_period_min = 1;
+const long telemetry_period_max = 3600000;
+CONSTANT_STRING(telemetry_id_parameter_name,"telemetry_id");
+
+CONSTANT_STRING(rule_condition_parameter_name,"rule_condition");
+CONSTANT_STRING(rule_action_parameter_name,"rule_action");
+CONSTANT_STRING(rule_id_parameter_name,"rule_id");
+
+CONSTANT_STRING(waveform_pins_parameter_name,"waveform_pins");
+CONSTANT_STRING(waveform_period_parameter_name,"waveform_period");
+const long waveform_period_min = 1;
+const long waveform_period_max = 60000;
+CONSTANT_STRING(waveform_samples_parameter_name,"waveform_samples");
+
 // Functions
 CONSTANT_STRING(get_method_ids_function_name,"getMethodIds");
 CONSTANT_STRING(help_function_name,"?");
@@ -90,6 +114,24 @@ CONSTANT_STRING(set_pin_mode_function_name,"setPinMode");
 CONSTANT_STRING(get_pin_value_function_name,"getPinValue");
 CONSTANT_STRING(set_pin_value_function_name,"setPinValue");
 CONSTANT_STRING(get_memory_free_function_name,"getMemoryFree");
+CONSTANT_STRING(get_request_trace_function_name,"getRequestTrace");
+CONSTANT_STRING(get_timing_info_function_name,"getTimingInfo");
+CONSTANT_STRING(get_memory_usage_function_name,"getMemoryUsage");
+CONSTANT_STRING(reset_stack_high_water_function_name,"resetStackHighWater");
+CONSTANT_STRING(set_response_framing_function_name,"setResponseFraming");
+CONSTANT_STRING(set_sequence_function_name,"setSequence");
+CONSTANT_STRING(run_sequence_function_name,"runSequence");
+CONSTANT_STRING(get_sequences_function_name,"getSequences");
+CONSTANT_STRING(add_telemetry_function_name,"addTelemetry");
+CONSTANT_STRING(remove_telemetry_function_name,"removeTelemetry");
+CONSTANT_STRING(add_rule_function_name,"addRule");
+CONSTANT_STRING(remove_rule_function_name,"removeRule");
+CONSTANT_STRING(get_rules_function_name,"getRules");
+CONSTANT_STRING(setup_waveform_function_name,"setupWaveform");
+CONSTANT_STRING(add_waveform_samples_function_name,"addWaveformSamples");
+CONSTANT_STRING(play_waveform_function_name,"playWaveform");
+CONSTANT_STRING(stop_waveform_function_name,"stopWaveform");
+CONSTANT_STRING(get_waveform_status_function_name,"getWaveformStatus");
 
 // Callbacks
 
@@ -104,6 +146,8 @@ CONSTANT_STRING(object_request_error_data,"JSON object requests not supported. M
 CONSTANT_STRING(request_length_error_data,"Request length too long.");
 CONSTANT_STRING(parameter_not_found_error_data,"Parameter not found");
 CONSTANT_STRING(parameter_incorrect_type_error_data," parameter has incorrect type.");
+CONSTANT_STRING(api_table_parameter_not_found_error_data," function table names a parameter that was not created: ");
+CONSTANT_STRING(api_table_property_not_found_error_data,"property table names a property that was not created: ");
 CONSTANT_STRING(property_not_found_error_data,"Property not found");
 CONSTANT_STRING(property_not_array_type_error_data,"Property not array type");
 CONSTANT_STRING(property_element_index_out_of_bounds_error_data,"property_element_index out of bounds");
@@ -118,6 +162,21 @@ CONSTANT_STRING(property_function_not_found_error_data,"Property function not fo
 CONSTANT_STRING(incorrect_property_parameter_number_error_data,"Incorrect number of property parameters. ")
 CONSTANT_STRING(callback_function_not_found_error_data,"Callback function not found");
 CONSTANT_STRING(incorrect_callback_parameter_number_error_data,"Incorrect number of callback parameters. ")
+CONSTANT_STRING(sequence_not_found_error_data,"Sequence not found");
+CONSTANT_STRING(sequence_storage_full_error_data,"Sequence storage full");
+CONSTANT_STRING(sequence_too_long_error_data,"Sequence too long");
+CONSTANT_STRING(sequence_step_error_data,"Sequence steps must be request arrays");
+CONSTANT_STRING(sequence_nested_error_data,"Sequences cannot run sequences");
+CONSTANT_STRING(telemetry_storage_full_error_data,"Telemetry storage full");
+CONSTANT_STRING(telemetry_request_too_long_error_data,"Telemetry request too long");
+CONSTANT_STRING(rule_condition_error_data,"Rule condition must be [pin,pin_name] or [property,property_name,> or <,threshold]");
+CONSTANT_STRING(rule_action_error_data,"Rule action must be [setPinValue,pin_name,pin_value] or [trigger,callback_name]");
+CONSTANT_STRING(rule_storage_full_error_data,"Rule storage full");
+CONSTANT_STRING(waveform_pins_error_data,"Waveform pins must be in DIGITAL_OUTPUT or ANALOG_OUTPUT mode");
+CONSTANT_STRING(waveform_samples_error_data,"Waveform sample count must be a multiple of the waveform pin count");
+CONSTANT_STRING(waveform_queue_full_error_data,"Waveform queue full");
+CONSTANT_STRING(pipe_response_timeout_error_data,"Downstream response timed out");
+CONSTANT_STRING(pipe_response_too_long_error_data,"Downstream response too long");
 
 const int parse_error_code = -32700;
 const int invalid_request_error_code = -32600;
@@ -189,6 +248,53 @@ CONSTANT_STRING(interrupt_number_constant_string,"interrupt_number");
 CONSTANT_STRING(pin_number_constant_string,"pin_number");
 CONSTANT_STRING(pin_mode_constant_string,"pin_mode");
 CONSTANT_STRING(processor_constant_string,"processor");
+CONSTANT_STRING(request_number_constant_string,"request_number");
+CONSTANT_STRING(time_constant_string,"time");
+CONSTANT_STRING(telemetry_constant_string,"telemetry");
+CONSTANT_STRING(sequence_constant_string,"sequence");
+CONSTANT_STRING(pin_constant_string,"pin");
+CONSTANT_STRING(property_constant_string,"property");
+CONSTANT_STRING(greater_than_constant_string,">");
+CONSTANT_STRING(less_than_constant_string,"<");
+CONSTANT_STRING(rule_constant_string,"rule");
+CONSTANT_STRING(condition_constant_string,"condition");
+CONSTANT_STRING(action_constant_string,"action");
+CONSTANT_STRING(hit_count_constant_string,"hit_count");
+CONSTANT_STRING(latency_constant_string,"latency");
+CONSTANT_STRING(latency_max_constant_string,"latency_max");
+CONSTANT_STRING(playing_constant_string,"playing");
+CONSTANT_STRING(channel_count_constant_string,"channel_count");
+CONSTANT_STRING(period_constant_string,"period");
+CONSTANT_STRING(frame_count_constant_string,"frame_count");
+CONSTANT_STRING(free_block_count_constant_string,"free_block_count");
+CONSTANT_STRING(underrun_count_constant_string,"underrun_count");
+CONSTANT_STRING(method_index_constant_string,"method_index");
+CONSTANT_STRING(stream_index_constant_string,"stream_index");
+CONSTANT_STRING(bytes_read_constant_string,"bytes_read");
+CONSTANT_STRING(error_code_constant_string,"error_code");
+CONSTANT_STRING(read_duration_constant_string,"read_duration");
+CONSTANT_STRING(sanitize_duration_constant_string,"sanitize_duration");
+CONSTANT_STRING(deserialize_duration_constant_string,"deserialize_duration");
+CONSTANT_STRING(lookup_duration_constant_string,"lookup_duration");
+CONSTANT_STRING(check_duration_constant_string,"check_duration");
+CONSTANT_STRING(handler_duration_constant_string,"handler_duration");
+CONSTANT_STRING(end_duration_constant_string,"end_duration");
+CONSTANT_STRING(timing_monitor_enabled_constant_string,"timing_monitor_enabled");
+CONSTANT_STRING(loop_count_constant_string,"loop_count");
+CONSTANT_STRING(loop_period_max_constant_string,"loop_period_max");
+CONSTANT_STRING(loop_period_deadline_constant_string,"loop_period_deadline");
+CONSTANT_STRING(deadline_miss_count_constant_string,"deadline_miss_count");
+CONSTANT_STRING(server_duration_max_constant_string,"server_duration_max");
+CONSTANT_STRING(loop_period_histogram_constant_string,"loop_period_histogram");
+CONSTANT_STRING(callback_duration_max_constant_string,"callback_duration_max");
+CONSTANT_STRING(used_constant_string,"used");
+CONSTANT_STRING(streams_constant_string,"streams");
+CONSTANT_STRING(subsets_constant_string,"subsets");
+CONSTANT_STRING(request_constant_string,"request");
+CONSTANT_STRING(json_document_constant_string,"json_document");
+CONSTANT_STRING(arena_constant_string,"arena");
+CONSTANT_STRING(stack_high_water_constant_string,"stack_high_water");
+CONSTANT_STRING(memory_free_constant_string,"memory_free");
 
 #if defined(__AVR_ATmega1280__)
 CONSTANT_STRING(processor_name_constant_string,"ATmega1280");
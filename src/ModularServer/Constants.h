@@ -9,45 +9,256 @@
 #define _MODULAR_SERVER_CONSTANTS_H_
 #include <ConstantVariable.h>
 #include <Array.h>
+#include <JsonStream.h>
 
 // #include "Pin.h"
 
+// Capacities may be overridden at compile time with build flags,
+// e.g. -D MODULAR_SERVER_PIN_COUNT_MAX=16
+#ifndef MODULAR_SERVER_FIRMWARE_COUNT_MAX
+#define MODULAR_SERVER_FIRMWARE_COUNT_MAX 8
+#endif
+#ifndef MODULAR_SERVER_HARDWARE_COUNT_MAX
+#define MODULAR_SERVER_HARDWARE_COUNT_MAX 4
+#endif
+#ifndef MODULAR_SERVER_FUNCTION_PARAMETER_COUNT_MAX
+#define MODULAR_SERVER_FUNCTION_PARAMETER_COUNT_MAX 8
+#endif
+#ifndef MODULAR_SERVER_CALLBACK_PROPERTY_COUNT_MAX
+#define MODULAR_SERVER_CALLBACK_PROPERTY_COUNT_MAX 8
+#endif
+#ifndef MODULAR_SERVER_CALLBACK_PIN_COUNT_MAX
+#define MODULAR_SERVER_CALLBACK_PIN_COUNT_MAX 8
+#endif
+#ifndef MODULAR_SERVER_PIN_COUNT_MAX
+#define MODULAR_SERVER_PIN_COUNT_MAX 64
+#endif
+// pins are looked up by pin number and by interrupt number in tables of these
+// sizes, pins with larger numbers are found by walking the pins instead
+#ifndef MODULAR_SERVER_PIN_NUMBER_COUNT_MAX
+#if defined(NUM_DIGITAL_PINS)
+#define MODULAR_SERVER_PIN_NUMBER_COUNT_MAX NUM_DIGITAL_PINS
+#else
+#define MODULAR_SERVER_PIN_NUMBER_COUNT_MAX MODULAR_SERVER_PIN_COUNT_MAX
+#endif
+#endif
+#ifndef MODULAR_SERVER_INTERRUPT_NUMBER_COUNT_MAX
+#if defined(EXTERNAL_NUM_INTERRUPTS)
+#define MODULAR_SERVER_INTERRUPT_NUMBER_COUNT_MAX EXTERNAL_NUM_INTERRUPTS
+#else
+#define MODULAR_SERVER_INTERRUPT_NUMBER_COUNT_MAX MODULAR_SERVER_PIN_NUMBER_COUNT_MAX
+#endif
+#endif
+#ifndef MODULAR_SERVER_PROPERTY_COUNT_MAX
+#define MODULAR_SERVER_PROPERTY_COUNT_MAX 32
+#endif
+#ifndef MODULAR_SERVER_PARAMETER_COUNT_MAX
+#define MODULAR_SERVER_PARAMETER_COUNT_MAX 64
+#endif
+#ifndef MODULAR_SERVER_FUNCTION_COUNT_MAX
+#define MODULAR_SERVER_FUNCTION_COUNT_MAX 64
+#endif
+#ifndef MODULAR_SERVER_CALLBACK_COUNT_MAX
+#define MODULAR_SERVER_CALLBACK_COUNT_MAX 16
+#endif
+#ifndef MODULAR_SERVER_SERVER_STREAM_COUNT_MAX
+#define MODULAR_SERVER_SERVER_STREAM_COUNT_MAX 4
+#endif
+#ifndef MODULAR_SERVER_JSON_DOCUMENT_SIZE
+#define MODULAR_SERVER_JSON_DOCUMENT_SIZE 1024
+#endif
+#ifndef MODULAR_SERVER_STRING_LENGTH_REQUEST
+#define MODULAR_SERVER_STRING_LENGTH_REQUEST 257
+#endif
+#ifndef MODULAR_SERVER_STRING_LENGTH_ERROR
+#define MODULAR_SERVER_STRING_LENGTH_ERROR 257
+#endif
+#ifndef MODULAR_SERVER_SUBSET_ELEMENT_COUNT_MAX
+#define MODULAR_SERVER_SUBSET_ELEMENT_COUNT_MAX 20
+#endif
+#ifndef MODULAR_SERVER_JSON_TOKEN_MAX
+#define MODULAR_SERVER_JSON_TOKEN_MAX 32
+#endif
+#ifndef MODULAR_SERVER_REQUEST_TRACE_COUNT_MAX
+#define MODULAR_SERVER_REQUEST_TRACE_COUNT_MAX 0
+#endif
+#ifndef MODULAR_SERVER_PIN_PULSE_EVENT_COUNT_MAX
+#define MODULAR_SERVER_PIN_PULSE_EVENT_COUNT_MAX 8
+#endif
+#ifndef MODULAR_SERVER_RESPONSE_FRAME_CHUNK_SIZE
+#define MODULAR_SERVER_RESPONSE_FRAME_CHUNK_SIZE 64
+#endif
+#ifndef MODULAR_SERVER_STRING_LENGTH_PIPE_RESPONSE
+#define MODULAR_SERVER_STRING_LENGTH_PIPE_RESPONSE 129
+#endif
+#ifndef MODULAR_SERVER_SOCKET_STREAM_BUFFER_SIZE
+#define MODULAR_SERVER_SOCKET_STREAM_BUFFER_SIZE 512
+#endif
+#ifndef MODULAR_SERVER_CAPTURE_RECORD_SIZE_MAX
+#define MODULAR_SERVER_CAPTURE_RECORD_SIZE_MAX 64
+#endif
+#ifndef MODULAR_SERVER_SEQUENCE_COUNT_MAX
+#define MODULAR_SERVER_SEQUENCE_COUNT_MAX 0
+#endif
+#ifndef MODULAR_SERVER_STRING_LENGTH_SEQUENCE
+#define MODULAR_SERVER_STRING_LENGTH_SEQUENCE 257
+#endif
+#ifndef MODULAR_SERVER_SEQUENCE_JSON_DOCUMENT_SIZE
+#define MODULAR_SERVER_SEQUENCE_JSON_DOCUMENT_SIZE 512
+#endif
+#ifndef MODULAR_SERVER_TELEMETRY_COUNT_MAX
+#define MODULAR_SERVER_TELEMETRY_COUNT_MAX 0
+#endif
+#ifndef MODULAR_SERVER_STRING_LENGTH_TELEMETRY_REQUEST
+#define MODULAR_SERVER_STRING_LENGTH_TELEMETRY_REQUEST 129
+#endif
+#ifndef MODULAR_SERVER_RULE_COUNT_MAX
+#define MODULAR_SERVER_RULE_COUNT_MAX 0
+#endif
+#ifndef MODULAR_SERVER_WAVEFORM_CHANNEL_COUNT_MAX
+#define MODULAR_SERVER_WAVEFORM_CHANNEL_COUNT_MAX 0
+#endif
+#ifndef MODULAR_SERVER_WAVEFORM_BLOCK_SAMPLE_COUNT_MAX
+#define MODULAR_SERVER_WAVEFORM_BLOCK_SAMPLE_COUNT_MAX 64
+#endif
+
+// The request arena holds what one request uses at the same time: the request
+// string, its json document, a subset string and the error string built from
+// it, plus the parsed steps while a sequence runs. The request string and each
+// json document may be preceded by alignment padding.
+#ifndef MODULAR_SERVER_REQUEST_ARENA_SIZE
+#if MODULAR_SERVER_SEQUENCE_COUNT_MAX > 0
+#define MODULAR_SERVER_REQUEST_ARENA_SIZE (MODULAR_SERVER_STRING_LENGTH_REQUEST + MODULAR_SERVER_JSON_DOCUMENT_SIZE + 2*MODULAR_SERVER_STRING_LENGTH_ERROR + MODULAR_SERVER_SEQUENCE_JSON_DOCUMENT_SIZE + 3*(sizeof(double) - 1))
+#else
+#define MODULAR_SERVER_REQUEST_ARENA_SIZE (MODULAR_SERVER_STRING_LENGTH_REQUEST + MODULAR_SERVER_JSON_DOCUMENT_SIZE + 2*MODULAR_SERVER_STRING_LENGTH_ERROR + 3*(sizeof(double) - 1))
+#endif
+#endif
+
 
 namespace modular_server
 {
 namespace constants
 {
-enum {FIRMWARE_COUNT_MAX=8};
-enum {HARDWARE_COUNT_MAX=4};
+enum {FIRMWARE_COUNT_MAX=MODULAR_SERVER_FIRMWARE_COUNT_MAX};
+// one bit per firmware, indexed like firmware_info_array_
+typedef unsigned long FirmwareMask;
+#if MODULAR_SERVER_FIRMWARE_COUNT_MAX > 32
+#error "MODULAR_SERVER_FIRMWARE_COUNT_MAX must fit in FirmwareMask"
+#endif
+enum {HARDWARE_COUNT_MAX=MODULAR_SERVER_HARDWARE_COUNT_MAX};
 
 //MAX values must be >= 1, >= created/copied count, < RAM limit
 enum{SERVER_PROPERTY_COUNT_MAX=1};
-enum{SERVER_PARAMETER_COUNT_MAX=5};
-enum{SERVER_FUNCTION_COUNT_MAX=14};
+enum{SERVER_PARAMETER_COUNT_MAX=18};
+enum{SERVER_FUNCTION_COUNT_MAX=32};
 enum{SERVER_CALLBACK_COUNT_MAX=1};
 
-enum {FUNCTION_PARAMETER_COUNT_MAX=8};
-enum {CALLBACK_PROPERTY_COUNT_MAX=8};
-enum {CALLBACK_PIN_COUNT_MAX=8};
-enum {PIN_COUNT_MAX=64};
+enum {FUNCTION_PARAMETER_COUNT_MAX=MODULAR_SERVER_FUNCTION_PARAMETER_COUNT_MAX};
+enum {CALLBACK_PROPERTY_COUNT_MAX=MODULAR_SERVER_CALLBACK_PROPERTY_COUNT_MAX};
+enum {CALLBACK_PIN_COUNT_MAX=MODULAR_SERVER_CALLBACK_PIN_COUNT_MAX};
+enum {PIN_COUNT_MAX=MODULAR_SERVER_PIN_COUNT_MAX};
+enum {PIN_NUMBER_COUNT_MAX=MODULAR_SERVER_PIN_NUMBER_COUNT_MAX};
+enum {INTERRUPT_NUMBER_COUNT_MAX=MODULAR_SERVER_INTERRUPT_NUMBER_COUNT_MAX};
 
-enum{SERVER_STREAM_COUNT_MAX=4};
+// elements of all firmware are indexed by flat pointer arrays of these sizes,
+// lookups fall back to walking the firmware arrays when an index is too small
+enum {PROPERTY_COUNT_MAX=MODULAR_SERVER_PROPERTY_COUNT_MAX};
+enum {PARAMETER_COUNT_MAX=MODULAR_SERVER_PARAMETER_COUNT_MAX};
+enum {FUNCTION_COUNT_MAX=MODULAR_SERVER_FUNCTION_COUNT_MAX};
+enum {CALLBACK_COUNT_MAX=MODULAR_SERVER_CALLBACK_COUNT_MAX};
 
-enum{JSON_DOCUMENT_SIZE=1024};
+enum{SERVER_STREAM_COUNT_MAX=MODULAR_SERVER_SERVER_STREAM_COUNT_MAX};
 
-enum{STRING_LENGTH_REQUEST=257};
-enum{STRING_LENGTH_ERROR=257};
-enum{STRING_LENGTH_PARAMETER_COUNT=3};
+enum{JSON_DOCUMENT_SIZE=MODULAR_SERVER_JSON_DOCUMENT_SIZE};
+
+enum{STRING_LENGTH_REQUEST=MODULAR_SERVER_STRING_LENGTH_REQUEST};
+enum{STRING_LENGTH_ERROR=MODULAR_SERVER_STRING_LENGTH_ERROR};
+enum{STRING_LENGTH_PARAMETER_COUNT=11};
 enum{STRING_LENGTH_SUBSET=257};
 enum{STRING_LENGTH_SUBSET_ELEMENT=32};
 enum{STRING_LENGTH_VERSION=18};
 enum{STRING_LENGTH_VERSION_PROPERTY=6};
-enum{SUBSET_ELEMENT_COUNT_MAX=20};
 
-enum {JSON_TOKEN_MAX=32};
+// numeric array values are checked and stored in blocks of this many elements
+enum{ARRAY_VALUE_BLOCK_SIZE=16};
+
+// smaller subsets are searched linearly even when index storage is set
+enum{SUBSET_INDEX_SIZE_MIN=8};
+enum{SUBSET_ELEMENT_COUNT_MAX=MODULAR_SERVER_SUBSET_ELEMENT_COUNT_MAX};
+
+enum {JSON_TOKEN_MAX=MODULAR_SERVER_JSON_TOKEN_MAX};
 
 enum {FIRMWARE_NAME_JSON_DOCUMENT_SIZE=128};
 
+// request buffer, JSON documents and error strings are allocated from the request arena
+enum{REQUEST_ARENA_SIZE=MODULAR_SERVER_REQUEST_ARENA_SIZE};
+
+// responses on streams with framing enabled are written in chunks of this size
+enum{RESPONSE_FRAME_CHUNK_SIZE=MODULAR_SERVER_RESPONSE_FRAME_CHUNK_SIZE};
+
+// pending pipe forwards hold a downstream response line of this length until
+// it is complete, so a timeout can be answered with an error instead
+enum{STRING_LENGTH_PIPE_RESPONSE=MODULAR_SERVER_STRING_LENGTH_PIPE_RESPONSE};
+
+// host socket streams buffer this many bytes in each direction
+enum{SOCKET_STREAM_BUFFER_SIZE=MODULAR_SERVER_SOCKET_STREAM_BUFFER_SIZE};
+
+// captured traffic is recorded as a direction byte, a four byte little endian
+// microsecond time and a length byte followed by at most this many bytes
+enum{CAPTURE_RECORD_SIZE_MAX=MODULAR_SERVER_CAPTURE_RECORD_SIZE_MAX};
+#if MODULAR_SERVER_CAPTURE_RECORD_SIZE_MAX > 255
+#error "MODULAR_SERVER_CAPTURE_RECORD_SIZE_MAX must fit in the record length byte"
+#endif
+enum{CAPTURE_RECORD_HEADER_SIZE=6};
+
+// request sequences are stored as compact JSON text and parsed into their own
+// document when run, placeholder strings "$0" to "$9" in a step are replaced
+// by the elements of the runSequence argument array
+enum{SEQUENCE_COUNT_MAX=MODULAR_SERVER_SEQUENCE_COUNT_MAX};
+enum{STRING_LENGTH_SEQUENCE=MODULAR_SERVER_STRING_LENGTH_SEQUENCE};
+enum{STRING_LENGTH_SEQUENCE_NAME=33};
+enum{SEQUENCE_JSON_DOCUMENT_SIZE=MODULAR_SERVER_SEQUENCE_JSON_DOCUMENT_SIZE};
+enum{SEQUENCE_STEP_COUNT_MAX=16};
+enum{SEQUENCE_ARGUMENT_COUNT_MAX=10};
+
+// telemetry requests are stored as compact JSON text and run on their stream
+// every period, at most one telemetry message is written per handleRequest
+enum{TELEMETRY_COUNT_MAX=MODULAR_SERVER_TELEMETRY_COUNT_MAX};
+enum{STRING_LENGTH_TELEMETRY_REQUEST=MODULAR_SERVER_STRING_LENGTH_TELEMETRY_REQUEST};
+
+enum{RULE_COUNT_MAX=MODULAR_SERVER_RULE_COUNT_MAX};
+enum RuleCondition
+{
+  RULE_CONDITION_PIN=0,
+  RULE_CONDITION_PROPERTY_ABOVE=1,
+  RULE_CONDITION_PROPERTY_BELOW=2,
+};
+enum RuleAction
+{
+  RULE_ACTION_SET_PIN_VALUE=0,
+  RULE_ACTION_TRIGGER_CALLBACK=1,
+};
+
+// waveform samples are interleaved by channel, one block is filled per
+// request while the other plays, so a block must fit in a request
+enum{WAVEFORM_CHANNEL_COUNT_MAX=MODULAR_SERVER_WAVEFORM_CHANNEL_COUNT_MAX};
+enum{WAVEFORM_BLOCK_SAMPLE_COUNT_MAX=MODULAR_SERVER_WAVEFORM_BLOCK_SAMPLE_COUNT_MAX};
+enum{WAVEFORM_BLOCK_COUNT=2};
+
+enum CaptureDirection
+{
+  CAPTURE_REQUEST=0,
+  CAPTURE_RESPONSE=1,
+};
+enum{ARENA_ALIGNMENT=sizeof(double)};
+
+#if MODULAR_SERVER_REQUEST_TRACE_COUNT_MAX > 0
+enum{REQUEST_TRACE_COUNT_MAX=MODULAR_SERVER_REQUEST_TRACE_COUNT_MAX};
+#endif
+
+// bin n counts loop periods >= 2^n and < 2^(n+1) microseconds, last bin counts the rest
+enum{LOOP_PERIOD_HISTOGRAM_BIN_COUNT=20};
+
 struct FirmwareInfo
 {
   const ConstantString * const name_ptr;
@@ -64,6 +275,43 @@ struct HardwareInfo
   const size_t version_minor;
 };
 
+struct Sequence
+{
+  char name[STRING_LENGTH_SEQUENCE_NAME];
+  char steps[STRING_LENGTH_SEQUENCE];
+};
+
+// times in milliseconds
+struct Telemetry
+{
+  char request[STRING_LENGTH_TELEMETRY_REQUEST];
+  size_t stream_index;
+  unsigned long period;
+  unsigned long next_time;
+  unsigned long sequence;
+  bool active;
+};
+
+#if MODULAR_SERVER_REQUEST_TRACE_COUNT_MAX > 0
+// durations in microseconds
+struct RequestTrace
+{
+  unsigned long request_number;
+  unsigned long time;
+  int method_index;
+  size_t stream_index;
+  long bytes_read;
+  int error_code;
+  unsigned long read_duration;
+  unsigned long sanitize_duration;
+  unsigned long deserialize_duration;
+  unsigned long lookup_duration;
+  unsigned long check_duration;
+  unsigned long handler_duration;
+  unsigned long end_duration;
+};
+#endif
+
 union NumberType
 {
   long l;
@@ -76,15 +324,61 @@ union SubsetMemberType
   const ConstantString * cs_ptr;
 };
 
+// subset members sorted by value, or by string hash, for binary search
+struct SubsetIndexEntry
+{
+  long key;
+  size_t member_index;
+};
+
+// API tables, and the parameter name arrays they point to, must be declared
+// const PROGMEM and initialized with constant expressions so that on AVR they
+// stay in flash, createParameters and createFunctions copy one entry at a time
+// out of flash, the Parameter and Function objects created are still in RAM
+struct ParameterInfo
+{
+  const ConstantString * name_ptr;
+  JsonStream::JsonTypes type;
+  JsonStream::JsonTypes array_element_type;
+  const ConstantString * units_ptr;
+  bool range_is_set;
+  NumberType min;
+  NumberType max;
+  bool array_length_range_is_set;
+  size_t array_length_min;
+  size_t array_length_max;
+  SubsetMemberType * subset_ptr;
+  size_t subset_size;
+};
+
+struct FunctionInfo
+{
+  const ConstantString * name_ptr;
+  const ConstantString * const * parameter_name_ptrs;
+  size_t parameter_count;
+  JsonStream::JsonTypes result_type;
+  JsonStream::JsonTypes result_array_element_type;
+  const ConstantString * result_units_ptr;
+};
+
+// property tables set the units, ranges, array length ranges and subsets of
+// properties already created with their default values
+typedef ParameterInfo PropertyInfo;
+
+struct CallbackInfo
+{
+  const ConstantString * name_ptr;
+};
+
 extern ConstantString firmware_name;
 extern const FirmwareInfo firmware_info;
 
-extern const long response_pipe_read_max;
+extern const unsigned long response_pipe_timeout;
 
 extern const double epsilon;
 
 // Pins
-enum{PIN_PULSE_EVENT_COUNT_MAX=8};
+enum{PIN_PULSE_EVENT_COUNT_MAX=MODULAR_SERVER_PIN_PULSE_EVENT_COUNT_MAX};
 extern const size_t pin_pulse_timer_number;
 extern const uint32_t pin_pulse_delay;
 extern const uint32_t pin_pulse_count;
@@ -122,6 +416,29 @@ extern ConstantString pin_value_parameter_name;
 extern const long pin_value_min;
 extern const long pin_value_max;
 
+extern ConstantString response_framing_parameter_name;
+
+extern ConstantString sequence_name_parameter_name;
+extern ConstantString sequence_steps_parameter_name;
+extern ConstantString sequence_arguments_parameter_name;
+
+extern ConstantString ms_units;
+extern ConstantString telemetry_request_parameter_name;
+extern ConstantString telemetry_period_parameter_name;
+extern const long telemetry_period_min;
+extern const long telemetry_period_max;
+extern ConstantString telemetry_id_parameter_name;
+
+extern ConstantString rule_condition_parameter_name;
+extern ConstantString rule_action_parameter_name;
+extern ConstantString rule_id_parameter_name;
+
+extern ConstantString waveform_pins_parameter_name;
+extern ConstantString waveform_period_parameter_name;
+extern const long waveform_period_min;
+extern const long waveform_period_max;
+extern ConstantString waveform_samples_parameter_name;
+
 // Functions
 extern ConstantString get_method_ids_function_name;
 extern ConstantString help_function_name;
@@ -137,6 +454,24 @@ extern ConstantString set_pin_mode_function_name;
 extern ConstantString get_pin_value_function_name;
 extern ConstantString set_pin_value_function_name;
 extern ConstantString get_memory_free_function_name;
+extern ConstantString get_request_trace_function_name;
+extern ConstantString get_timing_info_function_name;
+extern ConstantString get_memory_usage_function_name;
+extern ConstantString reset_stack_high_water_function_name;
+extern ConstantString set_response_framing_function_name;
+extern ConstantString set_sequence_function_name;
+extern ConstantString run_sequence_function_name;
+extern ConstantString get_sequences_function_name;
+extern ConstantString add_telemetry_function_name;
+extern ConstantString remove_telemetry_function_name;
+extern ConstantString add_rule_function_name;
+extern ConstantString remove_rule_function_name;
+extern ConstantString get_rules_function_name;
+extern ConstantString setup_waveform_function_name;
+extern ConstantString add_waveform_samples_function_name;
+extern ConstantString play_waveform_function_name;
+extern ConstantString stop_waveform_function_name;
+extern ConstantString get_waveform_status_function_name;
 
 // Callbacks
 
@@ -152,6 +487,8 @@ extern ConstantString object_request_error_data;
 extern ConstantString request_length_error_data;
 extern ConstantString parameter_not_found_error_data;
 extern ConstantString parameter_incorrect_type_error_data;
+extern ConstantString api_table_parameter_not_found_error_data;
+extern ConstantString api_table_property_not_found_error_data;
 extern ConstantString property_not_found_error_data;
 extern ConstantString property_not_array_type_error_data;
 extern ConstantString property_element_index_out_of_bounds_error_data;
@@ -166,6 +503,21 @@ extern ConstantString property_function_not_found_error_data;
 extern ConstantString incorrect_property_parameter_number_error_data;
 extern ConstantString callback_function_not_found_error_data;
 extern ConstantString incorrect_callback_parameter_number_error_data;
+extern ConstantString sequence_not_found_error_data;
+extern ConstantString sequence_storage_full_error_data;
+extern ConstantString sequence_too_long_error_data;
+extern ConstantString sequence_step_error_data;
+extern ConstantString sequence_nested_error_data;
+extern ConstantString telemetry_storage_full_error_data;
+extern ConstantString telemetry_request_too_long_error_data;
+extern ConstantString rule_condition_error_data;
+extern ConstantString rule_action_error_data;
+extern ConstantString rule_storage_full_error_data;
+extern ConstantString waveform_pins_error_data;
+extern ConstantString waveform_samples_error_data;
+extern ConstantString waveform_queue_full_error_data;
+extern ConstantString pipe_response_timeout_error_data;
+extern ConstantString pipe_response_too_long_error_data;
 
 extern const int parse_error_code;
 extern const int invalid_request_error_code;
@@ -238,6 +590,53 @@ extern ConstantString pin_number_constant_string;
 extern ConstantString pin_mode_constant_string;
 extern ConstantString processor_constant_string;
 extern ConstantString processor_name_constant_string;
+extern ConstantString request_number_constant_string;
+extern ConstantString time_constant_string;
+extern ConstantString telemetry_constant_string;
+extern ConstantString sequence_constant_string;
+extern ConstantString pin_constant_string;
+extern ConstantString property_constant_string;
+extern ConstantString greater_than_constant_string;
+extern ConstantString less_than_constant_string;
+extern ConstantString rule_constant_string;
+extern ConstantString condition_constant_string;
+extern ConstantString action_constant_string;
+extern ConstantString hit_count_constant_string;
+extern ConstantString latency_constant_string;
+extern ConstantString latency_max_constant_string;
+extern ConstantString playing_constant_string;
+extern ConstantString channel_count_constant_string;
+extern ConstantString period_constant_string;
+extern ConstantString frame_count_constant_string;
+extern ConstantString free_block_count_constant_string;
+extern ConstantString underrun_count_constant_string;
+extern ConstantString method_index_constant_string;
+extern ConstantString stream_index_constant_string;
+extern ConstantString bytes_read_constant_string;
+extern ConstantString error_code_constant_string;
+extern ConstantString read_duration_constant_string;
+extern ConstantString sanitize_duration_constant_string;
+extern ConstantString deserialize_duration_constant_string;
+extern ConstantString lookup_duration_constant_string;
+extern ConstantString check_duration_constant_string;
+extern ConstantString handler_duration_constant_string;
+extern ConstantString end_duration_constant_string;
+extern ConstantString timing_monitor_enabled_constant_string;
+extern ConstantString loop_count_constant_string;
+extern ConstantString loop_period_max_constant_string;
+extern ConstantString loop_period_deadline_constant_string;
+extern ConstantString deadline_miss_count_constant_string;
+extern ConstantString server_duration_max_constant_string;
+extern ConstantString loop_period_histogram_constant_string;
+extern ConstantString callback_duration_max_constant_string;
+extern ConstantString used_constant_string;
+extern ConstantString streams_constant_string;
+extern ConstantString subsets_constant_string;
+extern ConstantString request_constant_string;
+extern ConstantString json_document_constant_string;
+extern ConstantString arena_constant_string;
+extern ConstantString stack_high_water_constant_string;
+extern ConstantString memory_free_constant_string;
 
 enum {ALL_ARRAY_SIZE=1};
 extern ConstantString * all_c_style_array[ALL_ARRAY_SIZE];
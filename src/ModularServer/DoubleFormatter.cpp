@@ -0,0 +1,541 @@
+// ----------------------------------------------------------------------------
+// DoubleFormatter.cpp
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#include "DoubleFormatter.h"
+
+
+namespace modular_server
+{
+namespace
+{
+const unsigned long powers_of_ten[DoubleFormatter::FRACTION_DIGITS_MAX+1] =
+{
+  1UL,
+  10UL,
+  100UL,
+  1000UL,
+  10000UL,
+  100000UL,
+  1000000UL,
+  10000000UL,
+  100000000UL,
+  1000000000UL,
+};
+
+// integer part plus one rounding carry must fit in an unsigned long
+const double fixed_magnitude_max = 2147483647.0;
+
+// Grisu2, from Loitsch, "Printing Floating-Point Numbers Quickly and
+// Accurately with Integers". The double and the boundaries of the interval
+// that reads back as it are scaled by a cached power of ten so their digits
+// can be generated with 64 bit integer arithmetic. The digits always read
+// back as the same double and are the shortest that do for nearly all values.
+struct DiyFp
+{
+  uint64_t f;
+  int e;
+};
+
+struct CachedPower
+{
+  uint64_t f;
+  int16_t e;
+  int16_t k;
+};
+
+// scaled values land in [2^ALPHA,2^(ALPHA+28)) times 2^64
+const int ALPHA = -60;
+const int CACHED_POWER_DECIMAL_EXPONENT_STEP = 8;
+
+// 10^k as a normalized 64 bit significand and binary exponent, every 8 decimal
+// exponents, only covering the powers the double range can use
+#if __SIZEOF_DOUBLE__ == 4
+const int CACHED_POWER_DECIMAL_EXPONENT_MIN = -36;
+const CachedPower cached_powers[] PROGMEM =
+{
+  {0xAA242499697392D3ULL,-183,-36},
+  {0xFD87B5F28300CA0EULL,-157,-28},
+  {0xBCE5086492111AEBULL,-130,-20},
+  {0x8CBCCC096F5088CCULL,-103,-12},
+  {0xD1B71758E219652CULL,-77,-4},
+  {0x9C40000000000000ULL,-50,4},
+  {0xE8D4A51000000000ULL,-24,12},
+  {0xAD78EBC5AC620000ULL,3,20},
+  {0x813F3978F8940984ULL,30,28},
+  {0xC097CE7BC90715B3ULL,56,36},
+  {0x8F7E32CE7BEA5C70ULL,83,44},
+  {0xD5D238A4ABE98068ULL,109,52}
+};
+#else
+const int CACHED_POWER_DECIMAL_EXPONENT_MIN = -300;
+const CachedPower cached_powers[] PROGMEM =
+{
+  {0xAB70FE17C79AC6CAULL,-1060,-300},
+  {0xFF77B1FCBEBCDC4FULL,-1034,-292},
+  {0xBE5691EF416BD60CULL,-1007,-284},
+  {0x8DD01FAD907FFC3CULL,-980,-276},
+  {0xD3515C2831559A83ULL,-954,-268},
+  {0x9D71AC8FADA6C9B5ULL,-927,-260},
+  {0xEA9C227723EE8BCBULL,-901,-252},
+  {0xAECC49914078536DULL,-874,-244},
+  {0x823C12795DB6CE57ULL,-847,-236},
+  {0xC21094364DFB5637ULL,-821,-228},
+  {0x9096EA6F3848984FULL,-794,-220},
+  {0xD77485CB25823AC7ULL,-768,-212},
+  {0xA086CFCD97BF97F4ULL,-741,-204},
+  {0xEF340A98172AACE5ULL,-715,-196},
+  {0xB23867FB2A35B28EULL,-688,-188},
+  {0x84C8D4DFD2C63F3BULL,-661,-180},
+  {0xC5DD44271AD3CDBAULL,-635,-172},
+  {0x936B9FCEBB25C996ULL,-608,-164},
+  {0xDBAC6C247D62A584ULL,-582,-156},
+  {0xA3AB66580D5FDAF6ULL,-555,-148},
+  {0xF3E2F893DEC3F126ULL,-529,-140},
+  {0xB5B5ADA8AAFF80B8ULL,-502,-132},
+  {0x87625F056C7C4A8BULL,-475,-124},
+  {0xC9BCFF6034C13053ULL,-449,-116},
+  {0x964E858C91BA2655ULL,-422,-108},
+  {0xDFF9772470297EBDULL,-396,-100},
+  {0xA6DFBD9FB8E5B88FULL,-369,-92},
+  {0xF8A95FCF88747D94ULL,-343,-84},
+  {0xB94470938FA89BCFULL,-316,-76},
+  {0x8A08F0F8BF0F156BULL,-289,-68},
+  {0xCDB02555653131B6ULL,-263,-60},
+  {0x993FE2C6D07B7FACULL,-236,-52},
+  {0xE45C10C42A2B3B06ULL,-210,-44},
+  {0xAA242499697392D3ULL,-183,-36},
+  {0xFD87B5F28300CA0EULL,-157,-28},
+  {0xBCE5086492111AEBULL,-130,-20},
+  {0x8CBCCC096F5088CCULL,-103,-12},
+  {0xD1B71758E219652CULL,-77,-4},
+  {0x9C40000000000000ULL,-50,4},
+  {0xE8D4A51000000000ULL,-24,12},
+  {0xAD78EBC5AC620000ULL,3,20},
+  {0x813F3978F8940984ULL,30,28},
+  {0xC097CE7BC90715B3ULL,56,36},
+  {0x8F7E32CE7BEA5C70ULL,83,44},
+  {0xD5D238A4ABE98068ULL,109,52},
+  {0x9F4F2726179A2245ULL,136,60},
+  {0xED63A231D4C4FB27ULL,162,68},
+  {0xB0DE65388CC8ADA8ULL,189,76},
+  {0x83C7088E1AAB65DBULL,216,84},
+  {0xC45D1DF942711D9AULL,242,92},
+  {0x924D692CA61BE758ULL,269,100},
+  {0xDA01EE641A708DEAULL,295,108},
+  {0xA26DA3999AEF774AULL,322,116},
+  {0xF209787BB47D6B85ULL,348,124},
+  {0xB454E4A179DD1877ULL,375,132},
+  {0x865B86925B9BC5C2ULL,402,140},
+  {0xC83553C5C8965D3DULL,428,148},
+  {0x952AB45CFA97A0B3ULL,455,156},
+  {0xDE469FBD99A05FE3ULL,481,164},
+  {0xA59BC234DB398C25ULL,508,172},
+  {0xF6C69A72A3989F5CULL,534,180},
+  {0xB7DCBF5354E9BECEULL,561,188},
+  {0x88FCF317F22241E2ULL,588,196},
+  {0xCC20CE9BD35C78A5ULL,614,204},
+  {0x98165AF37B2153DFULL,641,212},
+  {0xE2A0B5DC971F303AULL,667,220},
+  {0xA8D9D1535CE3B396ULL,694,228},
+  {0xFB9B7CD9A4A7443CULL,720,236},
+  {0xBB764C4CA7A44410ULL,747,244},
+  {0x8BAB8EEFB6409C1AULL,774,252},
+  {0xD01FEF10A657842CULL,800,260},
+  {0x9B10A4E5E9913129ULL,827,268},
+  {0xE7109BFBA19C0C9DULL,853,276},
+  {0xAC2820D9623BF429ULL,880,284},
+  {0x80444B5E7AA7CF85ULL,907,292},
+  {0xBF21E44003ACDD2DULL,933,300},
+  {0x8E679C2F5E44FF8FULL,960,308},
+  {0xD433179D9C8CB841ULL,986,316},
+  {0x9E19DB92B4E31BA9ULL,1013,324}
+};
+#endif
+
+// at most 17 significant digits for 64 bit doubles and 9 for 32 bit doubles
+enum{SHORTEST_DIGIT_COUNT_MAX=17};
+// positions of the decimal point written without an exponent
+const int DECIMAL_POINT_POSITION_MIN = -3;
+const int DECIMAL_POINT_POSITION_MAX = 15;
+
+DiyFp subtract(DiyFp x,
+  DiyFp y)
+{
+  DiyFp difference = {x.f - y.f,x.e};
+  return difference;
+}
+
+// upper 64 bits of the 128 bit product, rounded
+DiyFp multiply(DiyFp x,
+  DiyFp y)
+{
+  const uint64_t mask = 0xFFFFFFFFULL;
+  uint64_t x_low = x.f & mask;
+  uint64_t x_high = x.f >> 32;
+  uint64_t y_low = y.f & mask;
+  uint64_t y_high = y.f >> 32;
+  uint64_t low_low = x_low*y_low;
+  uint64_t low_high = x_low*y_high;
+  uint64_t high_low = x_high*y_low;
+  uint64_t high_high = x_high*y_high;
+  uint64_t middle = (low_low >> 32) + (low_high & mask) + (high_low & mask) + (1ULL << 31);
+  DiyFp product = {high_high + (low_high >> 32) + (high_low >> 32) + (middle >> 32),x.e + y.e + 64};
+  return product;
+}
+
+DiyFp normalize(DiyFp x)
+{
+  while ((x.f >> 63) == 0)
+  {
+    x.f <<= 1;
+    --x.e;
+  }
+  return x;
+}
+
+DiyFp normalizeTo(DiyFp x,
+  int e)
+{
+  x.f <<= (x.e - e);
+  x.e = e;
+  return x;
+}
+
+// magnitude must be finite and greater than zero
+void computeBoundaries(double magnitude,
+  DiyFp & w,
+  DiyFp & w_minus,
+  DiyFp & w_plus)
+{
+  // significand bits including the hidden bit, and exponent bias plus the
+  // significand bits after the point
+  const int precision = (sizeof(double) == 4) ? 24 : 53;
+  const int bias = (sizeof(double) == 4) ? 150 : 1075;
+  uint64_t bits = 0;
+  if (sizeof(double) == 4)
+  {
+    uint32_t bits_32;
+    memcpy(&bits_32,&magnitude,sizeof(bits_32));
+    bits = bits_32;
+  }
+  else
+  {
+    memcpy(&bits,&magnitude,sizeof(magnitude));
+  }
+  const uint64_t hidden_bit = 1ULL << (precision - 1);
+  uint64_t fraction = bits & (hidden_bit - 1);
+  int exponent = (int)(bits >> (precision - 1));
+
+  DiyFp v;
+  if (exponent == 0)
+  {
+    v.f = fraction;
+    v.e = 1 - bias;
+  }
+  else
+  {
+    v.f = fraction + hidden_bit;
+    v.e = exponent - bias;
+  }
+  // the next smaller double is closer when the significand is a power of two
+  bool lower_boundary_is_closer = ((fraction == 0) && (exponent > 1));
+  DiyFp m_plus = {2*v.f + 1,v.e - 1};
+  DiyFp m_minus;
+  if (lower_boundary_is_closer)
+  {
+    m_minus.f = 4*v.f - 1;
+    m_minus.e = v.e - 2;
+  }
+  else
+  {
+    m_minus.f = 2*v.f - 1;
+    m_minus.e = v.e - 1;
+  }
+  w_plus = normalize(m_plus);
+  w_minus = normalizeTo(m_minus,w_plus.e);
+  w = normalize(v);
+}
+
+CachedPower getCachedPower(int e)
+{
+  // smallest k with 10^k*2^e >= 2^ALPHA, 78913/2^18 approximates log10(2)
+  long f = ALPHA - e - 1;
+  long k = (f*78913L)/(1L << 18) + ((f > 0) ? 1 : 0);
+  int index = (-CACHED_POWER_DECIMAL_EXPONENT_MIN + k + (CACHED_POWER_DECIMAL_EXPONENT_STEP - 1))/CACHED_POWER_DECIMAL_EXPONENT_STEP;
+  CachedPower cached_power;
+  memcpy_P(&cached_power,&cached_powers[index],sizeof(cached_power));
+  return cached_power;
+}
+
+unsigned char findLargestPowerOfTen(uint32_t n,
+  uint32_t & power_of_ten)
+{
+  unsigned char digit_count = DoubleFormatter::FRACTION_DIGITS_MAX + 1;
+  while ((digit_count > 1) && (n < powers_of_ten[digit_count-1]))
+  {
+    --digit_count;
+  }
+  power_of_ten = powers_of_ten[digit_count-1];
+  return digit_count;
+}
+
+// moves the last digit toward the scaled value while it stays in the interval
+void roundLastDigit(char * digits,
+  int digit_count,
+  uint64_t distance,
+  uint64_t delta,
+  uint64_t rest,
+  uint64_t ten_k)
+{
+  while ((rest < distance) &&
+    ((delta - rest) >= ten_k) &&
+    (((rest + ten_k) < distance) || ((distance - rest) > (rest + ten_k - distance))))
+  {
+    --digits[digit_count-1];
+    rest += ten_k;
+  }
+}
+
+void generateDigits(char * digits,
+  int & digit_count,
+  int & decimal_exponent,
+  DiyFp m_minus,
+  DiyFp w,
+  DiyFp m_plus)
+{
+  uint64_t delta = subtract(m_plus,m_minus).f;
+  uint64_t distance = subtract(m_plus,w).f;
+  DiyFp one = {1ULL << -m_plus.e,m_plus.e};
+  uint32_t integer_part = (uint32_t)(m_plus.f >> -one.e);
+  uint64_t fraction_part = m_plus.f & (one.f - 1);
+
+  uint32_t power_of_ten;
+  unsigned char n = findLargestPowerOfTen(integer_part,power_of_ten);
+  while (n > 0)
+  {
+    digits[digit_count++] = '0' + (integer_part/power_of_ten);
+    integer_part %= power_of_ten;
+    --n;
+    uint64_t rest = ((uint64_t)integer_part << -one.e) + fraction_part;
+    if (rest <= delta)
+    {
+      decimal_exponent += n;
+      roundLastDigit(digits,digit_count,distance,delta,rest,(uint64_t)power_of_ten << -one.e);
+      return;
+    }
+    power_of_ten /= 10;
+  }
+
+  int m = 0;
+  while (true)
+  {
+    fraction_part *= 10;
+    digits[digit_count++] = '0' + (char)(fraction_part >> -one.e);
+    fraction_part &= one.f - 1;
+    ++m;
+    delta *= 10;
+    distance *= 10;
+    if (fraction_part <= delta)
+    {
+      break;
+    }
+  }
+  decimal_exponent -= m;
+  roundLastDigit(digits,digit_count,distance,delta,fraction_part,one.f);
+}
+}
+
+// public
+size_t DoubleFormatter::format(char * destination,
+  size_t size,
+  double value,
+  int digits)
+{
+  if (size == 0)
+  {
+    return 0;
+  }
+  char double_str[JsonStream::STRING_LENGTH_DOUBLE];
+  double_str[0] = '\0';
+  bool formatted = false;
+  if (!isnan(value) && !isinf(value))
+  {
+    bool negative = signbit(value);
+    double magnitude = fabs(value);
+    if (digits == SHORTEST)
+    {
+      writeShortest(double_str,negative,magnitude);
+      formatted = true;
+    }
+    else if ((digits >= 0) && (digits <= FRACTION_DIGITS_MAX) && (magnitude < fixed_magnitude_max))
+    {
+      unsigned long integer_part;
+      unsigned long fraction_part;
+      roundFixed(magnitude,digits,integer_part,fraction_part);
+      writeFixed(double_str,negative,integer_part,fraction_part,digits);
+      formatted = true;
+    }
+  }
+  if (!formatted)
+  {
+    if ((digits < 0) || (digits > FRACTION_DIGITS_MAX))
+    {
+      digits = JsonStream::DOUBLE_DIGITS_DEFAULT;
+    }
+    dtostrf(value,0,digits,double_str);
+  }
+  size_t length = strlen(double_str);
+  if (length >= size)
+  {
+    length = size - 1;
+  }
+  memcpy(destination,double_str,length);
+  destination[length] = '\0';
+  return length;
+}
+
+// private
+void DoubleFormatter::roundFixed(double magnitude,
+  unsigned char digits,
+  unsigned long & integer_part,
+  unsigned long & fraction_part)
+{
+  unsigned long scale = powers_of_ten[digits];
+  integer_part = (unsigned long)magnitude;
+  fraction_part = (unsigned long)((magnitude - integer_part)*scale + 0.5);
+  if (fraction_part >= scale)
+  {
+    fraction_part -= scale;
+    ++integer_part;
+  }
+}
+
+size_t DoubleFormatter::writeFixed(char * destination,
+  bool negative,
+  unsigned long integer_part,
+  unsigned long fraction_part,
+  unsigned char digits)
+{
+  char * position = destination;
+  if (negative && ((integer_part > 0) || (fraction_part > 0)))
+  {
+    *position++ = '-';
+  }
+  ultoa(integer_part,position,10);
+  position += strlen(position);
+  if (digits > 0)
+  {
+    *position++ = '.';
+    // fraction digits are written right to left so leading zeros are kept
+    for (unsigned char d=digits; d>0; --d)
+    {
+      position[d-1] = '0' + (fraction_part % 10);
+      fraction_part /= 10;
+    }
+    position += digits;
+  }
+  *position = '\0';
+  return position - destination;
+}
+
+// always written with a decimal point or an exponent so it reads back as a
+// double rather than an integer
+size_t DoubleFormatter::writeShortest(char * destination,
+  bool negative,
+  double magnitude)
+{
+  char * position = destination;
+  if (negative)
+  {
+    *position++ = '-';
+  }
+  if (magnitude == 0)
+  {
+    strcpy(position,"0.0");
+    return (position - destination) + 3;
+  }
+
+  char digits[SHORTEST_DIGIT_COUNT_MAX];
+  int digit_count = 0;
+  int decimal_exponent;
+  DiyFp w;
+  DiyFp w_minus;
+  DiyFp w_plus;
+  computeBoundaries(magnitude,w,w_minus,w_plus);
+  CachedPower cached_power = getCachedPower(w_plus.e);
+  DiyFp c = {cached_power.f,cached_power.e};
+  DiyFp scaled = multiply(w,c);
+  DiyFp scaled_minus = multiply(w_minus,c);
+  DiyFp scaled_plus = multiply(w_plus,c);
+  // shrink the interval by one unit on each side to stay inside it despite
+  // the rounding of the products
+  scaled_minus.f += 1;
+  scaled_plus.f -= 1;
+  decimal_exponent = -cached_power.k;
+  generateDigits(digits,digit_count,decimal_exponent,scaled_minus,scaled,scaled_plus);
+
+  // the value is digits times 10^decimal_exponent, with the decimal point
+  // after point_position digits
+  int point_position = digit_count + decimal_exponent;
+  if ((digit_count <= point_position) && (point_position <= DECIMAL_POINT_POSITION_MAX))
+  {
+    // 1234e2 -> 123400.0
+    memcpy(position,digits,digit_count);
+    position += digit_count;
+    for (int i=digit_count; i<point_position; ++i)
+    {
+      *position++ = '0';
+    }
+    *position++ = '.';
+    *position++ = '0';
+  }
+  else if ((0 < point_position) && (point_position <= DECIMAL_POINT_POSITION_MAX))
+  {
+    // 1234e-2 -> 12.34
+    memcpy(position,digits,point_position);
+    position += point_position;
+    *position++ = '.';
+    memcpy(position,digits + point_position,digit_count - point_position);
+    position += digit_count - point_position;
+  }
+  else if ((DECIMAL_POINT_POSITION_MIN <= point_position) && (point_position <= 0))
+  {
+    // 1234e-6 -> 0.001234
+    *position++ = '0';
+    *position++ = '.';
+    for (int i=point_position; i<0; ++i)
+    {
+      *position++ = '0';
+    }
+    memcpy(position,digits,digit_count);
+    position += digit_count;
+  }
+  else
+  {
+    // 1234e-10 -> 1.234e-7
+    *position++ = digits[0];
+    if (digit_count > 1)
+    {
+      *position++ = '.';
+      memcpy(position,digits + 1,digit_count - 1);
+      position += digit_count - 1;
+    }
+    *position++ = 'e';
+    int exponent = point_position - 1;
+    if (exponent < 0)
+    {
+      *position++ = '-';
+      exponent = -exponent;
+    }
+    ultoa(exponent,position,10);
+    position += strlen(position);
+  }
+  *position = '\0';
+  return position - destination;
+}
+
+}
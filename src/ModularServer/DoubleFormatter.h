@@ -0,0 +1,48 @@
+// ----------------------------------------------------------------------------
+// DoubleFormatter.h
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_DOUBLE_FORMATTER_H_
+#define _MODULAR_SERVER_DOUBLE_FORMATTER_H_
+#include <Arduino.h>
+#include <JsonStream.h>
+
+
+namespace modular_server
+{
+// Formats doubles with integer arithmetic instead of dtostrf. By default the
+// shortest digits that read back as the same double are written, found with
+// Grisu2, switching to an exponent for very large and very small magnitudes.
+// A digit count gives fixed precision instead. NaN, infinity and fixed
+// precision values outside the fixed point range fall back to dtostrf.
+class DoubleFormatter
+{
+public:
+  enum{SHORTEST=-1};
+  enum{FRACTION_DIGITS_MAX=9};
+
+  static size_t format(char * destination,
+    size_t size,
+    double value,
+    int digits=SHORTEST);
+
+private:
+  static void roundFixed(double magnitude,
+    unsigned char digits,
+    unsigned long & integer_part,
+    unsigned long & fraction_part);
+  static size_t writeFixed(char * destination,
+    bool negative,
+    unsigned long integer_part,
+    unsigned long fraction_part,
+    unsigned char digits);
+  static size_t writeShortest(char * destination,
+    bool negative,
+    double magnitude);
+};
+}
+
+#endif
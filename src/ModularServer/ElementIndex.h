@@ -0,0 +1,46 @@
+// ----------------------------------------------------------------------------
+// ElementIndex.h
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_ELEMENT_INDEX_H_
+#define _MODULAR_SERVER_ELEMENT_INDEX_H_
+#include <Arduino.h>
+#include <ConcatenatedArray.h>
+
+#include "Constants.h"
+
+
+namespace modular_server
+{
+// Flat array of pointers to the elements of a ConcatenatedArray so that
+// iteration and random access do not have to map each index to a sub-array,
+// falls back to the ConcatenatedArray when there are more than MAX_SIZE elements
+template <typename T,
+  size_t MAX_SIZE,
+  size_t ARRAY_COUNT_MAX>
+class ElementIndex
+{
+public:
+  ElementIndex();
+  void setElements(ConcatenatedArray<T,ARRAY_COUNT_MAX> & elements);
+  void rebuild();
+  void update();
+
+  T & operator[](size_t index);
+  T & back();
+  size_t size();
+  size_t max_size();
+
+private:
+  ConcatenatedArray<T,ARRAY_COUNT_MAX> * elements_ptr_;
+  T * element_ptrs_[MAX_SIZE];
+  size_t size_;
+  bool overflow_;
+};
+}
+#include "ElementIndexDefinitions.h"
+
+#endif
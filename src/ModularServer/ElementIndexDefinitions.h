@@ -0,0 +1,109 @@
+// ----------------------------------------------------------------------------
+// ElementIndexDefinitions.h
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_ELEMENT_INDEX_DEFINITIONS_H_
+#define _MODULAR_SERVER_ELEMENT_INDEX_DEFINITIONS_H_
+
+
+namespace modular_server
+{
+// public
+template <typename T,
+  size_t MAX_SIZE,
+  size_t ARRAY_COUNT_MAX>
+ElementIndex<T,MAX_SIZE,ARRAY_COUNT_MAX>::ElementIndex()
+{
+  elements_ptr_ = NULL;
+  size_ = 0;
+  overflow_ = false;
+}
+
+template <typename T,
+  size_t MAX_SIZE,
+  size_t ARRAY_COUNT_MAX>
+void ElementIndex<T,MAX_SIZE,ARRAY_COUNT_MAX>::setElements(ConcatenatedArray<T,ARRAY_COUNT_MAX> & elements)
+{
+  elements_ptr_ = &elements;
+  rebuild();
+}
+
+template <typename T,
+  size_t MAX_SIZE,
+  size_t ARRAY_COUNT_MAX>
+void ElementIndex<T,MAX_SIZE,ARRAY_COUNT_MAX>::rebuild()
+{
+  size_ = 0;
+  overflow_ = false;
+  update();
+}
+
+template <typename T,
+  size_t MAX_SIZE,
+  size_t ARRAY_COUNT_MAX>
+void ElementIndex<T,MAX_SIZE,ARRAY_COUNT_MAX>::update()
+{
+  if (!elements_ptr_)
+  {
+    return;
+  }
+  size_t elements_size = elements_ptr_->size();
+  if (elements_size < size_)
+  {
+    size_ = 0;
+  }
+  if (elements_size > MAX_SIZE)
+  {
+    overflow_ = true;
+    size_ = elements_size;
+    return;
+  }
+  overflow_ = false;
+  while (size_ < elements_size)
+  {
+    element_ptrs_[size_] = &((*elements_ptr_)[size_]);
+    ++size_;
+  }
+}
+
+template <typename T,
+  size_t MAX_SIZE,
+  size_t ARRAY_COUNT_MAX>
+T & ElementIndex<T,MAX_SIZE,ARRAY_COUNT_MAX>::operator[](size_t index)
+{
+  if (overflow_)
+  {
+    return (*elements_ptr_)[index];
+  }
+  return *element_ptrs_[index];
+}
+
+template <typename T,
+  size_t MAX_SIZE,
+  size_t ARRAY_COUNT_MAX>
+T & ElementIndex<T,MAX_SIZE,ARRAY_COUNT_MAX>::back()
+{
+  return (*this)[size_ - 1];
+}
+
+template <typename T,
+  size_t MAX_SIZE,
+  size_t ARRAY_COUNT_MAX>
+size_t ElementIndex<T,MAX_SIZE,ARRAY_COUNT_MAX>::size()
+{
+  return size_;
+}
+
+template <typename T,
+  size_t MAX_SIZE,
+  size_t ARRAY_COUNT_MAX>
+size_t ElementIndex<T,MAX_SIZE,ARRAY_COUNT_MAX>::max_size()
+{
+  return elements_ptr_->max_size();
+}
+
+}
+#endif
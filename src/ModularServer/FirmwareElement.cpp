@@ -14,6 +14,7 @@ namespace modular_server
 FirmwareElement::FirmwareElement()
 {
   setFirmwareName(constants::empty_constant_string);
+  setFirmwareIndex(0);
 }
 
 void FirmwareElement::setFirmwareName(const ConstantString & firmware_name)
@@ -21,16 +22,23 @@ void FirmwareElement::setFirmwareName(const ConstantString & firmware_name)
   firmware_name_ptr_ = &firmware_name;
 }
 
+void FirmwareElement::setFirmwareIndex(size_t firmware_index)
+{
+  firmware_index_ = firmware_index;
+}
+
+bool FirmwareElement::firmwareInMask(constants::FirmwareMask firmware_mask)
+{
+  return (firmware_mask & ((constants::FirmwareMask)1 << firmware_index_));
+}
+
 bool FirmwareElement::compareFirmwareName(const char * firmware_name_to_compare)
 {
   if (constants::all_constant_string == firmware_name_to_compare)
   {
     return true;
   }
-  char firmware_name_str[firmware_name_ptr_->length()+1];
-  firmware_name_str[0] = '\0';
-  firmware_name_ptr_->copy(firmware_name_str);
-  return (strcmp(firmware_name_str,firmware_name_to_compare) == 0);
+  return (*firmware_name_ptr_ == firmware_name_to_compare);
 }
 
 bool FirmwareElement::compareFirmwareName(const ConstantString & firmware_name_to_compare)
@@ -49,16 +57,7 @@ bool FirmwareElement::compareFirmwareName(const ConstantString * firmware_name_t
 
 bool FirmwareElement::compareFirmwareName(constants::SubsetMemberType firmware_name_to_compare)
 {
-  char firmware_name_to_compare_str[firmware_name_to_compare.cs_ptr->length() + 1];
-  firmware_name_to_compare_str[0] = '\0';
-  firmware_name_to_compare.cs_ptr->copy(firmware_name_to_compare_str);
-
-  char firmware_name_str[firmware_name_ptr_->length()+1];
-  firmware_name_str[0] = '\0';
-  firmware_name_ptr_->copy(firmware_name_str);
-
-
-  return (strcmp(firmware_name_str,firmware_name_to_compare_str) == 0);
+  return (*firmware_name_ptr_ == *firmware_name_to_compare.cs_ptr);
 }
 
 template <>
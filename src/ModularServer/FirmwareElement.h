@@ -23,6 +23,8 @@ public:
   FirmwareElement();
 
   void setFirmwareName(const ConstantString & firmware_name);
+  void setFirmwareIndex(size_t firmware_index);
+  bool firmwareInMask(constants::FirmwareMask firmware_mask);
   bool compareFirmwareName(const char * firmware_name_to_compare);
   bool compareFirmwareName(const ConstantString & firmware_name_to_compare);
   bool compareFirmwareName(const ConstantString * firmware_name_to_compare_ptr);
@@ -36,6 +38,7 @@ public:
 
 private:
   const ConstantString * firmware_name_ptr_;
+  size_t firmware_index_;
 
 };
 }
@@ -0,0 +1,25 @@
+// ----------------------------------------------------------------------------
+// FormattedDouble.cpp
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#include "FormattedDouble.h"
+
+
+namespace modular_server
+{
+// public
+FormattedDouble::FormattedDouble(double value,
+  int digits)
+{
+  DoubleFormatter::format(value_str_,JsonStream::STRING_LENGTH_DOUBLE,value,digits);
+}
+
+size_t FormattedDouble::printTo(Print & print) const
+{
+  return print.print(value_str_);
+}
+
+}
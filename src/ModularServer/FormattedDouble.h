@@ -0,0 +1,34 @@
+// ----------------------------------------------------------------------------
+// FormattedDouble.h
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_FORMATTED_DOUBLE_H_
+#define _MODULAR_SERVER_FORMATTED_DOUBLE_H_
+#include <Arduino.h>
+#include <JsonStream.h>
+
+#include "DoubleFormatter.h"
+
+
+namespace modular_server
+{
+// A double formatted by DoubleFormatter that prints as a bare number token, so
+// a json stream writes it the way it writes an integer, with its own key and
+// separators, rather than through dtostrf
+class FormattedDouble : public Printable
+{
+public:
+  FormattedDouble(double value,
+    int digits=DoubleFormatter::SHORTEST);
+
+  virtual size_t printTo(Print & print) const;
+
+private:
+  char value_str_[JsonStream::STRING_LENGTH_DOUBLE];
+};
+}
+
+#endif
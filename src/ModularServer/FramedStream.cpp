@@ -0,0 +1,184 @@
+// ----------------------------------------------------------------------------
+// FramedStream.cpp
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#include "FramedStream.h"
+
+
+namespace modular_server
+{
+// public
+FramedStream::FramedStream()
+{
+  stream_ptr_ = NULL;
+  arena_ptr_ = NULL;
+  frame_ptr_ = NULL;
+  frame_size_ = 0;
+  frame_capacity_ = 0;
+  chunking_ = true;
+  chunk_size_ = 0;
+}
+
+void FramedStream::setStream(Stream & stream)
+{
+  stream_ptr_ = &stream;
+}
+
+void FramedStream::setArena(Arena & arena)
+{
+  arena_ptr_ = &arena;
+  arena.attachTailReleaseFunctor(makeFunctor((Functor0 *)0,*this,&FramedStream::releaseFrameHandler));
+}
+
+void FramedStream::beginFrame()
+{
+  frame_ptr_ = NULL;
+  frame_size_ = 0;
+  frame_capacity_ = 0;
+  chunking_ = (arena_ptr_ == NULL);
+  chunk_size_ = 0;
+}
+
+void FramedStream::endFrame()
+{
+  writeFrame();
+  writeChunk();
+  if (stream_ptr_)
+  {
+    writeFrameEnd(*stream_ptr_);
+  }
+}
+
+void FramedStream::flushChunk()
+{
+  writeFrame();
+  writeChunk();
+}
+
+int FramedStream::available()
+{
+  if (!stream_ptr_)
+  {
+    return 0;
+  }
+  return stream_ptr_->available();
+}
+
+int FramedStream::read()
+{
+  if (!stream_ptr_)
+  {
+    return -1;
+  }
+  return stream_ptr_->read();
+}
+
+int FramedStream::peek()
+{
+  if (!stream_ptr_)
+  {
+    return -1;
+  }
+  return stream_ptr_->peek();
+}
+
+size_t FramedStream::write(uint8_t byte)
+{
+  if (!chunking_ && ((frame_size_ < frame_capacity_) || growFrame()))
+  {
+    frame_ptr_[frame_size_++] = byte;
+    return 1;
+  }
+  if (chunk_size_ == constants::RESPONSE_FRAME_CHUNK_SIZE)
+  {
+    writeChunk();
+  }
+  chunk_[chunk_size_++] = byte;
+  return 1;
+}
+
+void FramedStream::writeChunk(Stream & stream,
+  const uint8_t * chunk,
+  size_t chunk_size)
+{
+  if (chunk_size == 0)
+  {
+    return;
+  }
+  stream.print((long)chunk_size);
+  stream.write('\n');
+  stream.write(chunk,chunk_size);
+}
+
+void FramedStream::writeFrameEnd(Stream & stream)
+{
+  stream.write('0');
+  stream.write('\n');
+}
+
+// private
+void FramedStream::writeChunk()
+{
+  if (stream_ptr_)
+  {
+    writeChunk(*stream_ptr_,chunk_,chunk_size_);
+  }
+  chunk_size_ = 0;
+}
+
+bool FramedStream::growFrame()
+{
+  // doubling keeps the total bytes moved by growTail proportional to the
+  // response length
+  size_t frame_capacity = 2*frame_capacity_;
+  if (frame_capacity < constants::RESPONSE_FRAME_CHUNK_SIZE)
+  {
+    frame_capacity = constants::RESPONSE_FRAME_CHUNK_SIZE;
+  }
+  size_t frame_capacity_max = arena_ptr_->getSize() - arena_ptr_->getUsed();
+  if (frame_capacity > frame_capacity_max)
+  {
+    frame_capacity = frame_capacity_max;
+  }
+  uint8_t * frame_ptr = NULL;
+  if (frame_capacity > frame_capacity_)
+  {
+    frame_ptr = (uint8_t *)arena_ptr_->growTail(frame_capacity);
+  }
+  if (frame_ptr == NULL)
+  {
+    // the arena is full, what is collected so far becomes the first chunk
+    writeFrame();
+    return false;
+  }
+  frame_ptr_ = frame_ptr;
+  frame_capacity_ = frame_capacity;
+  return true;
+}
+
+void FramedStream::writeFrame()
+{
+  if (chunking_)
+  {
+    return;
+  }
+  chunking_ = true;
+  if (stream_ptr_)
+  {
+    writeChunk(*stream_ptr_,frame_ptr_,frame_size_);
+  }
+  frame_size_ = 0;
+  frame_capacity_ = 0;
+  arena_ptr_->releaseTail();
+}
+
+// Handlers
+void FramedStream::releaseFrameHandler()
+{
+  writeFrame();
+}
+
+}
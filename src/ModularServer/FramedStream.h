@@ -0,0 +1,64 @@
+// ----------------------------------------------------------------------------
+// FramedStream.h
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_FRAMED_STREAM_H_
+#define _MODULAR_SERVER_FRAMED_STREAM_H_
+#include <Arduino.h>
+
+#include "Constants.h"
+#include "Arena.h"
+
+
+namespace modular_server
+{
+// Wraps a server stream and writes each response as length prefixed chunks,
+// every chunk being its byte count in decimal, a newline and the bytes
+// themselves, with an empty chunk ending the response. The response is
+// collected in the arena tail so it is normally sent as a single chunk holding
+// the whole response, only falling back to fixed size chunks once the arena
+// needs the tail back.
+class FramedStream : public Stream
+{
+public:
+  FramedStream();
+
+  void setStream(Stream & stream);
+  void setArena(Arena & arena);
+  void beginFrame();
+  void endFrame();
+  void flushChunk();
+
+  virtual int available();
+  virtual int read();
+  virtual int peek();
+  virtual size_t write(uint8_t byte);
+  using Print::write;
+
+  static void writeChunk(Stream & stream,
+    const uint8_t * chunk,
+    size_t chunk_size);
+  static void writeFrameEnd(Stream & stream);
+
+private:
+  Stream * stream_ptr_;
+  Arena * arena_ptr_;
+  uint8_t * frame_ptr_;
+  size_t frame_size_;
+  size_t frame_capacity_;
+  bool chunking_;
+  uint8_t chunk_[constants::RESPONSE_FRAME_CHUNK_SIZE];
+  size_t chunk_size_;
+  void writeChunk();
+  bool growFrame();
+  void writeFrame();
+
+  // Handlers
+  void releaseFrameHandler();
+};
+}
+
+#endif
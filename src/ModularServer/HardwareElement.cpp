@@ -27,10 +27,7 @@ bool HardwareElement::compareHardwareName(const char * hardware_name_to_compare)
   {
     return true;
   }
-  char hardware_name_str[hardware_name_ptr_->length()+1];
-  hardware_name_str[0] = '\0';
-  hardware_name_ptr_->copy(hardware_name_str);
-  return (strcmp(hardware_name_str,hardware_name_to_compare) == 0);
+  return (*hardware_name_ptr_ == hardware_name_to_compare);
 }
 
 bool HardwareElement::compareHardwareName(const ConstantString & hardware_name_to_compare)
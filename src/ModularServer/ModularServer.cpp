@@ -68,6 +68,11 @@ Parameter & ModularServer::createParameter(const ConstantString & parameter_name
   return server_.createParameter(parameter_name);
 }
 
+Parameter & ModularServer::createParameter(const ParameterInfo & parameter_info)
+{
+  return server_.createParameter(parameter_info);
+}
+
 Parameter & ModularServer::parameter(const ConstantString & parameter_name)
 {
   return server_.parameter(parameter_name);
@@ -85,6 +90,11 @@ Function & ModularServer::createFunction(const ConstantString & function_name)
   return server_.createFunction(function_name);
 }
 
+Function & ModularServer::createFunction(const FunctionInfo & function_info)
+{
+  return server_.createFunction(function_info);
+}
+
 Function & ModularServer::function(const ConstantString & function_name)
 {
   return server_.function(function_name);
@@ -102,6 +112,11 @@ Callback & ModularServer::createCallback(const ConstantString & callback_name)
   return server_.createCallback(callback_name);
 }
 
+Callback & ModularServer::createCallback(const CallbackInfo & callback_info)
+{
+  return server_.createCallback(callback_info);
+}
+
 Callback & ModularServer::callback(const ConstantString & callback_name)
 {
   return server_.callback(callback_name);
@@ -128,4 +143,20 @@ void ModularServer::handleServerRequests()
 {
   server_.handleRequest();
 }
+
+// Timing Monitor
+void ModularServer::enableTimingMonitor(unsigned long loop_period_deadline)
+{
+  server_.enableTimingMonitor(loop_period_deadline);
+}
+
+void ModularServer::disableTimingMonitor()
+{
+  server_.disableTimingMonitor();
+}
+
+void ModularServer::resetTimingMonitor()
+{
+  server_.resetTimingMonitor();
+}
 }
@@ -60,6 +60,12 @@ Property & ModularServer::createProperty(const ConstantString & property_name,
   return server_.createProperty(property_name,default_value);
 }
 
+template <size_t N>
+void ModularServer::setupProperties(const PropertyInfo (&property_info_table)[N])
+{
+  server_.setupProperties(property_info_table);
+}
+
 template <typename T>
 void ModularServer::setPropertiesToDefaults(T & firmware_name_array)
 {
@@ -67,10 +73,25 @@ void ModularServer::setPropertiesToDefaults(T & firmware_name_array)
 }
 
 // Parameters
+template <size_t N>
+void ModularServer::createParameters(const ParameterInfo (&parameter_info_table)[N])
+{
+  server_.createParameters(parameter_info_table);
+}
 
 // Functions
+template <size_t N>
+void ModularServer::createFunctions(const FunctionInfo (&function_info_table)[N])
+{
+  server_.createFunctions(function_info_table);
+}
 
 // Callbacks
+template <size_t N>
+void ModularServer::createCallbacks(const CallbackInfo (&callback_info_table)[N])
+{
+  server_.createCallbacks(callback_info_table);
+}
 
 // Response
 
@@ -0,0 +1,44 @@
+// ----------------------------------------------------------------------------
+// NameHasher.cpp
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#include "NameHasher.h"
+#include <ctype.h>
+
+
+namespace modular_server
+{
+// public
+NameHasher::NameHasher()
+{
+  hash_ = 0;
+}
+
+long NameHasher::hash(const char * name)
+{
+  hash_ = 2166136261UL;
+  while (*name)
+  {
+    write((unsigned char)*name++);
+  }
+  return (long)hash_;
+}
+
+long NameHasher::hash(const ConstantString & name)
+{
+  hash_ = 2166136261UL;
+  print(name);
+  return (long)hash_;
+}
+
+size_t NameHasher::write(uint8_t byte)
+{
+  hash_ ^= (unsigned char)tolower(byte);
+  hash_ *= 16777619UL;
+  return 1;
+}
+
+}
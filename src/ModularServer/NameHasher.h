@@ -0,0 +1,34 @@
+// ----------------------------------------------------------------------------
+// NameHasher.h
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_NAME_HASHER_H_
+#define _MODULAR_SERVER_NAME_HASHER_H_
+#include <Arduino.h>
+#include <ConstantVariable.h>
+
+
+namespace modular_server
+{
+// Hashes a name ignoring case with FNV-1a, one character at a time, so a
+// constant string is hashed as it is printed without being copied out of flash
+class NameHasher : public Print
+{
+public:
+  NameHasher();
+
+  long hash(const char * name);
+  long hash(const ConstantString & name);
+
+  virtual size_t write(uint8_t byte);
+  using Print::write;
+
+private:
+  unsigned long hash_;
+};
+}
+
+#endif
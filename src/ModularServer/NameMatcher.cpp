@@ -0,0 +1,51 @@
+// ----------------------------------------------------------------------------
+// NameMatcher.cpp
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#include "NameMatcher.h"
+#include <ctype.h>
+
+
+namespace modular_server
+{
+// public
+NameMatcher::NameMatcher(const char * name)
+{
+  name_ = name;
+  position_ = 0;
+  matching_ = false;
+}
+
+bool NameMatcher::matches(const ConstantString & constant_string)
+{
+  if ((name_ == NULL) || (strlen(name_) != constant_string.length()))
+  {
+    return false;
+  }
+  position_ = 0;
+  matching_ = true;
+  print(constant_string);
+  return (matching_ && (name_[position_] == '\0'));
+}
+
+size_t NameMatcher::write(uint8_t byte)
+{
+  if (matching_)
+  {
+    if ((name_[position_] != '\0') &&
+      (tolower(byte) == tolower((unsigned char)name_[position_])))
+    {
+      ++position_;
+    }
+    else
+    {
+      matching_ = false;
+    }
+  }
+  return 1;
+}
+
+}
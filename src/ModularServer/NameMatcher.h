@@ -0,0 +1,36 @@
+// ----------------------------------------------------------------------------
+// NameMatcher.h
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_NAME_MATCHER_H_
+#define _MODULAR_SERVER_NAME_MATCHER_H_
+#include <Arduino.h>
+#include <ConstantVariable.h>
+
+
+namespace modular_server
+{
+// Compares a constant string to a name ignoring case, one character at a time
+// as the constant string is printed to it, so the constant string is never
+// copied out of flash
+class NameMatcher : public Print
+{
+public:
+  NameMatcher(const char * name);
+
+  bool matches(const ConstantString & constant_string);
+
+  virtual size_t write(uint8_t byte);
+  using Print::write;
+
+private:
+  const char * name_;
+  size_t position_;
+  bool matching_;
+};
+}
+
+#endif
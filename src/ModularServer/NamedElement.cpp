@@ -14,6 +14,7 @@ namespace modular_server
 NamedElement::NamedElement()
 {
   setName(constants::empty_constant_string);
+  context_ptr_ = NULL;
 }
 
 void NamedElement::setName(const ConstantString & name)
@@ -23,10 +24,8 @@ void NamedElement::setName(const ConstantString & name)
 
 bool NamedElement::compareName(const char * name_to_compare)
 {
-  char name_str[name_ptr_->length()+1];
-  name_str[0] = '\0';
-  name_ptr_->copy(name_str);
-  return String(name_str).equalsIgnoreCase(name_to_compare);
+  NameMatcher name_matcher(name_to_compare);
+  return name_matcher.matches(*name_ptr_);
 }
 
 bool NamedElement::compareName(const ConstantString & name_to_compare)
@@ -39,4 +38,9 @@ const ConstantString & NamedElement::getName()
   return *name_ptr_;
 }
 
+void NamedElement::setContext(ServerContext & context)
+{
+  context_ptr_ = &context;
+}
+
 }
@@ -11,6 +11,8 @@
 #include <ArduinoJson.h>
 
 #include "Constants.h"
+#include "NameMatcher.h"
+#include "ServerContext.h"
 
 
 namespace modular_server
@@ -24,10 +26,16 @@ public:
   bool compareName(const char * name_to_compare);
   bool compareName(const ConstantString & name_to_compare);
   const ConstantString & getName();
+  void setContext(ServerContext & context);
+
+protected:
+  ServerContext * context_ptr_;
 
 private:
   const ConstantString * name_ptr_;
 
+  friend class Server;
+
 };
 }
 
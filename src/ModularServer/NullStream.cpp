@@ -0,0 +1,34 @@
+// ----------------------------------------------------------------------------
+// NullStream.cpp
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#include "NullStream.h"
+
+
+namespace modular_server
+{
+// public
+int NullStream::available()
+{
+  return 0;
+}
+
+int NullStream::read()
+{
+  return -1;
+}
+
+int NullStream::peek()
+{
+  return -1;
+}
+
+size_t NullStream::write(uint8_t byte)
+{
+  return 1;
+}
+
+}
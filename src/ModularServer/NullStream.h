@@ -0,0 +1,27 @@
+// ----------------------------------------------------------------------------
+// NullStream.h
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_NULL_STREAM_H_
+#define _MODULAR_SERVER_NULL_STREAM_H_
+#include <Arduino.h>
+
+
+namespace modular_server
+{
+// Stream that discards everything written to it and never has bytes available
+class NullStream : public Stream
+{
+public:
+  virtual int available();
+  virtual int read();
+  virtual int peek();
+  virtual size_t write(uint8_t byte);
+  using Print::write;
+};
+}
+
+#endif
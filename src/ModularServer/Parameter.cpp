@@ -10,8 +10,6 @@
 
 namespace modular_server
 {
-Functor1wRet<const ConstantString &,ArduinoJson::JsonVariant> Parameter::get_value_functor_;
-
 // public
 Parameter::Parameter()
 {
@@ -28,6 +26,7 @@ void Parameter::setTypeLong()
   {
     array_element_type_ = JsonStream::LONG_TYPE;
   }
+  updateValidator();
 }
 
 void Parameter::setTypeDouble()
@@ -40,6 +39,7 @@ void Parameter::setTypeDouble()
   {
     array_element_type_ = JsonStream::DOUBLE_TYPE;
   }
+  updateValidator();
 }
 
 void Parameter::setTypeBool()
@@ -52,6 +52,7 @@ void Parameter::setTypeBool()
   {
     array_element_type_ = JsonStream::BOOL_TYPE;
   }
+  updateValidator();
 }
 
 void Parameter::setTypeString()
@@ -65,6 +66,7 @@ void Parameter::setTypeString()
   {
     array_element_type_ = JsonStream::STRING_TYPE;
   }
+  updateValidator();
 }
 
 void Parameter::setTypeObject()
@@ -77,6 +79,7 @@ void Parameter::setTypeObject()
   {
     array_element_type_ = JsonStream::OBJECT_TYPE;
   }
+  updateValidator();
 }
 
 void Parameter::setTypeArray()
@@ -86,6 +89,7 @@ void Parameter::setTypeArray()
     array_element_type_ = type_;
     type_ = JsonStream::ARRAY_TYPE;
   }
+  updateValidator();
 }
 
 void Parameter::setTypeAny()
@@ -98,6 +102,7 @@ void Parameter::setTypeAny()
   {
     array_element_type_ = JsonStream::ANY_TYPE;
   }
+  updateValidator();
 }
 
 void Parameter::setType(JsonStream::JsonTypes type)
@@ -110,6 +115,7 @@ void Parameter::setType(JsonStream::JsonTypes type)
   {
     array_element_type_ = type;
   }
+  updateValidator();
 }
 
 void Parameter::setUnits(const ConstantString & units)
@@ -124,6 +130,7 @@ void Parameter::setRange(double min,
   max_.d = max;
   setTypeDouble();
   range_is_set_ = true;
+  updateValidator();
 }
 
 void Parameter::setRange(float min,
@@ -133,6 +140,7 @@ void Parameter::setRange(float min,
   max_.d = (double)max;
   setTypeDouble();
   range_is_set_ = true;
+  updateValidator();
 }
 
 void Parameter::setRange(constants::NumberType min,
@@ -141,6 +149,7 @@ void Parameter::setRange(constants::NumberType min,
   min_ = min;
   max_ = max;
   range_is_set_ = true;
+  updateValidator();
 
   if ((array_length_range_is_set_) && (type_ == JsonStream::LONG_TYPE))
   {
@@ -159,6 +168,7 @@ void Parameter::setRange(constants::NumberType min,
 void Parameter::removeRange()
 {
   range_is_set_ = false;
+  updateValidator();
 }
 
 void Parameter::setArrayLengthRange(size_t array_length_min,
@@ -207,6 +217,8 @@ void Parameter::setSubset(constants::SubsetMemberType * subset,
 {
   subset_.setStorage(subset,max_size,size);
   subset_is_set_ = true;
+  updateValidator();
+  updateSubsetIndex();
 
   if (array_length_range_is_set_)
   {
@@ -226,6 +238,8 @@ void Parameter::setSubset(Vector<constants::SubsetMemberType> & subset)
 {
   subset_ = subset;
   subset_is_set_ = true;
+  updateValidator();
+  updateSubsetIndex();
 
   if (array_length_range_is_set_)
   {
@@ -246,12 +260,15 @@ void Parameter::addValueToSubset(constants::SubsetMemberType & value)
   if (subset_is_set_)
   {
     subset_.push_back(value);
+    updateSubsetIndex();
   }
 }
 
 void Parameter::removeSubset()
 {
   subset_is_set_ = false;
+  updateValidator();
+  updateSubsetIndex();
 }
 
 size_t Parameter::getSubsetSize()
@@ -264,6 +281,14 @@ size_t Parameter::getSubsetMaxSize()
   return subset_.max_size();
 }
 
+void Parameter::setSubsetIndexStorage(constants::SubsetIndexEntry * subset_index,
+  size_t max_size)
+{
+  subset_index_ptr_ = subset_index;
+  subset_index_max_size_ = max_size;
+  updateSubsetIndex();
+}
+
 template <>
 bool Parameter::getValue<long>(long & value)
 {
@@ -272,7 +297,7 @@ bool Parameter::getValue<long>(long & value)
     (getType() == JsonStream::BOOL_TYPE) ||
     (getType() == JsonStream::ANY_TYPE))
   {
-    long v = get_value_functor_(getName());
+    long v = context_ptr_->get_parameter_value_functor(getName());
     value = v;
     return true;
   }
@@ -287,7 +312,7 @@ bool Parameter::getValue<double>(double & value)
     (getType() == JsonStream::BOOL_TYPE) ||
     (getType() == JsonStream::ANY_TYPE))
   {
-    double v = get_value_functor_(getName());
+    double v = context_ptr_->get_parameter_value_functor(getName());
     value = v;
     return true;
   }
@@ -302,7 +327,7 @@ bool Parameter::getValue<float>(float & value)
     (getType() == JsonStream::BOOL_TYPE) ||
     (getType() == JsonStream::ANY_TYPE))
   {
-    double v = get_value_functor_(getName());
+    double v = context_ptr_->get_parameter_value_functor(getName());
     value = v;
     return true;
   }
@@ -317,7 +342,7 @@ bool Parameter::getValue<bool>(bool & value)
     (getType() == JsonStream::BOOL_TYPE) ||
     (getType() == JsonStream::ANY_TYPE))
   {
-    bool v = get_value_functor_(getName());
+    bool v = context_ptr_->get_parameter_value_functor(getName());
     value = v;
     return true;
   }
@@ -331,7 +356,7 @@ bool Parameter::getValue(const char * & value)
     value = NULL;
     return false;
   }
-  value = get_value_functor_(getName());
+  value = context_ptr_->get_parameter_value_functor(getName());
   return true;
 }
 
@@ -341,7 +366,7 @@ bool Parameter::getValue(ArduinoJson::JsonArray & value)
   {
     return false;
   }
-  value = get_value_functor_(getName());
+  value = context_ptr_->get_parameter_value_functor(getName());
   return true;
 }
 
@@ -351,7 +376,7 @@ bool Parameter::getValue(ArduinoJson::JsonObject & value)
   {
     return false;
   }
-  value = get_value_functor_(getName());
+  value = context_ptr_->get_parameter_value_functor(getName());
   return true;
 }
 
@@ -362,7 +387,7 @@ bool Parameter::getValue(const ConstantString * & value)
     value = NULL;
     return false;
   }
-  const char * string_value = get_value_functor_(getName());
+  const char * string_value = context_ptr_->get_parameter_value_functor(getName());
   int subset_value_index = findSubsetValueIndex(string_value);
   if (subset_value_index < 0)
   {
@@ -395,6 +420,11 @@ Parameter::Parameter(const ConstantString & name)
   setup(name);
 }
 
+Parameter::Parameter(const constants::ParameterInfo & parameter_info)
+{
+  setup(parameter_info);
+}
+
 void Parameter::setup(const ConstantString & name)
 {
   setName(name);
@@ -404,6 +434,37 @@ void Parameter::setup(const ConstantString & name)
   range_is_set_ = false;
   array_length_range_is_set_ = false;
   subset_is_set_ = false;
+  subset_index_ptr_ = NULL;
+  subset_index_max_size_ = 0;
+  subset_index_size_ = 0;
+  subset_index_keys_are_hashes_ = false;
+  updateValidator();
+}
+
+void Parameter::setup(const constants::ParameterInfo & parameter_info)
+{
+  setup(*parameter_info.name_ptr);
+  if (parameter_info.units_ptr)
+  {
+    setUnits(*parameter_info.units_ptr);
+  }
+  type_ = parameter_info.type;
+  array_element_type_ = parameter_info.array_element_type;
+  updateValidator();
+  if (parameter_info.subset_ptr)
+  {
+    setSubset(parameter_info.subset_ptr,
+      parameter_info.subset_size,
+      parameter_info.subset_size);
+  }
+  if (parameter_info.range_is_set)
+  {
+    setRange(parameter_info.min,parameter_info.max);
+  }
+  if (parameter_info.array_length_range_is_set)
+  {
+    setArrayLengthRange(parameter_info.array_length_min,parameter_info.array_length_max);
+  }
 }
 
 const ConstantString & Parameter::getUnits()
@@ -456,6 +517,41 @@ bool Parameter::valueInRange(float value)
   return in_range;
 }
 
+bool Parameter::valuesInRange(const long * values,
+  size_t value_count)
+{
+  if (!rangeIsSet())
+  {
+    return true;
+  }
+  long min = getRangeMin().l;
+  long max = getRangeMax().l;
+  // count instead of branching on each value so the loop can be vectorized
+  size_t out_of_range_count = 0;
+  for (size_t i=0; i<value_count; ++i)
+  {
+    out_of_range_count += (values[i] < min) | (values[i] > max);
+  }
+  return (out_of_range_count == 0);
+}
+
+bool Parameter::valuesInRange(const double * values,
+  size_t value_count)
+{
+  if (!rangeIsSet())
+  {
+    return true;
+  }
+  double min = getRangeMin().d - constants::epsilon;
+  double max = getRangeMax().d + constants::epsilon;
+  size_t out_of_range_count = 0;
+  for (size_t i=0; i<value_count; ++i)
+  {
+    out_of_range_count += (values[i] < min) | (values[i] > max);
+  }
+  return (out_of_range_count == 0);
+}
+
 const constants::NumberType & Parameter::getRangeMin()
 {
   return min_;
@@ -504,7 +600,15 @@ bool Parameter::subsetIsSet()
 int Parameter::findSubsetValueIndex(long value)
 {
   int value_index = -1;
-  if (subsetIsSet())
+  if (subsetIsSet() && (subset_index_size_ > 0) && !subset_index_keys_are_hashes_)
+  {
+    size_t position = findSubsetIndexPosition(value);
+    if ((position < subset_index_size_) && (subset_index_ptr_[position].key == value))
+    {
+      value_index = subset_index_ptr_[position].member_index;
+    }
+  }
+  else if (subsetIsSet())
   {
     for (size_t i=0; i<subset_.size(); ++i)
     {
@@ -521,7 +625,23 @@ int Parameter::findSubsetValueIndex(long value)
 int Parameter::findSubsetValueIndex(const char * value)
 {
   int value_index = -1;
-  if (subsetIsSet())
+  if (subsetIsSet() && (subset_index_size_ > 0) && subset_index_keys_are_hashes_)
+  {
+    long key = hashSubsetString(value);
+    // entries with equal hashes are adjacent, compare strings to resolve collisions
+    for (size_t position=findSubsetIndexPosition(key);
+         (position < subset_index_size_) && (subset_index_ptr_[position].key == key);
+         ++position)
+    {
+      size_t member_index = subset_index_ptr_[position].member_index;
+      if (value == *subset_[member_index].cs_ptr)
+      {
+        value_index = member_index;
+        break;
+      }
+    }
+  }
+  else if (subsetIsSet())
   {
     for (size_t i=0; i<subset_.size(); ++i)
     {
@@ -585,11 +705,295 @@ bool Parameter::valueInSubset(const ConstantString * value)
   return in_subset;
 }
 
+bool Parameter::valuesInSubset(const long * values,
+  size_t value_count)
+{
+  if (!subsetIsSet())
+  {
+    return true;
+  }
+  for (size_t i=0; i<value_count; ++i)
+  {
+    if (findSubsetValueIndex(values[i]) < 0)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Parameter::valuesInSubset(const double * values,
+  size_t value_count)
+{
+  // subsets only hold long and string values
+  return true;
+}
+
 Vector<constants::SubsetMemberType> & Parameter::getSubset()
 {
   return subset_;
 }
 
+void Parameter::updateSubsetIndex()
+{
+  subset_index_size_ = 0;
+  if (!subset_is_set_ ||
+    (subset_index_ptr_ == NULL) ||
+    (subset_.size() < constants::SUBSET_INDEX_SIZE_MIN) ||
+    (subset_.size() > subset_index_max_size_))
+  {
+    return;
+  }
+  JsonStream::JsonTypes subset_type = type_;
+  if (subset_type == JsonStream::ARRAY_TYPE)
+  {
+    subset_type = array_element_type_;
+  }
+  subset_index_keys_are_hashes_ = (subset_type == JsonStream::STRING_TYPE);
+  if (subset_index_keys_are_hashes_ &&
+    ((context_ptr_ == NULL) || (context_ptr_->arena_ptr == NULL)))
+  {
+    return;
+  }
+  for (size_t i=0; i<subset_.size(); ++i)
+  {
+    long key;
+    if (subset_index_keys_are_hashes_)
+    {
+      Arena & arena = *(context_ptr_->arena_ptr);
+      size_t mark = arena.getMark();
+      char * member_str = arena.allocateString(*subset_[i].cs_ptr);
+      if (member_str == NULL)
+      {
+        arena.rewind(mark);
+        subset_index_size_ = 0;
+        return;
+      }
+      key = hashSubsetString(member_str);
+      arena.rewind(mark);
+    }
+    else
+    {
+      key = subset_[i].l;
+    }
+    // insertion sort, the index is only rebuilt when the subset changes
+    size_t position = subset_index_size_;
+    while ((position > 0) && (subset_index_ptr_[position-1].key > key))
+    {
+      subset_index_ptr_[position] = subset_index_ptr_[position-1];
+      --position;
+    }
+    subset_index_ptr_[position].key = key;
+    subset_index_ptr_[position].member_index = i;
+    ++subset_index_size_;
+  }
+}
+
+size_t Parameter::findSubsetIndexPosition(long key)
+{
+  size_t low = 0;
+  size_t high = subset_index_size_;
+  while (low < high)
+  {
+    size_t middle = low + (high - low)/2;
+    if (subset_index_ptr_[middle].key < key)
+    {
+      low = middle + 1;
+    }
+    else
+    {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+long Parameter::hashSubsetString(const char * str)
+{
+  // FNV-1a
+  unsigned long hash = 2166136261UL;
+  while (*str)
+  {
+    hash ^= (unsigned char)*str++;
+    hash *= 16777619UL;
+  }
+  return (long)hash;
+}
+
+void Parameter::updateValidator()
+{
+  array_element_validator_ = NULL;
+  switch (type_)
+  {
+    case JsonStream::LONG_TYPE:
+    {
+      if (subset_is_set_ || range_is_set_)
+      {
+        validator_ = &Parameter::validateLongConstrained;
+      }
+      else
+      {
+        validator_ = &Parameter::validateLong;
+      }
+      break;
+    }
+    case JsonStream::DOUBLE_TYPE:
+    {
+      if (range_is_set_)
+      {
+        validator_ = &Parameter::validateDoubleRange;
+      }
+      else
+      {
+        validator_ = &Parameter::validateDouble;
+      }
+      break;
+    }
+    case JsonStream::BOOL_TYPE:
+    {
+      validator_ = &Parameter::validateBool;
+      break;
+    }
+    case JsonStream::NULL_TYPE:
+    {
+      validator_ = &Parameter::validateAny;
+      break;
+    }
+    case JsonStream::STRING_TYPE:
+    {
+      if (subset_is_set_)
+      {
+        validator_ = &Parameter::validateStringSubset;
+      }
+      else
+      {
+        validator_ = &Parameter::validateString;
+      }
+      break;
+    }
+    case JsonStream::OBJECT_TYPE:
+    {
+      validator_ = &Parameter::validateObject;
+      break;
+    }
+    case JsonStream::ARRAY_TYPE:
+    {
+      validator_ = &Parameter::validateArray;
+      // array elements are only checked when there is a constraint to check
+      if ((array_element_type_ == JsonStream::LONG_TYPE) && (subset_is_set_ || range_is_set_))
+      {
+        array_element_validator_ = &Parameter::validateLongElement;
+      }
+      else if ((array_element_type_ == JsonStream::DOUBLE_TYPE) && range_is_set_)
+      {
+        array_element_validator_ = &Parameter::validateDoubleElement;
+      }
+      else if ((array_element_type_ == JsonStream::STRING_TYPE) && subset_is_set_)
+      {
+        array_element_validator_ = &Parameter::validateStringElement;
+      }
+      break;
+    }
+    case JsonStream::ANY_TYPE:
+    {
+      validator_ = &Parameter::validateAny;
+      break;
+    }
+  }
+}
+
+bool Parameter::validate(ArduinoJson::JsonVariant json_value)
+{
+  return (this->*validator_)(json_value);
+}
+
+bool Parameter::validateAny(ArduinoJson::JsonVariant json_value)
+{
+  return true;
+}
+
+bool Parameter::validateLong(ArduinoJson::JsonVariant json_value)
+{
+  return json_value.is<signed long>();
+}
+
+bool Parameter::validateLongConstrained(ArduinoJson::JsonVariant json_value)
+{
+  return json_value.is<signed long>() && validateLongElement(json_value);
+}
+
+bool Parameter::validateDouble(ArduinoJson::JsonVariant json_value)
+{
+  return json_value.is<double>();
+}
+
+bool Parameter::validateDoubleRange(ArduinoJson::JsonVariant json_value)
+{
+  return json_value.is<double>() && validateDoubleElement(json_value);
+}
+
+bool Parameter::validateBool(ArduinoJson::JsonVariant json_value)
+{
+  return json_value.is<bool>();
+}
+
+bool Parameter::validateString(ArduinoJson::JsonVariant json_value)
+{
+  return json_value.is<const char *>();
+}
+
+bool Parameter::validateStringSubset(ArduinoJson::JsonVariant json_value)
+{
+  return json_value.is<const char *>() && validateStringElement(json_value);
+}
+
+bool Parameter::validateObject(ArduinoJson::JsonVariant json_value)
+{
+  return json_value.is<ArduinoJson::JsonObject>();
+}
+
+bool Parameter::validateArray(ArduinoJson::JsonVariant json_value)
+{
+  if (!json_value.is<ArduinoJson::JsonArray>())
+  {
+    return false;
+  }
+  ArduinoJson::JsonArray json_array = json_value.as<ArduinoJson::JsonArray>();
+  if (!arrayLengthInRange(json_array.size()))
+  {
+    return false;
+  }
+  if (array_element_validator_)
+  {
+    for (ArduinoJson::JsonVariant element_value : json_array)
+    {
+      if (!(this->*array_element_validator_)(element_value))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool Parameter::validateLongElement(ArduinoJson::JsonVariant json_value)
+{
+  long value = json_value.as<long>();
+  return valueInSubset(value) && valueInRange(value);
+}
+
+bool Parameter::validateDoubleElement(ArduinoJson::JsonVariant json_value)
+{
+  double value = json_value.as<double>();
+  return valueInRange(value);
+}
+
+bool Parameter::validateStringElement(ArduinoJson::JsonVariant json_value)
+{
+  const char * value = json_value.as<const char *>();
+  return valueInSubset(value);
+}
+
 void Parameter::writeApi(Response & response,
   bool write_name_only,
   bool is_property,
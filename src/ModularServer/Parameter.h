@@ -61,6 +61,10 @@ public:
   void removeSubset();
   size_t getSubsetSize();
   size_t getSubsetMaxSize();
+  template <size_t MAX_SIZE>
+  void setSubsetIndexStorage(constants::SubsetIndexEntry (&subset_index)[MAX_SIZE]);
+  void setSubsetIndexStorage(constants::SubsetIndexEntry * subset_index,
+    size_t max_size);
 
   template <typename T>
   bool getValue(T & value);
@@ -72,6 +76,7 @@ public:
   Parameter getElementParameter();
 
 private:
+  typedef bool (Parameter::*Validator)(ArduinoJson::JsonVariant json_value);
   const ConstantString * units_ptr_;
   JsonStream::JsonTypes type_;
   JsonStream::JsonTypes array_element_type_;
@@ -83,8 +88,16 @@ private:
   bool array_length_range_is_set_;
   Vector<constants::SubsetMemberType> subset_;
   bool subset_is_set_;
+  Validator validator_;
+  Validator array_element_validator_;
+  constants::SubsetIndexEntry * subset_index_ptr_;
+  size_t subset_index_max_size_;
+  size_t subset_index_size_;
+  bool subset_index_keys_are_hashes_;
   Parameter(const ConstantString & name);
+  Parameter(const constants::ParameterInfo & parameter_info);
   void setup(const ConstantString & name);
+  void setup(const constants::ParameterInfo & parameter_info);
   const ConstantString & getUnits();
   JsonStream::JsonTypes getType();
   JsonStream::JsonTypes getArrayElementType();
@@ -93,6 +106,10 @@ private:
   bool valueInRange(T value);
   bool valueInRange(double value);
   bool valueInRange(float value);
+  bool valuesInRange(const long * values,
+    size_t value_count);
+  bool valuesInRange(const double * values,
+    size_t value_count);
   const constants::NumberType & getRangeMin();
   const constants::NumberType & getRangeMax();
   size_t getArrayLengthMin();
@@ -106,13 +123,34 @@ private:
   bool valueInSubset(long value);
   bool valueInSubset(const char * value);
   bool valueInSubset(const ConstantString * value);
+  bool valuesInSubset(const long * values,
+    size_t value_count);
+  bool valuesInSubset(const double * values,
+    size_t value_count);
   Vector<constants::SubsetMemberType> & getSubset();
+  void updateSubsetIndex();
+  size_t findSubsetIndexPosition(long key);
+  static long hashSubsetString(const char * str);
+  void updateValidator();
+  bool validate(ArduinoJson::JsonVariant json_value);
+  bool validateAny(ArduinoJson::JsonVariant json_value);
+  bool validateLong(ArduinoJson::JsonVariant json_value);
+  bool validateLongConstrained(ArduinoJson::JsonVariant json_value);
+  bool validateDouble(ArduinoJson::JsonVariant json_value);
+  bool validateDoubleRange(ArduinoJson::JsonVariant json_value);
+  bool validateBool(ArduinoJson::JsonVariant json_value);
+  bool validateString(ArduinoJson::JsonVariant json_value);
+  bool validateStringSubset(ArduinoJson::JsonVariant json_value);
+  bool validateObject(ArduinoJson::JsonVariant json_value);
+  bool validateArray(ArduinoJson::JsonVariant json_value);
+  bool validateLongElement(ArduinoJson::JsonVariant json_value);
+  bool validateDoubleElement(ArduinoJson::JsonVariant json_value);
+  bool validateStringElement(ArduinoJson::JsonVariant json_value);
   void writeApi(Response & response,
     bool write_name_only,
     bool is_property,
     bool write_firmware,
     bool write_instance_details);
-  static Functor1wRet<const ConstantString &,ArduinoJson::JsonVariant> get_value_functor_;
   friend class Property;
   friend class Function;
   friend class Callback;
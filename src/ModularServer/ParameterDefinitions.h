@@ -20,6 +20,7 @@ void Parameter::setRange(T min,
   max_.l = (long)max;
   setTypeLong();
   range_is_set_ = true;
+  updateValidator();
 
   if (array_length_range_is_set_)
   {
@@ -41,6 +42,8 @@ void Parameter::setSubset(constants::SubsetMemberType (&subset)[MAX_SIZE],
 {
   subset_.setStorage(subset,size);
   subset_is_set_ = true;
+  updateValidator();
+  updateSubsetIndex();
 
   if (array_length_range_is_set_)
   {
@@ -56,24 +59,30 @@ void Parameter::setSubset(constants::SubsetMemberType (&subset)[MAX_SIZE],
   }
 }
 
+template <size_t MAX_SIZE>
+void Parameter::setSubsetIndexStorage(constants::SubsetIndexEntry (&subset_index)[MAX_SIZE])
+{
+  setSubsetIndexStorage(subset_index,MAX_SIZE);
+}
+
 template <typename T>
 bool Parameter::getValue(T & value)
 {
   if (getType() == JsonStream::LONG_TYPE)
   {
-    long v = get_value_functor_(getName());
+    long v = context_ptr_->get_parameter_value_functor(getName());
     value = v;
     return true;
   }
   else if (getType() == JsonStream::DOUBLE_TYPE)
   {
-    double v = get_value_functor_(getName());
+    double v = context_ptr_->get_parameter_value_functor(getName());
     value = v;
     return true;
   }
   else if (getType() == JsonStream::BOOL_TYPE)
   {
-    bool v = get_value_functor_(getName());
+    bool v = context_ptr_->get_parameter_value_functor(getName());
     value = v;
     return true;
   }
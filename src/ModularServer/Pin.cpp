@@ -6,11 +6,13 @@
 // Peter Polidoro peterpolidoro@gmail.com
 // ----------------------------------------------------------------------------
 #include "Pin.h"
+#include "RuleEngine.h"
 
 
 namespace modular_server
 {
 EventController<modular_server::constants::PIN_PULSE_EVENT_COUNT_MAX> Pin::pin_pulse_event_controller_;
+bool Pin::callback_timing_enabled_ = false;
 
 // public
 Pin::Pin()
@@ -171,6 +173,7 @@ void Pin::setup(const ConstantString & name)
   callback_ptr_ = NULL;
   mode_ptr_ = &constants::pin_mode_digital_input;
   isr_ = NULL;
+  callback_duration_max_ = 0;
 }
 
 Callback * Pin::getCallbackPtr()
@@ -385,8 +388,40 @@ void Pin::setupPinPulseEventController()
   pin_pulse_event_controller_.setup(constants::pin_pulse_timer_number);
 }
 
+unsigned long Pin::getCallbackDurationMax()
+{
+  noInterrupts();
+  unsigned long callback_duration_max = callback_duration_max_;
+  interrupts();
+  return callback_duration_max;
+}
+
+void Pin::resetCallbackDurationMax()
+{
+  noInterrupts();
+  callback_duration_max_ = 0;
+  interrupts();
+}
+
+void Pin::enableCallbackTiming()
+{
+  callback_timing_enabled_ = true;
+}
+
+void Pin::disableCallbackTiming()
+{
+  callback_timing_enabled_ = false;
+}
+
 void Pin::isrHandler()
 {
+#if MODULAR_SERVER_RULE_COUNT_MAX > 0
+  // rules run first so their actions are not delayed by the callback
+  if (context_ptr_ && context_ptr_->rule_engine_ptr)
+  {
+    context_ptr_->rule_engine_ptr->pinTriggered(*this);
+  }
+#endif
   if (!callback_ptr_)
   {
     return;
@@ -395,7 +430,18 @@ void Pin::isrHandler()
   {
     return;
   }
+  if (!callback_timing_enabled_)
+  {
+    callback_ptr_->functor(this);
+    return;
+  }
+  unsigned long time = micros();
   callback_ptr_->functor(this);
+  unsigned long callback_duration = micros() - time;
+  if (callback_duration > callback_duration_max_)
+  {
+    callback_duration_max_ = callback_duration;
+  }
 }
 
 void Pin::setPinHighHandler(int index)
@@ -49,6 +49,8 @@ private:
   Callback * callback_ptr_;
   const ConstantString * mode_ptr_;
   FunctorCallbacks::Callback isr_;
+  volatile unsigned long callback_duration_max_;
+  static bool callback_timing_enabled_;
   static EventController<modular_server::constants::PIN_PULSE_EVENT_COUNT_MAX> pin_pulse_event_controller_;
 
   Pin(const ConstantString & name,
@@ -72,6 +74,10 @@ private:
   void detach();
   void resetIsr();
   static void setupPinPulseEventController();
+  unsigned long getCallbackDurationMax();
+  void resetCallbackDurationMax();
+  static void enableCallbackTiming();
+  static void disableCallbackTiming();
 
   // Handlers
   void isrHandler();
@@ -80,6 +86,9 @@ private:
 
   friend class Server;
   friend class Callback;
+  friend class PinIndex;
+  friend class WaveformPlayer;
+  friend class RuleEngine;
 };
 }
 #endif
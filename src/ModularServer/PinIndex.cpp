@@ -0,0 +1,244 @@
+// ----------------------------------------------------------------------------
+// PinIndex.cpp
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#include "PinIndex.h"
+
+
+namespace modular_server
+{
+// public
+PinIndex::PinIndex()
+{
+  pins_ptr_ = NULL;
+  size_ = 0;
+  complete_ = false;
+}
+
+void PinIndex::setPins(PinElementIndex & pins)
+{
+  pins_ptr_ = &pins;
+  rebuild();
+}
+
+void PinIndex::rebuild()
+{
+  size_ = 0;
+  for (size_t i=0; i<constants::PIN_NUMBER_COUNT_MAX; ++i)
+  {
+    pin_number_entries_[i] = -1;
+  }
+  for (size_t i=0; i<constants::INTERRUPT_NUMBER_COUNT_MAX; ++i)
+  {
+    interrupt_number_entries_[i] = -1;
+  }
+  complete_ = true;
+  update();
+}
+
+void PinIndex::update()
+{
+  if (pins_ptr_ == NULL)
+  {
+    return;
+  }
+  if (pins_ptr_->size() < size_)
+  {
+    rebuild();
+    return;
+  }
+  while (complete_ && (size_ < pins_ptr_->size()))
+  {
+    complete_ = add(size_);
+  }
+}
+
+int PinIndex::findPinIndex(const char * pin_name)
+{
+  if (pin_name == NULL)
+  {
+    return -1;
+  }
+  if (!complete_)
+  {
+    return findPinIndexLinearly(pin_name,NULL);
+  }
+  return findPinIndexByHash(name_hasher_.hash(pin_name),pin_name,NULL);
+}
+
+int PinIndex::findPinIndex(const ConstantString & pin_name)
+{
+  if (!complete_)
+  {
+    return findPinIndexLinearly(NULL,&pin_name);
+  }
+  return findPinIndexByHash(name_hasher_.hash(pin_name),NULL,&pin_name);
+}
+
+int PinIndex::findPinIndexByPinNumber(size_t pin_number)
+{
+  if (complete_ && (pin_number < constants::PIN_NUMBER_COUNT_MAX))
+  {
+    return pin_number_entries_[pin_number];
+  }
+  for (size_t i=0; i<size(); ++i)
+  {
+    if ((*pins_ptr_)[i].getPinNumber() == pin_number)
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+int PinIndex::findPinIndexByInterruptNumber(int interrupt_number)
+{
+  if (interrupt_number < 0)
+  {
+    return -1;
+  }
+  if (complete_ && (interrupt_number < constants::INTERRUPT_NUMBER_COUNT_MAX))
+  {
+    return interrupt_number_entries_[interrupt_number];
+  }
+  for (size_t i=0; i<size(); ++i)
+  {
+    if ((*pins_ptr_)[i].getInterruptNumber() == interrupt_number)
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+Pin * PinIndex::findPinPtr(const char * pin_name)
+{
+  int pin_index = findPinIndex(pin_name);
+  if (pin_index < 0)
+  {
+    return NULL;
+  }
+  return &((*pins_ptr_)[pin_index]);
+}
+
+Pin * PinIndex::findPinPtr(const ConstantString & pin_name)
+{
+  int pin_index = findPinIndex(pin_name);
+  if (pin_index < 0)
+  {
+    return NULL;
+  }
+  return &((*pins_ptr_)[pin_index]);
+}
+
+size_t PinIndex::size()
+{
+  if (pins_ptr_ == NULL)
+  {
+    return 0;
+  }
+  return pins_ptr_->size();
+}
+
+Pin & PinIndex::operator[](size_t index)
+{
+  return (*pins_ptr_)[index];
+}
+
+// private
+bool PinIndex::add(size_t pin_index)
+{
+  if (pin_index >= constants::PIN_COUNT_MAX)
+  {
+    return false;
+  }
+  Pin & pin = (*pins_ptr_)[pin_index];
+  long key = name_hasher_.hash(pin.getName());
+
+  // insertion sort, pins are only added while hardware is set up
+  size_t position = size_;
+  while ((position > 0) && (name_entries_[position-1].key > key))
+  {
+    name_entries_[position] = name_entries_[position-1];
+    --position;
+  }
+  name_entries_[position].key = key;
+  name_entries_[position].member_index = pin_index;
+
+  // the first pin added with a number keeps it, as in a linear search
+  size_t pin_number = pin.getPinNumber();
+  if ((pin_number < constants::PIN_NUMBER_COUNT_MAX) &&
+    (pin_number_entries_[pin_number] < 0))
+  {
+    pin_number_entries_[pin_number] = pin_index;
+  }
+  int interrupt_number = pin.getInterruptNumber();
+  if ((interrupt_number >= 0) &&
+    (interrupt_number < constants::INTERRUPT_NUMBER_COUNT_MAX) &&
+    (interrupt_number_entries_[interrupt_number] < 0))
+  {
+    interrupt_number_entries_[interrupt_number] = pin_index;
+  }
+  ++size_;
+  return true;
+}
+
+int PinIndex::findPinIndexLinearly(const char * pin_name,
+  const ConstantString * pin_name_ptr)
+{
+  for (size_t i=0; i<size(); ++i)
+  {
+    Pin & pin = (*pins_ptr_)[i];
+    if (pin_name_ptr ? pin.compareName(*pin_name_ptr) : pin.compareName(pin_name))
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+int PinIndex::findPinIndexByHash(long key,
+  const char * pin_name,
+  const ConstantString * pin_name_ptr)
+{
+  // entries with equal hashes are adjacent, compare names to resolve collisions
+  for (size_t position=findPosition(name_entries_,size_,key);
+       (position < size_) && (name_entries_[position].key == key);
+       ++position)
+  {
+    size_t pin_index = name_entries_[position].member_index;
+    Pin & pin = (*pins_ptr_)[pin_index];
+    if (pin_name_ptr ? pin.compareName(*pin_name_ptr) : pin.compareName(pin_name))
+    {
+      return pin_index;
+    }
+  }
+  return -1;
+}
+
+
+size_t PinIndex::findPosition(constants::SubsetIndexEntry * entries,
+  size_t entry_count,
+  long key)
+{
+  size_t low = 0;
+  size_t high = entry_count;
+  while (low < high)
+  {
+    size_t middle = low + (high - low)/2;
+    if (entries[middle].key < key)
+    {
+      low = middle + 1;
+    }
+    else
+    {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+}
@@ -0,0 +1,70 @@
+// ----------------------------------------------------------------------------
+// PinIndex.h
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_PIN_INDEX_H_
+#define _MODULAR_SERVER_PIN_INDEX_H_
+#include <Arduino.h>
+#include <ConstantVariable.h>
+
+#include "ElementIndex.h"
+#include "Pin.h"
+#include "NameHasher.h"
+#include "Constants.h"
+
+
+namespace modular_server
+{
+typedef ElementIndex<Pin,constants::PIN_COUNT_MAX,constants::HARDWARE_COUNT_MAX> PinElementIndex;
+#if MODULAR_SERVER_PIN_COUNT_MAX < 128
+typedef int8_t PinNumberEntry;
+#else
+typedef int16_t PinNumberEntry;
+#endif
+
+// Pins sorted by case insensitive name hash for binary search, and tables of
+// pin indexes by pin number and by interrupt number, falls back to searching
+// linearly when the pins or their numbers do not fit
+class PinIndex
+{
+public:
+  PinIndex();
+  void setPins(PinElementIndex & pins);
+  void rebuild();
+  void update();
+
+  int findPinIndex(const char * pin_name);
+  int findPinIndex(const ConstantString & pin_name);
+  int findPinIndexByPinNumber(size_t pin_number);
+  int findPinIndexByInterruptNumber(int interrupt_number);
+  Pin * findPinPtr(const char * pin_name);
+  Pin * findPinPtr(const ConstantString & pin_name);
+
+  size_t size();
+  Pin & operator[](size_t index);
+
+private:
+  PinElementIndex * pins_ptr_;
+  NameHasher name_hasher_;
+  constants::SubsetIndexEntry name_entries_[constants::PIN_COUNT_MAX];
+  PinNumberEntry pin_number_entries_[constants::PIN_NUMBER_COUNT_MAX];
+  PinNumberEntry interrupt_number_entries_[constants::INTERRUPT_NUMBER_COUNT_MAX];
+  size_t size_;
+  bool complete_;
+
+  bool add(size_t pin_index);
+  int findPinIndexLinearly(const char * pin_name,
+    const ConstantString * pin_name_ptr);
+  int findPinIndexByHash(long key,
+    const char * pin_name,
+    const ConstantString * pin_name_ptr);
+  static size_t findPosition(constants::SubsetIndexEntry * entries,
+    size_t entry_count,
+    long key);
+};
+}
+
+#endif
@@ -0,0 +1,138 @@
+// ----------------------------------------------------------------------------
+// PipeForward.cpp
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#include "PipeForward.h"
+
+
+namespace modular_server
+{
+// public
+PipeForward::PipeForward()
+{
+  downstream_ptr_ = NULL;
+  upstream_ptr_ = NULL;
+  framed_ = false;
+  compact_print_ = true;
+  timeout_ = 0;
+  sequence_ = 0;
+  last_byte_time_ = 0;
+  response_[0] = '\0';
+  response_length_ = 0;
+  response_complete_ = false;
+  response_too_long_ = false;
+}
+
+void PipeForward::begin(Stream & downstream,
+  Stream & upstream,
+  bool framed,
+  bool compact_print,
+  unsigned long timeout,
+  unsigned long sequence)
+{
+  downstream_ptr_ = &downstream;
+  upstream_ptr_ = &upstream;
+  framed_ = framed;
+  compact_print_ = compact_print;
+  timeout_ = timeout;
+  sequence_ = sequence;
+  last_byte_time_ = millis();
+  response_[0] = '\0';
+  response_length_ = 0;
+  response_complete_ = false;
+  response_too_long_ = false;
+}
+
+bool PipeForward::active()
+{
+  return (downstream_ptr_ != NULL);
+}
+
+Stream * PipeForward::getDownstreamPtr()
+{
+  return downstream_ptr_;
+}
+
+Stream * PipeForward::getUpstreamPtr()
+{
+  return upstream_ptr_;
+}
+
+unsigned long PipeForward::getSequence()
+{
+  return sequence_;
+}
+
+bool PipeForward::framed()
+{
+  return framed_;
+}
+
+bool PipeForward::compactPrint()
+{
+  return compact_print_;
+}
+
+void PipeForward::hold()
+{
+  last_byte_time_ = millis();
+}
+
+bool PipeForward::update()
+{
+  if (!active())
+  {
+    return false;
+  }
+  while (!response_complete_ && (downstream_ptr_->available() > 0))
+  {
+    int c = downstream_ptr_->read();
+    if (c < 0)
+    {
+      break;
+    }
+    last_byte_time_ = millis();
+    if (c == JsonStream::EOL)
+    {
+      response_complete_ = true;
+    }
+    else if (response_length_ < (constants::STRING_LENGTH_PIPE_RESPONSE - 1))
+    {
+      response_[response_length_++] = c;
+    }
+    else
+    {
+      // the rest of the line is still read so the downstream stream stays in
+      // step with the requests sent to it
+      response_too_long_ = true;
+    }
+  }
+  response_[response_length_] = '\0';
+  return (response_complete_ || ((millis() - last_byte_time_) >= timeout_));
+}
+
+bool PipeForward::responseComplete()
+{
+  return response_complete_;
+}
+
+bool PipeForward::responseTooLong()
+{
+  return response_too_long_;
+}
+
+const char * PipeForward::getResponse()
+{
+  return response_;
+}
+
+void PipeForward::end()
+{
+  downstream_ptr_ = NULL;
+  upstream_ptr_ = NULL;
+}
+
+}
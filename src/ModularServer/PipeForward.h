@@ -0,0 +1,59 @@
+// ----------------------------------------------------------------------------
+// PipeForward.h
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_PIPE_FORWARD_H_
+#define _MODULAR_SERVER_PIPE_FORWARD_H_
+#include <Arduino.h>
+#include <JsonStream.h>
+
+#include "Constants.h"
+
+
+namespace modular_server
+{
+// Collects a downstream response line for a deferred upstream response as
+// bytes arrive, until the line is complete or the downstream stream times out
+class PipeForward
+{
+public:
+  PipeForward();
+
+  void begin(Stream & downstream,
+    Stream & upstream,
+    bool framed,
+    bool compact_print,
+    unsigned long timeout,
+    unsigned long sequence);
+  bool active();
+  Stream * getDownstreamPtr();
+  Stream * getUpstreamPtr();
+  unsigned long getSequence();
+  bool framed();
+  bool compactPrint();
+  void hold();
+  bool update();
+  bool responseComplete();
+  bool responseTooLong();
+  const char * getResponse();
+  void end();
+
+private:
+  Stream * downstream_ptr_;
+  Stream * upstream_ptr_;
+  bool framed_;
+  bool compact_print_;
+  unsigned long timeout_;
+  unsigned long sequence_;
+  unsigned long last_byte_time_;
+  char response_[constants::STRING_LENGTH_PIPE_RESPONSE];
+  size_t response_length_;
+  bool response_complete_;
+  bool response_too_long_;
+};
+}
+
+#endif
@@ -6,6 +6,7 @@
 // Peter Polidoro peterpolidoro@gmail.com
 // ----------------------------------------------------------------------------
 #include "Property.h"
+#include "RuleEngine.h"
 
 
 namespace modular_server
@@ -26,6 +27,8 @@ CONSTANT_STRING(set_value_to_default_function_name,"setValueToDefault");
 CONSTANT_STRING(element_index_parameter_name,"element_index");
 CONSTANT_STRING(element_value_parameter_name,"element_value");
 CONSTANT_STRING(array_length_parameter_name,"array_length");
+CONSTANT_STRING(element_count_parameter_name,"element_count");
+CONSTANT_STRING(element_values_parameter_name,"element_values");
 
 // Array Functions
 CONSTANT_STRING(get_element_value_function_name,"getElementValue");
@@ -35,45 +38,39 @@ CONSTANT_STRING(set_element_value_to_default_function_name,"setElementValueToDef
 CONSTANT_STRING(set_all_element_values_function_name,"setAllElementValues");
 CONSTANT_STRING(get_array_length_function_name,"getArrayLength");
 CONSTANT_STRING(set_array_length_function_name,"setArrayLength");
+CONSTANT_STRING(get_element_values_function_name,"getElementValues");
+CONSTANT_STRING(set_element_values_function_name,"setElementValues");
 }
 
-Parameter Property::property_parameters_[property::PARAMETER_COUNT_MAX];
-Function Property::property_functions_[property::FUNCTION_COUNT_MAX];
-Parameter Property::property_array_parameters_[property::ARRAY_PARAMETER_COUNT_MAX];
-Function Property::property_array_functions_[property::ARRAY_FUNCTION_COUNT_MAX];
-ConcatenatedArray<Parameter,property::FUNCTION_PARAMETER_TYPE_COUNT> Property::parameters_;
-ConcatenatedArray<Function,property::FUNCTION_PARAMETER_TYPE_COUNT> Property::functions_;
-Response * Property::response_ptr_;
-Functor1wRet<const ConstantString &,ArduinoJson::JsonVariant> Property::get_parameter_value_functor_;
-
 Parameter & Property::createParameter(const ConstantString & parameter_name)
 {
   int parameter_index = findParameterIndex(parameter_name);
   if (parameter_index < 0)
   {
-    parameters_.push_back(Parameter(parameter_name));
-    parameters_.back().setFirmwareName(constants::firmware_name);
-    return parameters_.back();
+    tables().parameters.push_back(Parameter(parameter_name));
+    tables().parameters.back().setFirmwareName(constants::firmware_name);
+    tables().parameters.back().setContext(*context_ptr_);
+    return tables().parameters.back();
   }
-  return parameters_[0]; // bad reference
+  return tables().parameters[0]; // bad reference
 }
 
 Parameter & Property::parameter(const ConstantString & parameter_name)
 {
   int parameter_index = findParameterIndex(parameter_name);
-  if ((parameter_index >= 0) && (parameter_index < (int)parameters_.size()))
+  if ((parameter_index >= 0) && (parameter_index < (int)tables().parameters.size()))
   {
-    return parameters_[parameter_index];
+    return tables().parameters[parameter_index];
   }
-  return parameters_[0]; // bad reference
+  return tables().parameters[0]; // bad reference
 }
 
 Parameter & Property::copyParameter(Parameter parameter,
   const ConstantString & parameter_name)
 {
-  parameters_.push_back(parameter);
-  parameters_.back().setName(parameter_name);
-  return parameters_.back();
+  tables().parameters.push_back(parameter);
+  tables().parameters.back().setName(parameter_name);
+  return tables().parameters.back();
 }
 
 Function & Property::createFunction(const ConstantString & function_name)
@@ -81,27 +78,27 @@ Function & Property::createFunction(const ConstantString & function_name)
   int function_index = findFunctionIndex(function_name);
   if (function_index < 0)
   {
-    functions_.push_back(Function(function_name));
-    functions_.back().setFirmwareName(constants::firmware_name);
-    return functions_.back();
+    tables().functions.push_back(Function(function_name));
+    tables().functions.back().setFirmwareName(constants::firmware_name);
+    tables().functions.back().setContext(*context_ptr_);
+    return tables().functions.back();
   }
-  return functions_[0]; // bad reference
+  return tables().functions[0]; // bad reference
 }
 
 Function & Property::function(const ConstantString & function_name)
 {
   int function_index = findFunctionIndex(function_name);
-  if ((function_index >= 0) && (function_index < (int)functions_.size()))
+  if ((function_index >= 0) && (function_index < (int)tables().functions.size()))
   {
-    return functions_[function_index];
+    return tables().functions[function_index];
   }
-  return functions_[0]; // bad reference
+  return tables().functions[0]; // bad reference
 }
 
 // public
 Property::Property()
 {
-  response_ptr_ = NULL;
   setup();
 }
 
@@ -551,41 +548,17 @@ bool Property::setValue(ArduinoJson::JsonArray value)
     {
       case JsonStream::LONG_TYPE:
       {
-        for (size_t i=0; i<array_length_min; ++i)
-        {
-          long v = value[i];
-          success = setElementValue<long>(i,v);
-          if (!success)
-          {
-            break;
-          }
-        }
+        success = setArrayValue<long>(value,array_length_min);
         break;
       }
       case JsonStream::DOUBLE_TYPE:
       {
-        for (size_t i=0; i<array_length_min; ++i)
-        {
-          double v = value[i];
-          success = setElementValue<double>(i,v);
-          if (!success)
-          {
-            break;
-          }
-        }
+        success = setArrayValue<double>(value,array_length_min);
         break;
       }
       case JsonStream::BOOL_TYPE:
       {
-        for (size_t i=0; i<array_length_min; ++i)
-        {
-          bool v = value[i];
-          success = setElementValue<bool>(i,v);
-          if (!success)
-          {
-            break;
-          }
-        }
+        success = setArrayValue<bool>(value,array_length_min);
         break;
       }
       case JsonStream::NULL_TYPE:
@@ -594,18 +567,7 @@ bool Property::setValue(ArduinoJson::JsonArray value)
       }
       case JsonStream::STRING_TYPE:
       {
-        if (!stringSavedAsCharArray())
-        {
-          for (size_t i=0; i<array_length_min; ++i)
-          {
-            const char * v = value[i];
-            success = setElementValue(i,v);
-            if (!success)
-            {
-              break;
-            }
-          }
-        }
+        success = setArrayValue<const ConstantString *>(value,array_length_min);
         break;
       }
       case JsonStream::OBJECT_TYPE:
@@ -626,6 +588,60 @@ bool Property::setValue(ArduinoJson::JsonArray value)
   return success;
 }
 
+bool Property::setElementValues(size_t element_index,
+  ArduinoJson::JsonArray value)
+{
+  bool success = false;
+  size_t array_length = getArrayLength();
+  if ((getType() != JsonStream::ARRAY_TYPE) ||
+    (element_index >= array_length))
+  {
+    return success;
+  }
+  size_t element_count = min(array_length - element_index,value.size());
+  JsonStream::JsonTypes array_element_type = getArrayElementType();
+  switch (array_element_type)
+  {
+    case JsonStream::LONG_TYPE:
+    {
+      success = setArrayElementValues<long>(element_index,value,element_count);
+      break;
+    }
+    case JsonStream::DOUBLE_TYPE:
+    {
+      success = setArrayElementValues<double>(element_index,value,element_count);
+      break;
+    }
+    case JsonStream::BOOL_TYPE:
+    {
+      success = setArrayElementValues<bool>(element_index,value,element_count);
+      break;
+    }
+    case JsonStream::NULL_TYPE:
+    {
+      break;
+    }
+    case JsonStream::STRING_TYPE:
+    {
+      success = setArrayElementValues<const ConstantString *>(element_index,value,element_count);
+      break;
+    }
+    case JsonStream::OBJECT_TYPE:
+    {
+      break;
+    }
+    case JsonStream::ARRAY_TYPE:
+    {
+      break;
+    }
+    case JsonStream::ANY_TYPE:
+    {
+      break;
+    }
+  }
+  return success;
+}
+
 template <>
 bool Property::setAllElementValues<const char *>(const char * const & element_value)
 {
@@ -1198,6 +1214,18 @@ saved_variable_(default_value)
 void Property::setup()
 {
   functors_enabled_ = true;
+  context_ptr_ = NULL;
+}
+
+void Property::setContext(ServerContext & context)
+{
+  context_ptr_ = &context;
+  parameter_.setContext(context);
+}
+
+PropertyTables & Property::tables()
+{
+  return *(context_ptr_->property_tables_ptr);
 }
 
 Parameter & Property::parameter()
@@ -1230,6 +1258,11 @@ bool Property::firmwareNameInArray(ArduinoJson::JsonArray firmware_name_array)
   return parameter_.firmwareNameInArray(firmware_name_array);
 }
 
+bool Property::firmwareInMask(constants::FirmwareMask firmware_mask)
+{
+  return parameter_.firmwareInMask(firmware_mask);
+}
+
 JsonStream::JsonTypes Property::getType()
 {
   return parameter_.getType();
@@ -1308,6 +1341,12 @@ void Property::preSetElementValueFunctor(size_t element_index)
 
 void Property::postSetValueFunctor()
 {
+#if MODULAR_SERVER_RULE_COUNT_MAX > 0
+  if (context_ptr_ && context_ptr_->rule_engine_ptr)
+  {
+    context_ptr_->rule_engine_ptr->propertySet(*this);
+  }
+#endif
   if (post_set_value_functor_ && functors_enabled_)
   {
     post_set_value_functor_();
@@ -1322,6 +1361,70 @@ void Property::postSetElementValueFunctor(size_t element_index)
   }
 }
 
+bool Property::getArrayBlockValue(ArduinoJson::JsonVariant element_value,
+  long & block_value)
+{
+  block_value = element_value.as<long>();
+  return true;
+}
+
+bool Property::getArrayBlockValue(ArduinoJson::JsonVariant element_value,
+  double & block_value)
+{
+  block_value = element_value.as<double>();
+  return true;
+}
+
+bool Property::getArrayBlockValue(ArduinoJson::JsonVariant element_value,
+  bool & block_value)
+{
+  block_value = element_value.as<bool>();
+  return true;
+}
+
+bool Property::getArrayBlockValue(ArduinoJson::JsonVariant element_value,
+  const ConstantString * & block_value)
+{
+  // string array elements are saved as pointers to their subset members
+  if (stringSavedAsCharArray())
+  {
+    return false;
+  }
+  int subset_value_index = findSubsetValueIndex(element_value.as<const char *>());
+  if (subset_value_index < 0)
+  {
+    return false;
+  }
+  Vector<constants::SubsetMemberType> & subset = getSubset();
+  block_value = subset[subset_value_index].cs_ptr;
+  return true;
+}
+
+bool Property::arrayBlockValuesValid(const long * block,
+  size_t block_size)
+{
+  return parameter_.valuesInRange(block,block_size) && parameter_.valuesInSubset(block,block_size);
+}
+
+bool Property::arrayBlockValuesValid(const double * block,
+  size_t block_size)
+{
+  return parameter_.valuesInRange(block,block_size) && parameter_.valuesInSubset(block,block_size);
+}
+
+bool Property::arrayBlockValuesValid(const bool * block,
+  size_t block_size)
+{
+  return true;
+}
+
+bool Property::arrayBlockValuesValid(const ConstantString * const * block,
+  size_t block_size)
+{
+  // string elements were found in the subset as they were read
+  return true;
+}
+
 void Property::writeValue(Response & response,
   bool write_key,
   bool write_default,
@@ -1609,6 +1712,69 @@ void Property::writeValue(Response & response,
   }
 }
 
+void Property::writeElementValues(Response & response,
+  size_t element_index,
+  size_t element_count)
+{
+  if (response.error())
+  {
+    return;
+  }
+
+  size_t array_length = getArrayLength();
+  if ((getType() != JsonStream::ARRAY_TYPE) ||
+    (element_index >= array_length))
+  {
+    response.returnParameterInvalidError(constants::property_element_index_out_of_bounds_error_data);
+    return;
+  }
+  // a slice running past the end is clipped so the last chunk of a ranged read
+  // does not need the array length
+  size_t element_end = element_index + min(element_count,array_length - element_index);
+
+  response.beginArray();
+  const JsonStream::JsonTypes array_element_type = getArrayElementType();
+  for (size_t i=element_index; i<element_end; ++i)
+  {
+    switch (array_element_type)
+    {
+      case JsonStream::LONG_TYPE:
+      {
+        long property_value;
+        getElementValue(i,property_value);
+        response.write(property_value);
+        break;
+      }
+      case JsonStream::DOUBLE_TYPE:
+      {
+        double property_value;
+        getElementValue(i,property_value);
+        response.write(property_value);
+        break;
+      }
+      case JsonStream::BOOL_TYPE:
+      {
+        bool property_value;
+        getElementValue(i,property_value);
+        response.write(property_value);
+        break;
+      }
+      case JsonStream::STRING_TYPE:
+      {
+        const ConstantString * property_value;
+        getElementValue(i,property_value);
+        response.write(property_value);
+        break;
+      }
+      default:
+      {
+        break;
+      }
+    }
+  }
+  response.endArray();
+}
+
 void Property::writeApi(Response & response,
   bool write_name_only,
   bool write_firmware,
@@ -1658,18 +1824,18 @@ void Property::writeApi(Response & response,
 
   response.writeKey(constants::functions_constant_string);
   response.beginArray();
-  for (size_t i=0; i<Property::functions_.size(); ++i)
+  for (size_t i=0; i<tables().functions.size(); ++i)
   {
-    Function & function = Property::functions_[i];
+    Function & function = tables().functions[i];
     function.writeApi(response,!write_function_parameter_details,false,false);
   }
   response.endArray();
 
   response.writeKey(constants::parameters_constant_string);
   response.beginArray();
-  for (size_t i=0; i<Property::parameters_.size(); ++i)
+  for (size_t i=0; i<tables().parameters.size(); ++i)
   {
-    Parameter & parameter = Property::parameters_[i];
+    Parameter & parameter = tables().parameters[i];
     parameter.writeApi(response,!write_function_parameter_details,false,false,write_instance_details);
   }
   response.endArray();
@@ -1682,14 +1848,14 @@ void Property::updateFunctionsAndParameters()
   JsonStream::JsonTypes type = getType();
 
   // Parameters
-  parameters_.clear();
-  parameters_.addArray(property_parameters_);
+  tables().parameters.clear();
+  tables().parameters.addArray(tables().property_parameters);
 
   Parameter & value_parameter = copyParameter(parameter(),property::value_parameter_name);
 
   // Functions
-  functions_.clear();
-  functions_.addArray(property_functions_);
+  tables().functions.clear();
+  tables().functions.addArray(tables().property_functions);
 
   Function & get_value_function = createFunction(property::get_value_function_name);
   get_value_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Property::getValueHandler));
@@ -1719,7 +1885,7 @@ void Property::updateFunctionsAndParameters()
     set_value_to_default_function.setResultType(array_element_type);
 
     // Array Parameters
-    parameters_.addArray(property_array_parameters_);
+    tables().parameters.addArray(tables().property_array_parameters);
 
     Parameter & element_index_parameter = createParameter(property::element_index_parameter_name);
     element_index_parameter.setTypeLong();
@@ -1739,15 +1905,24 @@ void Property::updateFunctionsAndParameters()
     Parameter & element_value_parameter = copyParameter(parameter().getElementParameter(),property::element_value_parameter_name);
 
     Parameter * array_length_parameter_ptr = NULL;
+    Parameter * element_count_parameter_ptr = NULL;
+    Parameter * element_values_parameter_ptr = NULL;
     if (type == JsonStream::ARRAY_TYPE)
     {
       array_length_parameter_ptr = &(createParameter(property::array_length_parameter_name));
       array_length_parameter_ptr->setTypeLong();
       array_length_parameter_ptr->setRange(array_length_min_,array_length_max_);
+
+      element_count_parameter_ptr = &(createParameter(property::element_count_parameter_name));
+      element_count_parameter_ptr->setTypeLong();
+      element_count_parameter_ptr->setRange((long)1,(long)array_length_max_);
+
+      element_values_parameter_ptr = &(copyParameter(parameter(),property::element_values_parameter_name));
+      element_values_parameter_ptr->setArrayLengthRange(1,array_length_max_);
     }
 
     // Array Functions
-    functions_.addArray(property_array_functions_);
+    tables().functions.addArray(tables().property_array_functions);
 
     Function & get_element_value_function = createFunction(property::get_element_value_function_name);
     get_element_value_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Property::getElementValueHandler));
@@ -1789,14 +1964,26 @@ void Property::updateFunctionsAndParameters()
       set_array_length_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Property::setArrayLengthHandler));
       set_array_length_function.addParameter(*array_length_parameter_ptr);
       set_array_length_function.setResultTypeLong();
+
+      Function & get_element_values_function = createFunction(property::get_element_values_function_name);
+      get_element_values_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Property::getElementValuesHandler));
+      get_element_values_function.addParameter(element_index_parameter);
+      get_element_values_function.addParameter(*element_count_parameter_ptr);
+      get_element_values_function.setResultType(type);
+
+      Function & set_element_values_function = createFunction(property::set_element_values_function_name);
+      set_element_values_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Property::setElementValuesHandler));
+      set_element_values_function.addParameter(element_index_parameter);
+      set_element_values_function.addParameter(*element_values_parameter_ptr);
+      set_element_values_function.setResultType(type);
     }
   }
 }
 
 void Property::getValueHandler()
 {
-  response_ptr_->writeResultKey();
-  writeValue(*response_ptr_,false,false,-1);
+  context_ptr_->response_ptr->writeResultKey();
+  writeValue(*(context_ptr_->response_ptr),false,false,-1);
 }
 
 void Property::setValueHandler()
@@ -1806,19 +1993,19 @@ void Property::setValueHandler()
   {
     case JsonStream::LONG_TYPE:
     {
-      long value = get_parameter_value_functor_(property::value_parameter_name);
+      long value = context_ptr_->get_parameter_value_functor(property::value_parameter_name);
       setValue(value);
       break;
     }
     case JsonStream::DOUBLE_TYPE:
     {
-      double value = get_parameter_value_functor_(property::value_parameter_name);
+      double value = context_ptr_->get_parameter_value_functor(property::value_parameter_name);
       setValue(value);
       break;
     }
     case JsonStream::BOOL_TYPE:
     {
-      bool value = get_parameter_value_functor_(property::value_parameter_name);
+      bool value = context_ptr_->get_parameter_value_functor(property::value_parameter_name);
       setValue(value);
       break;
     }
@@ -1828,7 +2015,7 @@ void Property::setValueHandler()
     }
     case JsonStream::STRING_TYPE:
     {
-      const char * value = get_parameter_value_functor_(property::value_parameter_name);
+      const char * value = context_ptr_->get_parameter_value_functor(property::value_parameter_name);
       size_t array_length = strlen(value) + 1;
       setValue(value,array_length);
       break;
@@ -1839,7 +2026,7 @@ void Property::setValueHandler()
     }
     case JsonStream::ARRAY_TYPE:
     {
-      ArduinoJson::JsonArray value = get_parameter_value_functor_(property::value_parameter_name);
+      ArduinoJson::JsonArray value = context_ptr_->get_parameter_value_functor(property::value_parameter_name);
       setValue(value);
       break;
     }
@@ -1848,50 +2035,50 @@ void Property::setValueHandler()
       break;
     }
   }
-  response_ptr_->writeResultKey();
-  writeValue(*response_ptr_,false,false,-1);
+  context_ptr_->response_ptr->writeResultKey();
+  writeValue(*(context_ptr_->response_ptr),false,false,-1);
 }
 
 void Property::getDefaultValueHandler()
 {
-  response_ptr_->writeResultKey();
-  writeValue(*response_ptr_,false,true,-1);
+  context_ptr_->response_ptr->writeResultKey();
+  writeValue(*(context_ptr_->response_ptr),false,true,-1);
 }
 
 void Property::setValueToDefaultHandler()
 {
   setValueToDefault();
-  response_ptr_->writeResultKey();
-  writeValue(*response_ptr_,false,false,-1);
+  context_ptr_->response_ptr->writeResultKey();
+  writeValue(*(context_ptr_->response_ptr),false,false,-1);
 }
 
 void Property::getElementValueHandler()
 {
-  long element_index = get_parameter_value_functor_(property::element_index_parameter_name);
-  response_ptr_->writeResultKey();
-  writeValue(*response_ptr_,false,false,element_index);
+  long element_index = context_ptr_->get_parameter_value_functor(property::element_index_parameter_name);
+  context_ptr_->response_ptr->writeResultKey();
+  writeValue(*(context_ptr_->response_ptr),false,false,element_index);
 }
 
 void Property::setElementValueHandler()
 {
-  long element_index = get_parameter_value_functor_(property::element_index_parameter_name);
+  long element_index = context_ptr_->get_parameter_value_functor(property::element_index_parameter_name);
 
   JsonStream::JsonTypes type = getType();
   switch (type)
   {
     case JsonStream::LONG_TYPE:
     {
-      response_ptr_->returnParameterInvalidError(constants::property_not_array_type_error_data);
+      context_ptr_->response_ptr->returnParameterInvalidError(constants::property_not_array_type_error_data);
       break;
     }
     case JsonStream::DOUBLE_TYPE:
     {
-      response_ptr_->returnParameterInvalidError(constants::property_not_array_type_error_data);
+      context_ptr_->response_ptr->returnParameterInvalidError(constants::property_not_array_type_error_data);
       break;
     }
     case JsonStream::BOOL_TYPE:
     {
-      response_ptr_->returnParameterInvalidError(constants::property_not_array_type_error_data);
+      context_ptr_->response_ptr->returnParameterInvalidError(constants::property_not_array_type_error_data);
       break;
     }
     case JsonStream::NULL_TYPE:
@@ -1902,16 +2089,16 @@ void Property::setElementValueHandler()
     {
       if (!stringSavedAsCharArray())
       {
-        response_ptr_->returnParameterInvalidError(constants::cannot_set_element_in_string_property_with_subset_error_data);
+        context_ptr_->response_ptr->returnParameterInvalidError(constants::cannot_set_element_in_string_property_with_subset_error_data);
         break;
       }
       size_t array_length = getArrayLength();
       if ((size_t)element_index >= (array_length - 1))
       {
-        response_ptr_->returnParameterInvalidError(constants::property_element_index_out_of_bounds_error_data);
+        context_ptr_->response_ptr->returnParameterInvalidError(constants::property_element_index_out_of_bounds_error_data);
         return;
       }
-      const char * value = get_parameter_value_functor_(property::element_value_parameter_name);
+      const char * value = context_ptr_->get_parameter_value_functor(property::element_value_parameter_name);
       size_t string_length = strlen(value);
       if (string_length >= 1)
       {
@@ -1929,7 +2116,7 @@ void Property::setElementValueHandler()
       size_t array_length = getArrayLength();
       if ((size_t)element_index >= array_length)
       {
-        response_ptr_->returnParameterInvalidError(constants::property_element_index_out_of_bounds_error_data);
+        context_ptr_->response_ptr->returnParameterInvalidError(constants::property_element_index_out_of_bounds_error_data);
         return;
       }
       JsonStream::JsonTypes array_element_type = getArrayElementType();
@@ -1937,19 +2124,19 @@ void Property::setElementValueHandler()
       {
         case JsonStream::LONG_TYPE:
         {
-          long value = get_parameter_value_functor_(property::element_value_parameter_name);
+          long value = context_ptr_->get_parameter_value_functor(property::element_value_parameter_name);
           setElementValue(element_index,value);
           break;
         }
         case JsonStream::DOUBLE_TYPE:
         {
-          double value = get_parameter_value_functor_(property::element_value_parameter_name);
+          double value = context_ptr_->get_parameter_value_functor(property::element_value_parameter_name);
           setElementValue(element_index,value);
           break;
         }
         case JsonStream::BOOL_TYPE:
         {
-          bool value = get_parameter_value_functor_(property::element_value_parameter_name);
+          bool value = context_ptr_->get_parameter_value_functor(property::element_value_parameter_name);
           setElementValue(element_index,value);
           break;
         }
@@ -1959,7 +2146,7 @@ void Property::setElementValueHandler()
         }
         case JsonStream::STRING_TYPE:
         {
-          const char * value = get_parameter_value_functor_(property::element_value_parameter_name);
+          const char * value = context_ptr_->get_parameter_value_functor(property::element_value_parameter_name);
           setElementValue(element_index,value);
           break;
         }
@@ -1983,23 +2170,23 @@ void Property::setElementValueHandler()
       break;
     }
   }
-  response_ptr_->writeResultKey();
-  writeValue(*response_ptr_,false,false,-1);
+  context_ptr_->response_ptr->writeResultKey();
+  writeValue(*(context_ptr_->response_ptr),false,false,-1);
 }
 
 void Property::getDefaultElementValueHandler()
 {
-  long element_index = get_parameter_value_functor_(property::element_index_parameter_name);
-  response_ptr_->writeResultKey();
-  writeValue(*response_ptr_,false,true,element_index);
+  long element_index = context_ptr_->get_parameter_value_functor(property::element_index_parameter_name);
+  context_ptr_->response_ptr->writeResultKey();
+  writeValue(*(context_ptr_->response_ptr),false,true,element_index);
 }
 
 void Property::setElementValueToDefaultHandler()
 {
-  long element_index = get_parameter_value_functor_(property::element_index_parameter_name);
+  long element_index = context_ptr_->get_parameter_value_functor(property::element_index_parameter_name);
   setElementValueToDefault(element_index);
-  response_ptr_->writeResultKey();
-  writeValue(*response_ptr_,false,false,-1);
+  context_ptr_->response_ptr->writeResultKey();
+  writeValue(*(context_ptr_->response_ptr),false,false,-1);
 }
 
 void Property::setAllElementValuesHandler()
@@ -2027,10 +2214,10 @@ void Property::setAllElementValuesHandler()
     {
       if (!stringSavedAsCharArray())
       {
-        response_ptr_->returnParameterInvalidError(constants::cannot_set_element_in_string_property_with_subset_error_data);
+        context_ptr_->response_ptr->returnParameterInvalidError(constants::cannot_set_element_in_string_property_with_subset_error_data);
         break;
       }
-      const char * value = get_parameter_value_functor_(property::element_value_parameter_name);
+      const char * value = context_ptr_->get_parameter_value_functor(property::element_value_parameter_name);
       size_t string_length = strlen(value);
       if (string_length >= 1)
       {
@@ -2050,19 +2237,19 @@ void Property::setAllElementValuesHandler()
       {
         case JsonStream::LONG_TYPE:
         {
-          long value = get_parameter_value_functor_(property::element_value_parameter_name);
+          long value = context_ptr_->get_parameter_value_functor(property::element_value_parameter_name);
           setAllElementValues(value);
           break;
         }
         case JsonStream::DOUBLE_TYPE:
         {
-          double value = get_parameter_value_functor_(property::element_value_parameter_name);
+          double value = context_ptr_->get_parameter_value_functor(property::element_value_parameter_name);
           setAllElementValues(value);
           break;
         }
         case JsonStream::BOOL_TYPE:
         {
-          bool value = get_parameter_value_functor_(property::element_value_parameter_name);
+          bool value = context_ptr_->get_parameter_value_functor(property::element_value_parameter_name);
           setAllElementValues(value);
           break;
         }
@@ -2072,7 +2259,7 @@ void Property::setAllElementValuesHandler()
         }
         case JsonStream::STRING_TYPE:
         {
-          const char * value = get_parameter_value_functor_(property::element_value_parameter_name);
+          const char * value = context_ptr_->get_parameter_value_functor(property::element_value_parameter_name);
           setAllElementValues(value);
           break;
         }
@@ -2096,23 +2283,55 @@ void Property::setAllElementValuesHandler()
       break;
     }
   }
-  response_ptr_->writeResultKey();
-  writeValue(*response_ptr_,false,false,-1);
+  context_ptr_->response_ptr->writeResultKey();
+  writeValue(*(context_ptr_->response_ptr),false,false,-1);
 }
 
 void Property::getArrayLengthHandler()
 {
   size_t array_length = getArrayLength();
-  response_ptr_->returnResult(array_length);
+  context_ptr_->response_ptr->returnResult(array_length);
 }
 
 void Property::setArrayLengthHandler()
 {
-  long array_length = get_parameter_value_functor_(property::array_length_parameter_name);
+  long array_length = context_ptr_->get_parameter_value_functor(property::array_length_parameter_name);
   setArrayLength(array_length);
 
   array_length = getArrayLength();
-  response_ptr_->returnResult(array_length);
+  context_ptr_->response_ptr->returnResult(array_length);
+}
+
+void Property::getElementValuesHandler()
+{
+  long element_index = context_ptr_->get_parameter_value_functor(property::element_index_parameter_name);
+  long element_count = context_ptr_->get_parameter_value_functor(property::element_count_parameter_name);
+  context_ptr_->response_ptr->writeResultKey();
+  writeElementValues(*(context_ptr_->response_ptr),element_index,element_count);
+}
+
+void Property::setElementValuesHandler()
+{
+  // strings saved as char arrays are string type, not array type
+  if (getType() != JsonStream::ARRAY_TYPE)
+  {
+    context_ptr_->response_ptr->returnParameterInvalidError(constants::property_not_array_type_error_data);
+    return;
+  }
+  long element_index = context_ptr_->get_parameter_value_functor(property::element_index_parameter_name);
+  ArduinoJson::JsonArray element_values = context_ptr_->get_parameter_value_functor(property::element_values_parameter_name);
+  if ((size_t)element_index >= getArrayLength())
+  {
+    context_ptr_->response_ptr->returnParameterInvalidError(constants::property_element_index_out_of_bounds_error_data);
+    return;
+  }
+  if (!setElementValues(element_index,element_values))
+  {
+    context_ptr_->response_ptr->returnParameterInvalidError(constants::array_parameter_error_error_data);
+    return;
+  }
+  context_ptr_->response_ptr->writeResultKey();
+  writeElementValues(*(context_ptr_->response_ptr),element_index,element_values.size());
 }
 
 }
@@ -30,8 +30,8 @@ namespace property
 enum{FUNCTION_PARAMETER_TYPE_COUNT=2};
 enum{PARAMETER_COUNT_MAX=1};
 enum{FUNCTION_COUNT_MAX=4};
-enum{ARRAY_PARAMETER_COUNT_MAX=3};
-enum{ARRAY_FUNCTION_COUNT_MAX=7};
+enum{ARRAY_PARAMETER_COUNT_MAX=5};
+enum{ARRAY_FUNCTION_COUNT_MAX=9};
 
 // Parameters
 extern ConstantString value_parameter_name;
@@ -46,6 +46,8 @@ extern ConstantString set_value_to_default_function_name;
 extern ConstantString element_index_parameter_name;
 extern ConstantString element_value_parameter_name;
 extern ConstantString array_length_parameter_name;
+extern ConstantString element_count_parameter_name;
+extern ConstantString element_values_parameter_name;
 
 // Array Functions
 extern ConstantString get_element_value_function_name;
@@ -55,8 +57,22 @@ extern ConstantString set_element_value_to_default_function_name;
 extern ConstantString set_all_element_values_function_name;
 extern ConstantString get_array_length_function_name;
 extern ConstantString set_array_length_function_name;
+extern ConstantString get_element_values_function_name;
+extern ConstantString set_element_values_function_name;
 }
 
+// Property functions and parameters are rebuilt in these tables for each
+// request, one set per server
+struct PropertyTables
+{
+  Parameter property_parameters[property::PARAMETER_COUNT_MAX];
+  Function property_functions[property::FUNCTION_COUNT_MAX];
+  Parameter property_array_parameters[property::ARRAY_PARAMETER_COUNT_MAX];
+  Function property_array_functions[property::ARRAY_FUNCTION_COUNT_MAX];
+  ConcatenatedArray<Parameter,property::FUNCTION_PARAMETER_TYPE_COUNT> parameters;
+  ConcatenatedArray<Function,property::FUNCTION_PARAMETER_TYPE_COUNT> functions;
+};
+
 class Property
 {
 public:
@@ -168,23 +184,18 @@ public:
   void reenableFunctors();
 
 private:
-  static Parameter property_parameters_[property::PARAMETER_COUNT_MAX];
-  static Function property_functions_[property::FUNCTION_COUNT_MAX];
-  static Parameter property_array_parameters_[property::ARRAY_PARAMETER_COUNT_MAX];
-  static Function property_array_functions_[property::ARRAY_FUNCTION_COUNT_MAX];
-  static ConcatenatedArray<Parameter,property::FUNCTION_PARAMETER_TYPE_COUNT> parameters_;
-  static ConcatenatedArray<Function,property::FUNCTION_PARAMETER_TYPE_COUNT> functions_;
-  static Response * response_ptr_;
-  static Functor1wRet<const ConstantString &,
-    ArduinoJson::JsonVariant> get_parameter_value_functor_;
+  ServerContext * context_ptr_;
+
+  void setContext(ServerContext & context);
+  PropertyTables & tables();
 
   template <typename T>
-  static int findParameterIndex(T const & parameter_name)
+  int findParameterIndex(T const & parameter_name)
   {
     int parameter_index = -1;
-    for (size_t i=0; i<parameters_.size(); ++i)
+    for (size_t i=0; i<tables().parameters.size(); ++i)
     {
-      if (parameters_[i].compareName(parameter_name))
+      if (tables().parameters[i].compareName(parameter_name))
       {
         parameter_index = i;
         break;
@@ -192,18 +203,18 @@ private:
     }
     return parameter_index;
   };
-  static Parameter & createParameter(const ConstantString & parameter_name);
-  static Parameter & parameter(const ConstantString & parameter_name);
-  static Parameter & copyParameter(Parameter parameter,
+  Parameter & createParameter(const ConstantString & parameter_name);
+  Parameter & parameter(const ConstantString & parameter_name);
+  Parameter & copyParameter(Parameter parameter,
     const ConstantString & parameter_name);
 
   template <typename T>
-  static int findFunctionIndex(T const & function_name)
+  int findFunctionIndex(T const & function_name)
   {
     int function_index = -1;
-    for (size_t i=0; i<functions_.size(); ++i)
+    for (size_t i=0; i<tables().functions.size(); ++i)
     {
-      if (functions_[i].compareName(function_name))
+      if (tables().functions[i].compareName(function_name))
       {
         function_index = i;
         break;
@@ -211,8 +222,8 @@ private:
     }
     return function_index;
   };
-  static Function & createFunction(const ConstantString & function_name);
-  static Function & function(const ConstantString & function_name);
+  Function & createFunction(const ConstantString & function_name);
+  Function & function(const ConstantString & function_name);
 
   Parameter parameter_;
   SavedVariable saved_variable_;
@@ -254,6 +265,7 @@ private:
   const ConstantString & getName();
   const ConstantString &  getFirmwareName();
   bool firmwareNameInArray(ArduinoJson::JsonArray firmware_name_array);
+  bool firmwareInMask(constants::FirmwareMask firmware_mask);
   JsonStream::JsonTypes getType();
   JsonStream::JsonTypes getArrayElementType();
   bool rangeIsSet();
@@ -270,10 +282,48 @@ private:
   void preSetElementValueFunctor(size_t element_index);
   void postSetValueFunctor();
   void postSetElementValueFunctor(size_t element_index);
+  template <typename T>
+  bool setArrayValue(ArduinoJson::JsonArray value,
+    size_t element_count);
+  bool setElementValues(size_t element_index,
+    ArduinoJson::JsonArray value);
+  template <typename T>
+  bool setArrayElementValues(size_t element_index,
+    ArduinoJson::JsonArray value,
+    size_t element_count);
+  template <typename T>
+  bool processArrayValueBlocks(size_t element_index,
+    ArduinoJson::JsonArray value,
+    size_t element_count,
+    bool store);
+  template <typename T>
+  bool processArrayValueBlock(size_t block_start,
+    const T * block,
+    size_t block_size,
+    bool store);
+  bool getArrayBlockValue(ArduinoJson::JsonVariant element_value,
+    long & block_value);
+  bool getArrayBlockValue(ArduinoJson::JsonVariant element_value,
+    double & block_value);
+  bool getArrayBlockValue(ArduinoJson::JsonVariant element_value,
+    bool & block_value);
+  bool getArrayBlockValue(ArduinoJson::JsonVariant element_value,
+    const ConstantString * & block_value);
+  bool arrayBlockValuesValid(const long * block,
+    size_t block_size);
+  bool arrayBlockValuesValid(const double * block,
+    size_t block_size);
+  bool arrayBlockValuesValid(const bool * block,
+    size_t block_size);
+  bool arrayBlockValuesValid(const ConstantString * const * block,
+    size_t block_size);
   void writeValue(Response & response,
     bool write_key=false,
     bool write_default=false,
     int element_index=-1);
+  void writeElementValues(Response & response,
+    size_t element_index,
+    size_t element_count);
   void writeApi(Response & response,
     bool write_name_only,
     bool write_firmware,
@@ -294,6 +344,8 @@ private:
   void setAllElementValuesHandler();
   void getArrayLengthHandler();
   void setArrayLengthHandler();
+  void getElementValuesHandler();
+  void setElementValuesHandler();
 
   friend class Callback;
   friend class Server;
@@ -601,5 +601,87 @@ saved_variable_(default_value)
   setup();
 }
 
+template <typename T>
+bool Property::setArrayValue(ArduinoJson::JsonArray value,
+  size_t element_count)
+{
+  return setArrayElementValues<T>(0,value,element_count);
+}
+
+template <typename T>
+bool Property::setArrayElementValues(size_t element_index,
+  ArduinoJson::JsonArray value,
+  size_t element_count)
+{
+  if (element_count == 0)
+  {
+    return false;
+  }
+  // check every element before storing any of them
+  if (!processArrayValueBlocks<T>(element_index,value,element_count,false))
+  {
+    return false;
+  }
+  return processArrayValueBlocks<T>(element_index,value,element_count,true);
+}
+
+template <typename T>
+bool Property::processArrayValueBlocks(size_t element_index,
+  ArduinoJson::JsonArray value,
+  size_t element_count,
+  bool store)
+{
+  T block[constants::ARRAY_VALUE_BLOCK_SIZE];
+  size_t block_start = element_index;
+  size_t block_size = 0;
+  size_t element_end = element_index + element_count;
+  for (ArduinoJson::JsonVariant element_value : value)
+  {
+    if ((block_start + block_size) >= element_end)
+    {
+      break;
+    }
+    if (!getArrayBlockValue(element_value,block[block_size++]))
+    {
+      return false;
+    }
+    if ((block_size == constants::ARRAY_VALUE_BLOCK_SIZE) ||
+      ((block_start + block_size) == element_end))
+    {
+      if (!processArrayValueBlock(block_start,block,block_size,store))
+      {
+        return false;
+      }
+      block_start += block_size;
+      block_size = 0;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+bool Property::processArrayValueBlock(size_t block_start,
+  const T * block,
+  size_t block_size,
+  bool store)
+{
+  if (!store)
+  {
+    return arrayBlockValuesValid(block,block_size);
+  }
+  for (size_t i=0; i<block_size; ++i)
+  {
+    size_t element_index = block_start + i;
+    preSetElementValueFunctor(element_index);
+    bool success = saved_variable_.setElementValue(element_index,block[i]);
+    postSetElementValueFunctor(element_index);
+    if (!success)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
 }
 #endif
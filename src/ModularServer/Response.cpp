@@ -8,12 +8,43 @@
 #include "Response.h"
 
 
+#ifdef __AVR__
+extern char __heap_start;
+extern char * __brkval;
+#endif
+
 namespace modular_server
 {
+#ifdef __AVR__
+namespace
+{
+const char stack_paint = 0xC5;
+// bytes below the painting frame left unpainted
+const size_t stack_paint_guard = 32;
+
+const char * heapEnd()
+{
+  return __brkval ? __brkval : &__heap_start;
+}
+}
+#endif
+
 // public
+void Response::returnResult(double value)
+{
+  updateStackHighWater();
+  // Prevent multiple results in one response
+  if (!result_key_in_response_ && !error_)
+  {
+    result_key_in_response_ = true;
+    write(constants::result_constant_string,value);
+  }
+}
+
 void Response::writeResultKey()
 {
   // Prevent multiple results in one response
+  updateStackHighWater();
   if (!result_key_in_response_ && !error_)
   {
     result_key_in_response_ = true;
@@ -21,6 +52,42 @@ void Response::writeResultKey()
   }
 }
 
+void Response::returnResult(double * value,
+  size_t N)
+{
+  updateStackHighWater();
+  // Prevent multiple results in one response
+  if (!result_key_in_response_ && !error_)
+  {
+    result_key_in_response_ = true;
+    writeArray(constants::result_constant_string,value,N);
+  }
+}
+
+void Response::write(double value)
+{
+  if (error_)
+  {
+    return;
+  }
+  json_stream_ptr_->write(FormattedDouble(value));
+}
+
+void Response::writeArray(double * value,
+  size_t N)
+{
+  if (error_)
+  {
+    return;
+  }
+  json_stream_ptr_->beginArray();
+  for (size_t i=0; i<N; ++i)
+  {
+    json_stream_ptr_->write(FormattedDouble(value[i]));
+  }
+  json_stream_ptr_->endArray();
+}
+
 void Response::write(Vector<constants::SubsetMemberType> & value,
   JsonStream::JsonTypes type)
 {
@@ -88,6 +155,7 @@ void Response::writeNull()
 
 void Response::beginObject()
 {
+  updateStackHighWater();
   if (error_)
   {
     return;
@@ -106,6 +174,7 @@ void Response::endObject()
 
 void Response::beginArray()
 {
+  updateStackHighWater();
   if (error_)
   {
     return;
@@ -122,17 +191,19 @@ void Response::endArray()
   json_stream_ptr_->endArray();
 }
 
-long Response::pipeFrom(Stream & stream)
+long Response::pipeFrom(Stream & stream,
+  unsigned long timeout)
 {
   if (error_)
   {
     return 0;
   }
   JsonStream json_stream(stream);
-  return pipeFrom(json_stream);
+  return pipeFrom(json_stream,timeout);
 }
 
-long Response::pipeFrom(JsonStream & json_stream)
+long Response::pipeFrom(JsonStream & json_stream,
+  unsigned long timeout)
 {
   if (error_)
   {
@@ -145,12 +216,12 @@ long Response::pipeFrom(JsonStream & json_stream)
   bool found_eol = false;
   char c;
   long chars_piped = 0;
-  long read_tries = 0;
-  while (!found_eol && (read_tries < constants::response_pipe_read_max))
+  unsigned long last_char_time = millis();
+  while (!found_eol && ((millis() - last_char_time) < timeout))
   {
     if (json_stream.available())
     {
-      read_tries = 0;
+      last_char_time = millis();
       c = json_stream.readChar();
       if (c >= 0)
       {
@@ -165,10 +236,6 @@ long Response::pipeFrom(JsonStream & json_stream)
         }
       }
     }
-    else
-    {
-      ++read_tries;
-    }
   }
   if (found_eol)
   {
@@ -180,6 +247,32 @@ long Response::pipeFrom(JsonStream & json_stream)
   }
 }
 
+bool Response::pipeFromAsync(Stream & stream,
+  unsigned long timeout)
+{
+  if (error_ || pipe_stream_ptr_ || !pipe_async_enabled_)
+  {
+    return false;
+  }
+  if (&stream == &(json_stream_ptr_->getStream()))
+  {
+    return false;
+  }
+  // the downstream response becomes the result, written by the server once it
+  // has all arrived after the handler returns
+  updateStackHighWater();
+  result_key_in_response_ = true;
+  pipe_stream_ptr_ = &stream;
+  pipe_timeout_ = timeout;
+  return true;
+}
+
+bool Response::pipeFromAsync(JsonStream & json_stream,
+  unsigned long timeout)
+{
+  return pipeFromAsync(json_stream.getStream(),timeout);
+}
+
 bool Response::error()
 {
   return error_;
@@ -189,13 +282,22 @@ bool Response::error()
 Response::Response()
 {
   json_stream_ptr_ = NULL;
+  stack_top_ptr_ = NULL;
+  stack_base_ptr_ = NULL;
+  stack_high_water_ = 0;
+  arena_ptr_ = NULL;
+  pipe_async_enabled_ = true;
+  compact_print_ = true;
   reset();
 }
 
 void Response::reset()
 {
   error_ = false;
+  error_code_ = 0;
   result_key_in_response_ = false;
+  pipe_stream_ptr_ = NULL;
+  pipe_timeout_ = 0;
 }
 
 void Response::setJsonStream(JsonStream & json_stream)
@@ -203,6 +305,11 @@ void Response::setJsonStream(JsonStream & json_stream)
   json_stream_ptr_ = &json_stream;
 }
 
+void Response::setArena(Arena & arena)
+{
+  arena_ptr_ = &arena;
+}
+
 void Response::begin()
 {
   reset();
@@ -218,18 +325,146 @@ void Response::end()
   error_ = false;
   endObject();
   json_stream_ptr_->writeNewline();
+  // nothing allocated for the request is used once its response is written
+  if (arena_ptr_)
+  {
+    arena_ptr_->reset();
+  }
+}
+
+// each step of a request sequence is written as an object holding its own
+// result or error, an error ends the step without ending the response
+void Response::beginStep()
+{
+  beginObject();
+  result_key_in_response_ = false;
+}
+
+bool Response::endStep()
+{
+  bool step_succeeded = !error_;
+  if (!error_ && !result_key_in_response_)
+  {
+    writeNull(constants::result_constant_string);
+  }
+  error_ = false;
+  result_key_in_response_ = true;
+  endObject();
+  return step_succeeded;
+}
+
+// a result piped after the handler returns cannot be written inside a step,
+// so pipeFromAsync fails before writing anything while piping is disabled
+void Response::enablePipeAsync()
+{
+  pipe_async_enabled_ = true;
+}
+
+void Response::disablePipeAsync()
+{
+  pipe_async_enabled_ = false;
+}
+
+// the result of a pipe forward is the downstream response line, written as
+// it was received
+void Response::returnPipedResult(const char * result)
+{
+  writeResultKey();
+  if (error_)
+  {
+    return;
+  }
+  if (*result == '\0')
+  {
+    json_stream_ptr_->writeNull();
+    return;
+  }
+  while (*result)
+  {
+    json_stream_ptr_->writeChar(*result++);
+  }
 }
 
 void Response::setCompactPrint()
 {
+  compact_print_ = true;
   json_stream_ptr_->setCompactPrint();
 }
 
 void Response::setPrettyPrint()
 {
+  compact_print_ = false;
   json_stream_ptr_->setPrettyPrint();
 }
 
+int Response::getErrorCode()
+{
+  return error_code_;
+}
+
+void Response::setStackTop(const char * stack_top_ptr)
+{
+  stack_top_ptr_ = stack_top_ptr;
+  // the highest request frame is where painted stack depth is measured from
+  if (stack_top_ptr && (!stack_base_ptr_ || (stack_top_ptr > stack_base_ptr_)))
+  {
+    stack_base_ptr_ = stack_top_ptr;
+  }
+}
+
+void Response::updateStackHighWater()
+{
+  // stack grows down from stack_top_ptr_
+  char stack_marker;
+  if (stack_top_ptr_ && (stack_top_ptr_ > &stack_marker))
+  {
+    size_t stack_used = stack_top_ptr_ - &stack_marker;
+    if (stack_used > stack_high_water_)
+    {
+      stack_high_water_ = stack_used;
+    }
+  }
+}
+
+size_t Response::getStackHighWater()
+{
+#ifdef __AVR__
+  // the lowest byte no longer holding paint is the deepest the stack reached
+  // since it was painted, including library code and handlers that never
+  // write to the response
+  char stack_marker;
+  const char * touched_ptr = heapEnd();
+  while ((touched_ptr < &stack_marker) && (*touched_ptr == stack_paint))
+  {
+    ++touched_ptr;
+  }
+  if (stack_base_ptr_ && (stack_base_ptr_ > touched_ptr))
+  {
+    size_t stack_used = stack_base_ptr_ - touched_ptr;
+    if (stack_used > stack_high_water_)
+    {
+      stack_high_water_ = stack_used;
+    }
+  }
+#endif
+  return stack_high_water_;
+}
+
+void Response::resetStackHighWater()
+{
+  stack_high_water_ = 0;
+#ifdef __AVR__
+  // paint the free memory between the heap and this frame, interrupts only
+  // use it while painting is suspended
+  char stack_marker;
+  char * paint_end = &stack_marker - stack_paint_guard;
+  for (char * paint_ptr = (char *)heapEnd(); paint_ptr < paint_end; ++paint_ptr)
+  {
+    *paint_ptr = stack_paint;
+  }
+#endif
+}
+
 void Response::returnRequestParseError(const char * const request)
 {
   // Prevent multiple errors in one response
@@ -242,6 +477,7 @@ void Response::returnRequestParseError(const char * const request)
     write(constants::code_constant_string,constants::parse_error_code);
     endObject();
     error_ = true;
+    error_code_ = constants::parse_error_code;
   }
 }
 
@@ -254,30 +490,21 @@ void Response::returnParameterCountError(size_t parameter_count,
     writeKey(constants::error_constant_string);
     beginObject();
     write(constants::message_constant_string,constants::invalid_params_error_message);
-    char incorrect_parameter_number_str[constants::incorrect_parameter_number_error_data.length()+1];
-    incorrect_parameter_number_str[0] = '\0';
-    constants::incorrect_parameter_number_error_data.copy(incorrect_parameter_number_str);
-    char error_str[constants::STRING_LENGTH_ERROR];
-    error_str[0] = '\0';
-    strcat(error_str,incorrect_parameter_number_str);
-    char parameter_count_str[constants::STRING_LENGTH_PARAMETER_COUNT];
-    parameter_count_str[0] = '\0';
-    dtostrf(parameter_count,0,0,parameter_count_str);
-    strcat(error_str,parameter_count_str);
-    char given_str[constants::given_constant_string.length()+1];
-    given_str[0] = '\0';
-    constants::given_constant_string.copy(given_str);
-    strcat(error_str,given_str);
-    dtostrf(parameter_count_needed,0,0,parameter_count_str);
-    strcat(error_str,parameter_count_str);
-    char needed_str[constants::needed_constant_string.length()+1];
-    needed_str[0] = '\0';
-    constants::needed_constant_string.copy(needed_str);
-    strcat(error_str,needed_str);
-    write(constants::data_constant_string,error_str);
+    char * error_str = allocateErrorString();
+    if (error_str)
+    {
+      appendToErrorString(error_str,constants::incorrect_parameter_number_error_data);
+      appendToErrorString(error_str,parameter_count);
+      appendToErrorString(error_str,constants::given_constant_string);
+      appendToErrorString(error_str,parameter_count_needed);
+      appendToErrorString(error_str,constants::needed_constant_string);
+      updateStackHighWater();
+      write(constants::data_constant_string,error_str);
+    }
     write(constants::code_constant_string,constants::invalid_params_error_code);
     endObject();
     error_ = true;
+    error_code_ = constants::invalid_params_error_code;
   }
 }
 
@@ -292,6 +519,7 @@ void Response::returnMethodNotFoundError()
     write(constants::code_constant_string,constants::method_not_found_error_code);
     endObject();
     error_ = true;
+    error_code_ = constants::method_not_found_error_code;
   }
 }
 
@@ -307,6 +535,7 @@ void Response::returnParameterNotFoundError()
     write(constants::code_constant_string,constants::invalid_params_error_code);
     endObject();
     error_ = true;
+    error_code_ = constants::invalid_params_error_code;
   }
 }
 
@@ -318,24 +547,18 @@ void Response::returnParameterIncorrectTypeError(const ConstantString & paramete
     writeKey(constants::error_constant_string);
     beginObject();
     write(constants::message_constant_string,constants::invalid_params_error_message);
-
-    char parameter_name_str[parameter_name.length()+1];
-    parameter_name_str[0] = '\0';
-    parameter_name.copy(parameter_name_str);
-
-    char parameter_incorrect_type_error_str[constants::parameter_incorrect_type_error_data.length()+1];
-    parameter_incorrect_type_error_str[0] = '\0';
-    constants::parameter_incorrect_type_error_data.copy(parameter_incorrect_type_error_str);
-
-    char error_str[constants::STRING_LENGTH_ERROR];
-    error_str[0] = '\0';
-    strcat(error_str,parameter_name_str);
-    strcat(error_str,parameter_incorrect_type_error_str);
-    write(constants::data_constant_string,error_str);
-
+    char * error_str = allocateErrorString();
+    if (error_str)
+    {
+      appendToErrorString(error_str,parameter_name);
+      appendToErrorString(error_str,constants::parameter_incorrect_type_error_data);
+      updateStackHighWater();
+      write(constants::data_constant_string,error_str);
+    }
     write(constants::code_constant_string,constants::invalid_params_error_code);
     endObject();
     error_ = true;
+    error_code_ = constants::invalid_params_error_code;
   }
 }
 
@@ -349,31 +572,24 @@ void Response::returnParameterArrayLengthError(const ConstantString & parameter_
     writeKey(constants::error_constant_string);
     beginObject();
     write(constants::message_constant_string,constants::invalid_params_error_message);
-    char error_str[constants::STRING_LENGTH_ERROR];
-    error_str[0] = '\0';
-    constants::array_parameter_length_error_error_data.copy(error_str);
-    char value_not_in_range_str[constants::value_not_in_range_error_data.length() + 1];
-    constants::value_not_in_range_error_data.copy(value_not_in_range_str);
-    strcat(error_str,value_not_in_range_str);
-    strcat(error_str,min_str);
-    char less_than_equal_str[constants::less_than_equal_constant_string.length()+1];
-    less_than_equal_str[0] = '\0';
-    constants::less_than_equal_constant_string.copy(less_than_equal_str);
-    strcat(error_str,less_than_equal_str);
-    char parameter_name_str[parameter_name.length()+1];
-    parameter_name_str[0] = '\0';
-    parameter_name.copy(parameter_name_str);
-    strcat(error_str,parameter_name_str);
-    char array_length_str[constants::array_length_spaces_constant_string.length()+1];
-    array_length_str[0] = '\0';
-    constants::array_length_spaces_constant_string.copy(array_length_str);
-    strcat(error_str,array_length_str);
-    strcat(error_str,less_than_equal_str);
-    strcat(error_str,max_str);
-    write(constants::data_constant_string,error_str);
+    char * error_str = allocateErrorString();
+    if (error_str)
+    {
+      appendToErrorString(error_str,constants::array_parameter_length_error_error_data);
+      appendToErrorString(error_str,constants::value_not_in_range_error_data);
+      appendToErrorString(error_str,min_str);
+      appendToErrorString(error_str,constants::less_than_equal_constant_string);
+      appendToErrorString(error_str,parameter_name);
+      appendToErrorString(error_str,constants::array_length_spaces_constant_string);
+      appendToErrorString(error_str,constants::less_than_equal_constant_string);
+      appendToErrorString(error_str,max_str);
+      updateStackHighWater();
+      write(constants::data_constant_string,error_str);
+    }
     write(constants::code_constant_string,constants::invalid_params_error_code);
     endObject();
     error_ = true;
+    error_code_ = constants::invalid_params_error_code;
   }
 }
 
@@ -389,6 +605,7 @@ void Response::returnParameterInvalidError(const ConstantString & error)
     write(constants::code_constant_string,constants::invalid_params_error_code);
     endObject();
     error_ = true;
+    error_code_ = constants::invalid_params_error_code;
   }
 }
 
@@ -401,26 +618,26 @@ void Response::returnParameterNotInSubsetError(const char * const subset_str,
     writeKey(constants::error_constant_string);
     beginObject();
     write(constants::message_constant_string,constants::invalid_params_error_message);
-    char error_str[constants::STRING_LENGTH_ERROR];
-    error_str[0] = '\0';
-    if (parameter_type != JsonStream::ARRAY_TYPE)
+    char * error_str = allocateErrorString();
+    if (error_str)
     {
-      constants::parameter_error_error_data.copy(error_str);
-    }
-    else
-    {
-      constants::array_parameter_error_error_data.copy(error_str);
+      if (parameter_type != JsonStream::ARRAY_TYPE)
+      {
+        appendToErrorString(error_str,constants::parameter_error_error_data);
+      }
+      else
+      {
+        appendToErrorString(error_str,constants::array_parameter_error_error_data);
+      }
+      appendToErrorString(error_str,constants::value_not_in_subset_error_data);
+      appendToErrorString(error_str,subset_str);
+      updateStackHighWater();
+      write(constants::data_constant_string,error_str);
     }
-    char value_not_in_subset_str[constants::value_not_in_subset_error_data.length() + 1];
-    value_not_in_subset_str[0] = '\0';
-    constants::value_not_in_subset_error_data.copy(value_not_in_subset_str);
-    strcat(error_str,value_not_in_subset_str);
-    size_t length_left = constants::STRING_LENGTH_ERROR - strlen(error_str) - 1;
-    strncat(error_str,subset_str,length_left);
-    write(constants::data_constant_string,error_str);
     write(constants::code_constant_string,constants::invalid_params_error_code);
     endObject();
     error_ = true;
+    error_code_ = constants::invalid_params_error_code;
   }
 }
 
@@ -435,42 +652,34 @@ void Response::returnParameterNotInRangeError(const ConstantString & parameter_n
     writeKey(constants::error_constant_string);
     beginObject();
     write(constants::message_constant_string,constants::invalid_params_error_message);
-    char error_str[constants::STRING_LENGTH_ERROR];
-    error_str[0] = '\0';
-    if (parameter_type != JsonStream::ARRAY_TYPE)
+    char * error_str = allocateErrorString();
+    if (error_str)
     {
-      constants::parameter_error_error_data.copy(error_str);
-    }
-    else
-    {
-      constants::array_parameter_error_error_data.copy(error_str);
-    }
-    char value_not_in_range_str[constants::value_not_in_range_error_data.length() + 1];
-    value_not_in_range_str[0] = '\0';
-    constants::value_not_in_range_error_data.copy(value_not_in_range_str);
-    strcat(error_str,value_not_in_range_str);
-    strcat(error_str,min_str);
-    char less_than_equal_str[constants::less_than_equal_constant_string.length()+1];
-    less_than_equal_str[0] = '\0';
-    constants::less_than_equal_constant_string.copy(less_than_equal_str);
-    strcat(error_str,less_than_equal_str);
-    char parameter_name_str[parameter_name.length()+1];
-    parameter_name_str[0] = '\0';
-    parameter_name.copy(parameter_name_str);
-    strcat(error_str,parameter_name_str);
-    if (parameter_type == JsonStream::ARRAY_TYPE)
-    {
-      char element_str[constants::element_constant_string.length()+1];
-      element_str[0] = '\0';
-      constants::element_constant_string.copy(element_str);
-      strcat(error_str,element_str);
+      if (parameter_type != JsonStream::ARRAY_TYPE)
+      {
+        appendToErrorString(error_str,constants::parameter_error_error_data);
+      }
+      else
+      {
+        appendToErrorString(error_str,constants::array_parameter_error_error_data);
+      }
+      appendToErrorString(error_str,constants::value_not_in_range_error_data);
+      appendToErrorString(error_str,min_str);
+      appendToErrorString(error_str,constants::less_than_equal_constant_string);
+      appendToErrorString(error_str,parameter_name);
+      if (parameter_type == JsonStream::ARRAY_TYPE)
+      {
+        appendToErrorString(error_str,constants::element_constant_string);
+      }
+      appendToErrorString(error_str,constants::less_than_equal_constant_string);
+      appendToErrorString(error_str,max_str);
+      updateStackHighWater();
+      write(constants::data_constant_string,error_str);
     }
-    strcat(error_str,less_than_equal_str);
-    strcat(error_str,max_str);
-    write(constants::data_constant_string,error_str);
     write(constants::code_constant_string,constants::invalid_params_error_code);
     endObject();
     error_ = true;
+    error_code_ = constants::invalid_params_error_code;
   }
 }
 
@@ -485,6 +694,35 @@ void Response::returnPropertyFunctionNotFoundError()
     write(constants::code_constant_string,constants::invalid_params_error_code);
     endObject();
     error_ = true;
+    error_code_ = constants::invalid_params_error_code;
+  }
+}
+
+void Response::returnApiTableError(const ConstantString * element_name_ptr,
+  const ConstantString & error_data,
+  const ConstantString & name)
+{
+  // Prevent multiple errors in one response
+  if (!error_)
+  {
+    writeKey(constants::error_constant_string);
+    beginObject();
+    write(constants::message_constant_string,constants::server_error_error_message);
+    char * error_str = allocateErrorString();
+    if (error_str)
+    {
+      if (element_name_ptr)
+      {
+        appendToErrorString(error_str,*element_name_ptr);
+      }
+      appendToErrorString(error_str,error_data);
+      appendToErrorString(error_str,name);
+      write(constants::data_constant_string,error_str);
+    }
+    write(constants::code_constant_string,constants::server_error_error_code);
+    endObject();
+    error_ = true;
+    error_code_ = constants::server_error_error_code;
   }
 }
 
@@ -497,30 +735,21 @@ void Response::returnPropertyParameterCountError(size_t parameter_count,
     writeKey(constants::error_constant_string);
     beginObject();
     write(constants::message_constant_string,constants::invalid_params_error_message);
-    char incorrect_parameter_number_str[constants::incorrect_parameter_number_error_data.length()+1];
-    incorrect_parameter_number_str[0] = '\0';
-    constants::incorrect_property_parameter_number_error_data.copy(incorrect_parameter_number_str);
-    char error_str[constants::STRING_LENGTH_ERROR];
-    error_str[0] = '\0';
-    strcat(error_str,incorrect_parameter_number_str);
-    char parameter_count_str[constants::STRING_LENGTH_PARAMETER_COUNT];
-    parameter_count_str[0] = '\0';
-    dtostrf(parameter_count,0,0,parameter_count_str);
-    strcat(error_str,parameter_count_str);
-    char given_str[constants::given_constant_string.length()+1];
-    given_str[0] = '\0';
-    constants::given_constant_string.copy(given_str);
-    strcat(error_str,given_str);
-    dtostrf(parameter_count_needed,0,0,parameter_count_str);
-    strcat(error_str,parameter_count_str);
-    char needed_str[constants::needed_constant_string.length()+1];
-    needed_str[0] = '\0';
-    constants::needed_constant_string.copy(needed_str);
-    strcat(error_str,needed_str);
-    write(constants::data_constant_string,error_str);
+    char * error_str = allocateErrorString();
+    if (error_str)
+    {
+      appendToErrorString(error_str,constants::incorrect_property_parameter_number_error_data);
+      appendToErrorString(error_str,parameter_count);
+      appendToErrorString(error_str,constants::given_constant_string);
+      appendToErrorString(error_str,parameter_count_needed);
+      appendToErrorString(error_str,constants::needed_constant_string);
+      updateStackHighWater();
+      write(constants::data_constant_string,error_str);
+    }
     write(constants::code_constant_string,constants::invalid_params_error_code);
     endObject();
     error_ = true;
+    error_code_ = constants::invalid_params_error_code;
   }
 }
 
@@ -535,6 +764,7 @@ void Response::returnCallbackFunctionNotFoundError()
     write(constants::code_constant_string,constants::invalid_params_error_code);
     endObject();
     error_ = true;
+    error_code_ = constants::invalid_params_error_code;
   }
 }
 
@@ -547,31 +777,57 @@ void Response::returnCallbackParameterCountError(size_t parameter_count,
     writeKey(constants::error_constant_string);
     beginObject();
     write(constants::message_constant_string,constants::invalid_params_error_message);
-    char incorrect_parameter_number_str[constants::incorrect_parameter_number_error_data.length()+1];
-    incorrect_parameter_number_str[0] = '\0';
-    constants::incorrect_callback_parameter_number_error_data.copy(incorrect_parameter_number_str);
-    char error_str[constants::STRING_LENGTH_ERROR];
-    error_str[0] = '\0';
-    strcat(error_str,incorrect_parameter_number_str);
-    char parameter_count_str[constants::STRING_LENGTH_PARAMETER_COUNT];
-    parameter_count_str[0] = '\0';
-    dtostrf(parameter_count,0,0,parameter_count_str);
-    strcat(error_str,parameter_count_str);
-    char given_str[constants::given_constant_string.length()+1];
-    given_str[0] = '\0';
-    constants::given_constant_string.copy(given_str);
-    strcat(error_str,given_str);
-    dtostrf(parameter_count_needed,0,0,parameter_count_str);
-    strcat(error_str,parameter_count_str);
-    char needed_str[constants::needed_constant_string.length()+1];
-    needed_str[0] = '\0';
-    constants::needed_constant_string.copy(needed_str);
-    strcat(error_str,needed_str);
-    write(constants::data_constant_string,error_str);
+    char * error_str = allocateErrorString();
+    if (error_str)
+    {
+      appendToErrorString(error_str,constants::incorrect_callback_parameter_number_error_data);
+      appendToErrorString(error_str,parameter_count);
+      appendToErrorString(error_str,constants::given_constant_string);
+      appendToErrorString(error_str,parameter_count_needed);
+      appendToErrorString(error_str,constants::needed_constant_string);
+      updateStackHighWater();
+      write(constants::data_constant_string,error_str);
+    }
     write(constants::code_constant_string,constants::invalid_params_error_code);
     endObject();
     error_ = true;
+    error_code_ = constants::invalid_params_error_code;
+  }
+}
+
+char * Response::allocateErrorString()
+{
+  if (!arena_ptr_)
+  {
+    return NULL;
   }
+  return arena_ptr_->allocateString(constants::STRING_LENGTH_ERROR-1);
+}
+
+void Response::appendToErrorString(char * error_str,
+  const ConstantString & constant_string)
+{
+  size_t length = strlen(error_str);
+  if ((length + constant_string.length()) < constants::STRING_LENGTH_ERROR)
+  {
+    constant_string.copy(error_str + length);
+  }
+}
+
+void Response::appendToErrorString(char * error_str,
+  const char * str)
+{
+  size_t length_left = constants::STRING_LENGTH_ERROR - strlen(error_str) - 1;
+  strncat(error_str,str,length_left);
+}
+
+void Response::appendToErrorString(char * error_str,
+  size_t count)
+{
+  char count_str[constants::STRING_LENGTH_PARAMETER_COUNT];
+  count_str[0] = '\0';
+  ultoa(count,count_str,10);
+  appendToErrorString(error_str,(const char *)count_str);
 }
 
 }
@@ -12,6 +12,8 @@
 #include <JsonStream.h>
 
 #include "Constants.h"
+#include "Arena.h"
+#include "FormattedDouble.h"
 
 
 namespace modular_server
@@ -21,12 +23,19 @@ class Response
 public:
   template <typename T>
   void returnResult(T value);
+  void returnResult(double value);
   template <typename T,
     size_t N>
   void returnResult(T (&value)[N]);
+  template <size_t N>
+  void returnResult(double (&value)[N]);
+  template <size_t MAX_SIZE>
+  void returnResult(Array<double,MAX_SIZE> & value);
   template <typename T>
   void returnResult(T * value,
     size_t N);
+  void returnResult(double * value,
+    size_t N);
 
   template <typename T>
   void returnError(T error);
@@ -36,28 +45,50 @@ public:
   void writeKey(K key);
   template <typename T>
   void write(T value);
+  void write(double value);
   template <typename T,
     size_t N>
   void write(T (&value)[N]);
+  template <size_t N>
+  void write(double (&value)[N]);
+  template <size_t MAX_SIZE>
+  void write(Array<double,MAX_SIZE> & value);
   void write(Vector<constants::SubsetMemberType> & value,
     JsonStream::JsonTypes type);
   template <typename K,
     typename T>
   void write(K key,
     T value);
+  template <typename K>
+  void write(K key,
+    double value);
   template <typename K,
     typename T,
     size_t N>
   void write(K key,
     T (&value)[N]);
+  template <typename K,
+    size_t N>
+  void write(K key,
+    double (&value)[N]);
+  template <typename K,
+    size_t MAX_SIZE>
+  void write(K key,
+    Array<double,MAX_SIZE> & value);
   template <typename T>
   void writeArray(T * value,
     size_t N);
+  void writeArray(double * value,
+    size_t N);
   template <typename K,
     typename T>
   void writeArray(K key,
     T * value,
     size_t N);
+  template <typename K>
+  void writeArray(K key,
+    double * value,
+    size_t N);
   void writeNull();
   template <typename K>
   void writeNull(K key);
@@ -67,23 +98,49 @@ public:
   void beginArray();
   void endArray();
 
-  long pipeFrom(Stream & stream);
-  long pipeFrom(JsonStream & json_stream);
+  long pipeFrom(Stream & stream,
+    unsigned long timeout=constants::response_pipe_timeout);
+  long pipeFrom(JsonStream & json_stream,
+    unsigned long timeout=constants::response_pipe_timeout);
+  bool pipeFromAsync(Stream & stream,
+    unsigned long timeout=constants::response_pipe_timeout);
+  bool pipeFromAsync(JsonStream & json_stream,
+    unsigned long timeout=constants::response_pipe_timeout);
 
   bool error();
 
 private:
   JsonStream * json_stream_ptr_;
   bool error_;
+  int error_code_;
   bool result_key_in_response_;
+  const char * stack_top_ptr_;
+  const char * stack_base_ptr_;
+  size_t stack_high_water_;
+  Arena * arena_ptr_;
+  Stream * pipe_stream_ptr_;
+  unsigned long pipe_timeout_;
+  bool pipe_async_enabled_;
+  bool compact_print_;
 
   Response();
   void reset();
   void setJsonStream(JsonStream & json_stream);
+  void setArena(Arena & arena);
   void begin();
   void end();
+  void beginStep();
+  bool endStep();
+  void enablePipeAsync();
+  void disablePipeAsync();
+  void returnPipedResult(const char * result);
   void setCompactPrint();
   void setPrettyPrint();
+  int getErrorCode();
+  void setStackTop(const char * stack_top_ptr);
+  void updateStackHighWater();
+  size_t getStackHighWater();
+  void resetStackHighWater();
   void returnRequestParseError(const char * const request);
   void returnParameterCountError(size_t parameter_count,
     size_t parameter_count_needed);
@@ -101,11 +158,21 @@ private:
     const char * const min_str,
     const char * const max_str);
   void returnPropertyFunctionNotFoundError();
+  void returnApiTableError(const ConstantString * element_name_ptr,
+    const ConstantString & error_data,
+    const ConstantString & name);
   void returnPropertyParameterCountError(size_t parameter_count,
     size_t parameter_count_needed);
   void returnCallbackFunctionNotFoundError();
   void returnCallbackParameterCountError(size_t parameter_count,
     size_t parameter_count_needed);
+  char * allocateErrorString();
+  void appendToErrorString(char * error_str,
+    const ConstantString & constant_string);
+  void appendToErrorString(char * error_str,
+    const char * str);
+  void appendToErrorString(char * error_str,
+    size_t count);
   friend class Server;
   friend class Property;
 };
@@ -15,6 +15,7 @@ namespace modular_server
 template <typename T>
 void Response::returnResult(T value)
 {
+  updateStackHighWater();
   // Prevent multiple results in one response
   if (!result_key_in_response_ && !error_)
   {
@@ -27,6 +28,7 @@ template <typename T,
   size_t N>
 void Response::returnResult(T (&value)[N])
 {
+  updateStackHighWater();
   // Prevent multiple results in one response
   if (!result_key_in_response_ && !error_)
   {
@@ -35,10 +37,23 @@ void Response::returnResult(T (&value)[N])
   }
 }
 
+template <size_t N>
+void Response::returnResult(double (&value)[N])
+{
+  returnResult(value,N);
+}
+
+template <size_t MAX_SIZE>
+void Response::returnResult(Array<double,MAX_SIZE> & value)
+{
+  returnResult(value.data(),value.size());
+}
+
 template <typename T>
 void Response::returnResult(T * value,
   size_t N)
 {
+  updateStackHighWater();
   // Prevent multiple results in one response
   if (!result_key_in_response_ && !error_)
   {
@@ -60,6 +75,7 @@ void Response::returnError(T error)
     write(constants::code_constant_string,constants::server_error_error_code);
     endObject();
     error_ = true;
+    error_code_ = constants::server_error_error_code;
   }
 }
 
@@ -94,6 +110,18 @@ void Response::write(T (&value)[N])
   json_stream_ptr_->write(value);
 }
 
+template <size_t N>
+void Response::write(double (&value)[N])
+{
+  writeArray(value,N);
+}
+
+template <size_t MAX_SIZE>
+void Response::write(Array<double,MAX_SIZE> & value)
+{
+  writeArray(value.data(),value.size());
+}
+
 template <typename K,
   typename T>
 void Response::write(K key,
@@ -106,6 +134,17 @@ void Response::write(K key,
   json_stream_ptr_->write(key,value);
 }
 
+template <typename K>
+void Response::write(K key,
+  double value)
+{
+  if (error_)
+  {
+    return;
+  }
+  json_stream_ptr_->write(key,FormattedDouble(value));
+}
+
 template <typename K,
   typename T,
   size_t N>
@@ -119,6 +158,22 @@ void Response::write(K key,
   json_stream_ptr_->write(key,value);
 }
 
+template <typename K,
+  size_t N>
+void Response::write(K key,
+  double (&value)[N])
+{
+  writeArray(key,value,N);
+}
+
+template <typename K,
+  size_t MAX_SIZE>
+void Response::write(K key,
+  Array<double,MAX_SIZE> & value)
+{
+  writeArray(key,value.data(),value.size());
+}
+
 template <typename T>
 void Response::writeArray(T * value,
   size_t N)
@@ -143,6 +198,19 @@ void Response::writeArray(K key,
   json_stream_ptr_->writeArray(key,value,N);
 }
 
+template <typename K>
+void Response::writeArray(K key,
+  double * value,
+  size_t N)
+{
+  if (error_)
+  {
+    return;
+  }
+  json_stream_ptr_->writeKey(key);
+  writeArray(value,N);
+}
+
 template <typename K>
 void Response::writeNull(K key)
 {
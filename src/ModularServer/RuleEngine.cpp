@@ -0,0 +1,215 @@
+// ----------------------------------------------------------------------------
+// RuleEngine.cpp
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#include "RuleEngine.h"
+#include "Pin.h"
+#include "Property.h"
+#include "Callback.h"
+
+
+namespace modular_server
+{
+#if MODULAR_SERVER_RULE_COUNT_MAX > 0
+// public
+RuleEngine::RuleEngine()
+{
+  for (size_t i=0; i<constants::RULE_COUNT_MAX; ++i)
+  {
+    rules_[i].active = false;
+  }
+  pin_rule_count_ = 0;
+  property_rule_count_ = 0;
+  property_rules_running_ = false;
+}
+
+int RuleEngine::add(const Rule & rule)
+{
+  int rule_id = -1;
+  for (size_t i=0; i<constants::RULE_COUNT_MAX; ++i)
+  {
+    if (!rules_[i].active)
+    {
+      rule_id = i;
+      break;
+    }
+  }
+  if (rule_id < 0)
+  {
+    return rule_id;
+  }
+  Rule new_rule = rule;
+  new_rule.hit_count = 0;
+  new_rule.latency = 0;
+  new_rule.latency_max = 0;
+  // property rules fire on crossings, not on values already past the threshold
+  new_rule.condition_met = conditionMet(new_rule);
+  new_rule.active = true;
+
+  noInterrupts();
+  rules_[rule_id] = new_rule;
+  if (new_rule.condition == constants::RULE_CONDITION_PIN)
+  {
+    ++pin_rule_count_;
+  }
+  else
+  {
+    ++property_rule_count_;
+  }
+  interrupts();
+  return rule_id;
+}
+
+void RuleEngine::remove(size_t rule_id)
+{
+  if ((rule_id >= constants::RULE_COUNT_MAX) || !rules_[rule_id].active)
+  {
+    return;
+  }
+  noInterrupts();
+  rules_[rule_id].active = false;
+  if (rules_[rule_id].condition == constants::RULE_CONDITION_PIN)
+  {
+    --pin_rule_count_;
+  }
+  else
+  {
+    --property_rule_count_;
+  }
+  interrupts();
+}
+
+void RuleEngine::removePinRules(Pin & pin)
+{
+  for (size_t i=0; i<constants::RULE_COUNT_MAX; ++i)
+  {
+    if (rules_[i].active &&
+      ((rules_[i].condition_pin_ptr == &pin) || (rules_[i].action_pin_ptr == &pin)))
+    {
+      remove(i);
+    }
+  }
+}
+
+bool RuleEngine::getRule(size_t rule_id,
+  Rule & rule)
+{
+  if (rule_id >= constants::RULE_COUNT_MAX)
+  {
+    return false;
+  }
+  noInterrupts();
+  rule = rules_[rule_id];
+  interrupts();
+  return rule.active;
+}
+
+void RuleEngine::pinTriggered(Pin & pin)
+{
+  if (pin_rule_count_ == 0)
+  {
+    return;
+  }
+  unsigned long time = micros();
+  for (size_t i=0; i<constants::RULE_COUNT_MAX; ++i)
+  {
+    Rule & rule = rules_[i];
+    if (rule.active &&
+      (rule.condition == constants::RULE_CONDITION_PIN) &&
+      (rule.condition_pin_ptr == &pin))
+    {
+      fire(rule,&pin,time);
+    }
+  }
+}
+
+void RuleEngine::propertySet(Property & property)
+{
+  // an action setting a property does not run property rules again
+  if ((property_rule_count_ == 0) || property_rules_running_)
+  {
+    return;
+  }
+  unsigned long time = micros();
+  property_rules_running_ = true;
+  for (size_t i=0; i<constants::RULE_COUNT_MAX; ++i)
+  {
+    Rule & rule = rules_[i];
+    if (!rule.active ||
+      (rule.condition == constants::RULE_CONDITION_PIN) ||
+      (rule.condition_property_ptr != &property))
+    {
+      continue;
+    }
+    bool condition_met = conditionMet(rule);
+    if (condition_met && !rule.condition_met)
+    {
+      fire(rule,NULL,time);
+    }
+    rule.condition_met = condition_met;
+  }
+  property_rules_running_ = false;
+}
+
+// setting a pin in a pulse mode adds pulse events, which is not done from
+// an interrupt, so actions only set output pins
+bool RuleEngine::pinModeIsOutput(Pin & pin)
+{
+  const ConstantString & mode = pin.getMode();
+  return ((&mode == &constants::pin_mode_digital_output) ||
+    (&mode == &constants::pin_mode_analog_output));
+}
+
+// private
+bool RuleEngine::conditionMet(Rule & rule)
+{
+  if (rule.condition == constants::RULE_CONDITION_PIN)
+  {
+    return false;
+  }
+  double value;
+  long long_value;
+  if (rule.condition_property_ptr->getValue(long_value))
+  {
+    value = long_value;
+  }
+  else if (!rule.condition_property_ptr->getValue(value))
+  {
+    return false;
+  }
+  if (rule.condition == constants::RULE_CONDITION_PROPERTY_ABOVE)
+  {
+    return value > rule.threshold;
+  }
+  return value < rule.threshold;
+}
+
+void RuleEngine::fire(Rule & rule,
+  Pin * pin_ptr,
+  unsigned long time)
+{
+  if (rule.action == constants::RULE_ACTION_SET_PIN_VALUE)
+  {
+    // the pin mode may have been changed since the rule was added
+    if (pinModeIsOutput(*rule.action_pin_ptr))
+    {
+      rule.action_pin_ptr->setValue(rule.action_value);
+    }
+  }
+  else
+  {
+    rule.action_callback_ptr->functor(pin_ptr);
+  }
+  unsigned long latency = micros() - time;
+  ++rule.hit_count;
+  rule.latency = latency;
+  if (latency > rule.latency_max)
+  {
+    rule.latency_max = latency;
+  }
+}
+#endif
+}
@@ -0,0 +1,72 @@
+// ----------------------------------------------------------------------------
+// RuleEngine.h
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_RULE_ENGINE_H_
+#define _MODULAR_SERVER_RULE_ENGINE_H_
+#include <Arduino.h>
+
+#include "Constants.h"
+
+
+namespace modular_server
+{
+#if MODULAR_SERVER_RULE_COUNT_MAX > 0
+class Pin;
+class Property;
+class Callback;
+
+// durations in microseconds
+struct Rule
+{
+  constants::RuleCondition condition;
+  Pin * condition_pin_ptr;
+  Property * condition_property_ptr;
+  double threshold;
+  bool condition_met;
+  constants::RuleAction action;
+  Pin * action_pin_ptr;
+  Callback * action_callback_ptr;
+  long action_value;
+  unsigned long hit_count;
+  unsigned long latency;
+  unsigned long latency_max;
+  bool active;
+};
+
+// Condition and action pairs checked where the condition happens, in the pin
+// interrupt or after a property value is set, so actions need no request
+class RuleEngine
+{
+public:
+  RuleEngine();
+
+  int add(const Rule & rule);
+  void remove(size_t rule_id);
+  void removePinRules(Pin & pin);
+  bool getRule(size_t rule_id,
+    Rule & rule);
+
+  void pinTriggered(Pin & pin);
+  void propertySet(Property & property);
+
+  static bool pinModeIsOutput(Pin & pin);
+
+private:
+  Rule rules_[constants::RULE_COUNT_MAX];
+  volatile size_t pin_rule_count_;
+  size_t property_rule_count_;
+  bool property_rules_running_;
+
+  bool conditionMet(Rule & rule);
+  void fire(Rule & rule,
+    Pin * pin_ptr,
+    unsigned long time);
+};
+#endif
+}
+
+#endif
@@ -22,6 +22,44 @@ void Server::setup()
   property_function_index_ = -1;
   callback_function_index_ = -1;
   server_stream_index_ = 0;
+  response_frame_open_ = false;
+  pipe_forward_sequence_ = 0;
+  for (size_t i=0; i<constants::SERVER_STREAM_COUNT_MAX; ++i)
+  {
+    response_framing_[i] = false;
+  }
+
+  api_table_error_data_ptr_ = NULL;
+  api_table_element_name_ptr_ = NULL;
+  api_table_name_ptr_ = NULL;
+
+#if MODULAR_SERVER_REQUEST_TRACE_COUNT_MAX > 0
+  request_trace_index_ = 0;
+  request_count_ = 0;
+#endif
+
+  timing_monitor_enabled_ = false;
+  loop_period_deadline_ = 0;
+  resetTimingMonitor();
+
+  request_length_max_ = 0;
+  json_document_usage_max_ = 0;
+
+#if MODULAR_SERVER_SEQUENCE_COUNT_MAX > 0
+  for (size_t i=0; i<constants::SEQUENCE_COUNT_MAX; ++i)
+  {
+    sequences_[i].name[0] = '\0';
+    sequences_[i].steps[0] = '\0';
+  }
+  sequence_running_ = false;
+#endif
+
+#if MODULAR_SERVER_TELEMETRY_COUNT_MAX > 0
+  for (size_t i=0; i<constants::TELEMETRY_COUNT_MAX; ++i)
+  {
+    telemetry_[i].active = false;
+  }
+#endif
 
   eeprom_initialized_ = false;
 
@@ -33,6 +71,41 @@ void Server::setup()
   // Streams
   response_.setJsonStream(server_json_stream_);
 
+  // Request Arena
+  request_arena_.setStorage(request_arena_storage_);
+  framed_stream_.setArena(request_arena_);
+  response_.setArena(request_arena_);
+
+  // Stack
+  response_.resetStackHighWater();
+
+  // Context
+  context_.arena_ptr = &request_arena_;
+  context_.response_ptr = &response_;
+  context_.get_parameter_value_functor = makeFunctor((Functor1wRet<const ConstantString &,ArduinoJson::JsonVariant> *)0,*this,&Server::getParameterValue);
+  context_.pin_name_array_ptr = &pin_name_array_;
+  context_.pin_index_ptr = &pin_index_;
+  context_.property_tables_ptr = &property_tables_;
+  context_.callback_tables_ptr = &callback_tables_;
+#if MODULAR_SERVER_RULE_COUNT_MAX > 0
+  context_.rule_engine_ptr = &rule_engine_;
+#else
+  context_.rule_engine_ptr = NULL;
+#endif
+  dummy_pin_.setContext(context_);
+  dummy_property_.setContext(context_);
+  dummy_parameter_.setContext(context_);
+  dummy_function_.setContext(context_);
+  dummy_callback_.setContext(context_);
+
+  // Element Indexes
+  pins_.setElements(pin_arrays_);
+  pin_index_.setPins(pins_);
+  properties_.setElements(property_arrays_);
+  parameters_.setElements(parameter_arrays_);
+  functions_.setElements(function_arrays_);
+  callbacks_.setElements(callback_arrays_);
+
   // Device ID
   setDeviceName(constants::empty_constant_string);
   setFormFactor(constants::empty_constant_string);
@@ -49,18 +122,14 @@ void Server::setup()
     server_callbacks_);
 
   // Properties
-  Property::response_ptr_ = &response_;
-  Property::get_parameter_value_functor_ = makeFunctor((Functor1wRet<const ConstantString &,ArduinoJson::JsonVariant> *)0,*this,&Server::getParameterValue);
-
   Property & serial_number_property = createProperty(constants::serial_number_property_name,constants::serial_number_default);
   serial_number_property.setRange(constants::serial_number_min,constants::serial_number_max);
 
   // Parameters
-  Parameter::get_value_functor_ = makeFunctor((Functor1wRet<const ConstantString &,ArduinoJson::JsonVariant> *)0,*this,&Server::getParameterValue);
-
   Parameter & firmware_parameter = createParameter(constants::firmware_constant_string);
   firmware_parameter.setTypeString();
   firmware_parameter.setArrayLengthRange(1,constants::FIRMWARE_COUNT_MAX);
+  firmware_parameter.setSubsetIndexStorage(firmware_name_subset_index_);
   firmware_parameter.setSubset(firmware_name_array_.data(),
     firmware_name_array_.max_size(),
     firmware_name_array_.size());
@@ -71,6 +140,7 @@ void Server::setup()
 
   Parameter & pin_name_parameter = createParameter(constants::pin_name_parameter_name);
   pin_name_parameter.setTypeString();
+  pin_name_parameter.setSubsetIndexStorage(pin_name_subset_index_);
   pin_name_parameter.setSubset(pin_name_array_.data(),
     pin_name_array_.max_size(),
     pin_name_array_.size());
@@ -82,6 +152,69 @@ void Server::setup()
   Parameter & pin_value_parameter = createParameter(constants::pin_value_parameter_name);
   pin_value_parameter.setRange(constants::pin_value_min,constants::pin_value_max);
 
+  Parameter & response_framing_parameter = createParameter(constants::response_framing_parameter_name);
+  response_framing_parameter.setTypeBool();
+
+#if MODULAR_SERVER_SEQUENCE_COUNT_MAX > 0
+  Parameter & sequence_name_parameter = createParameter(constants::sequence_name_parameter_name);
+  sequence_name_parameter.setTypeString();
+
+  Parameter & sequence_steps_parameter = createParameter(constants::sequence_steps_parameter_name);
+  sequence_steps_parameter.setTypeArray();
+  sequence_steps_parameter.setTypeAny();
+  sequence_steps_parameter.setArrayLengthRange(0,constants::SEQUENCE_STEP_COUNT_MAX);
+
+  Parameter & sequence_arguments_parameter = createParameter(constants::sequence_arguments_parameter_name);
+  sequence_arguments_parameter.setTypeArray();
+  sequence_arguments_parameter.setTypeAny();
+  sequence_arguments_parameter.setArrayLengthRange(0,constants::SEQUENCE_ARGUMENT_COUNT_MAX);
+#endif
+
+#if MODULAR_SERVER_TELEMETRY_COUNT_MAX > 0
+  Parameter & telemetry_request_parameter = createParameter(constants::telemetry_request_parameter_name);
+  telemetry_request_parameter.setTypeArray();
+  telemetry_request_parameter.setTypeAny();
+  telemetry_request_parameter.setArrayLengthRange(1,constants::FUNCTION_PARAMETER_COUNT_MAX+1);
+
+  Parameter & telemetry_period_parameter = createParameter(constants::telemetry_period_parameter_name);
+  telemetry_period_parameter.setRange(constants::telemetry_period_min,constants::telemetry_period_max);
+  telemetry_period_parameter.setUnits(constants::ms_units);
+
+  Parameter & telemetry_id_parameter = createParameter(constants::telemetry_id_parameter_name);
+  telemetry_id_parameter.setRange((long)0,(long)(constants::TELEMETRY_COUNT_MAX-1));
+#endif
+
+#if MODULAR_SERVER_RULE_COUNT_MAX > 0
+  Parameter & rule_condition_parameter = createParameter(constants::rule_condition_parameter_name);
+  rule_condition_parameter.setTypeArray();
+  rule_condition_parameter.setTypeAny();
+  rule_condition_parameter.setArrayLengthRange(2,4);
+
+  Parameter & rule_action_parameter = createParameter(constants::rule_action_parameter_name);
+  rule_action_parameter.setTypeArray();
+  rule_action_parameter.setTypeAny();
+  rule_action_parameter.setArrayLengthRange(2,3);
+
+  Parameter & rule_id_parameter = createParameter(constants::rule_id_parameter_name);
+  rule_id_parameter.setRange((long)0,(long)(constants::RULE_COUNT_MAX-1));
+#endif
+
+#if MODULAR_SERVER_WAVEFORM_CHANNEL_COUNT_MAX > 0
+  Parameter & waveform_pins_parameter = createParameter(constants::waveform_pins_parameter_name);
+  waveform_pins_parameter.setTypeArray();
+  waveform_pins_parameter.setTypeString();
+  waveform_pins_parameter.setArrayLengthRange(1,constants::WAVEFORM_CHANNEL_COUNT_MAX);
+
+  Parameter & waveform_period_parameter = createParameter(constants::waveform_period_parameter_name);
+  waveform_period_parameter.setRange(constants::waveform_period_min,constants::waveform_period_max);
+  waveform_period_parameter.setUnits(constants::ms_units);
+
+  Parameter & waveform_samples_parameter = createParameter(constants::waveform_samples_parameter_name);
+  waveform_samples_parameter.setTypeArray();
+  waveform_samples_parameter.setTypeLong();
+  waveform_samples_parameter.setArrayLengthRange(1,constants::WAVEFORM_BLOCK_SAMPLE_COUNT_MAX);
+#endif
+
   // Functions
   Function & get_method_ids_function = createFunction(constants::get_method_ids_function_name);
   get_method_ids_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Server::getMethodIdsHandler));
@@ -148,18 +281,104 @@ void Server::setup()
   set_pin_value_function.addParameter(pin_value_parameter);
   set_pin_value_function.setResultTypeLong();
 
+#if MODULAR_SERVER_REQUEST_TRACE_COUNT_MAX > 0
+  Function & get_request_trace_function = createFunction(constants::get_request_trace_function_name);
+  get_request_trace_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Server::getRequestTraceHandler));
+  get_request_trace_function.setResultTypeArray();
+  get_request_trace_function.setResultTypeObject();
+#endif
+
+  Function & get_timing_info_function = createFunction(constants::get_timing_info_function_name);
+  get_timing_info_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Server::getTimingInfoHandler));
+  get_timing_info_function.setResultTypeObject();
+
+  Function & get_memory_usage_function = createFunction(constants::get_memory_usage_function_name);
+  get_memory_usage_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Server::getMemoryUsageHandler));
+  get_memory_usage_function.setResultTypeObject();
+
+  Function & reset_stack_high_water_function = createFunction(constants::reset_stack_high_water_function_name);
+  reset_stack_high_water_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Server::resetStackHighWaterHandler));
+
+  Function & set_response_framing_function = createFunction(constants::set_response_framing_function_name);
+  set_response_framing_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Server::setResponseFramingHandler));
+  set_response_framing_function.addParameter(response_framing_parameter);
+
+#if MODULAR_SERVER_SEQUENCE_COUNT_MAX > 0
+  Function & set_sequence_function = createFunction(constants::set_sequence_function_name);
+  set_sequence_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Server::setSequenceHandler));
+  set_sequence_function.addParameter(sequence_name_parameter);
+  set_sequence_function.addParameter(sequence_steps_parameter);
+
+  Function & run_sequence_function = createFunction(constants::run_sequence_function_name);
+  run_sequence_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Server::runSequenceHandler));
+  run_sequence_function.addParameter(sequence_name_parameter);
+  run_sequence_function.addParameter(sequence_arguments_parameter);
+  run_sequence_function.setResultTypeArray();
+  run_sequence_function.setResultTypeObject();
+
+  Function & get_sequences_function = createFunction(constants::get_sequences_function_name);
+  get_sequences_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Server::getSequencesHandler));
+  get_sequences_function.setResultTypeArray();
+  get_sequences_function.setResultTypeString();
+#endif
+
+#if MODULAR_SERVER_TELEMETRY_COUNT_MAX > 0
+  Function & add_telemetry_function = createFunction(constants::add_telemetry_function_name);
+  add_telemetry_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Server::addTelemetryHandler));
+  add_telemetry_function.addParameter(telemetry_request_parameter);
+  add_telemetry_function.addParameter(telemetry_period_parameter);
+  add_telemetry_function.setResultTypeLong();
+
+  Function & remove_telemetry_function = createFunction(constants::remove_telemetry_function_name);
+  remove_telemetry_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Server::removeTelemetryHandler));
+  remove_telemetry_function.addParameter(telemetry_id_parameter);
+#endif
+
+#if MODULAR_SERVER_RULE_COUNT_MAX > 0
+  Function & add_rule_function = createFunction(constants::add_rule_function_name);
+  add_rule_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Server::addRuleHandler));
+  add_rule_function.addParameter(rule_condition_parameter);
+  add_rule_function.addParameter(rule_action_parameter);
+  add_rule_function.setResultTypeLong();
+
+  Function & remove_rule_function = createFunction(constants::remove_rule_function_name);
+  remove_rule_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Server::removeRuleHandler));
+  remove_rule_function.addParameter(rule_id_parameter);
+
+  Function & get_rules_function = createFunction(constants::get_rules_function_name);
+  get_rules_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Server::getRulesHandler));
+  get_rules_function.setResultTypeArray();
+  get_rules_function.setResultTypeObject();
+#endif
+
+#if MODULAR_SERVER_WAVEFORM_CHANNEL_COUNT_MAX > 0
+  Function & setup_waveform_function = createFunction(constants::setup_waveform_function_name);
+  setup_waveform_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Server::setupWaveformHandler));
+  setup_waveform_function.addParameter(waveform_pins_parameter);
+  setup_waveform_function.addParameter(waveform_period_parameter);
+
+  Function & add_waveform_samples_function = createFunction(constants::add_waveform_samples_function_name);
+  add_waveform_samples_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Server::addWaveformSamplesHandler));
+  add_waveform_samples_function.addParameter(waveform_samples_parameter);
+  add_waveform_samples_function.setResultTypeLong();
+
+  Function & play_waveform_function = createFunction(constants::play_waveform_function_name);
+  play_waveform_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Server::playWaveformHandler));
+
+  Function & stop_waveform_function = createFunction(constants::stop_waveform_function_name);
+  stop_waveform_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Server::stopWaveformHandler));
+
+  Function & get_waveform_status_function = createFunction(constants::get_waveform_status_function_name);
+  get_waveform_status_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Server::getWaveformStatusHandler));
+  get_waveform_status_function.setResultTypeObject();
+#endif
+
 #ifdef __AVR__
   Function & get_memory_free_function = createFunction(constants::get_memory_free_function_name);
   get_memory_free_function.attachFunctor(makeFunctor((Functor0 *)0,*this,&Server::getMemoryFreeHandler));
   get_memory_free_function.setResultTypeLong();
 #endif
 
-  // Callbacks
-  Callback::pin_name_array_ptr_ = &pin_name_array_;
-  Callback::find_pin_ptr_by_chars_functor_ = makeFunctor((Functor1wRet<const char *,Pin *> *)0,*this,&Server::findPinPtrByChars);
-  Callback::find_pin_ptr_by_constant_string_functor_ = makeFunctor((Functor1wRet<const ConstantString &,Pin *> *)0,*this,&Server::findPinPtrByConstantString);
-  Callback::get_parameter_value_functor_ = makeFunctor((Functor1wRet<const ConstantString &,ArduinoJson::JsonVariant> *)0,*this,&Server::getParameterValue);
-
   // Server
   server_running_ = false;
 }
@@ -198,7 +417,7 @@ void Server::removeHardware()
   if (hardware_info_array_.size() > 0)
   {
     size_t index = hardware_info_array_.size() - 1;
-    Vector<Pin> & pins = pins_.subVector(index);
+    Vector<Pin> & pins = pin_arrays_.subVector(index);
     for (size_t j=0; j<pins.size(); ++j)
     {
       pin_name_array_.pop_back();
@@ -212,9 +431,14 @@ void Server::removeHardware()
       {
         callback_ptr->detachFrom(pin);
       }
+#if MODULAR_SERVER_RULE_COUNT_MAX > 0
+      rule_engine_.removePinRules(pin);
+#endif
     }
 
-    pins_.removeArray();
+    pin_arrays_.removeArray();
+    pins_.rebuild();
+    pin_index_.rebuild();
     hardware_info_array_.pop_back();
   }
 }
@@ -233,9 +457,12 @@ Pin & Server::createPin(const ConstantString & pin_name,
     pin_name_parameter.setSubset(pin_name_array_.data(),
       pin_name_array_.max_size(),
       pin_name_array_.size());
-    pins_.push_back(Pin(pin_name,pin_number));
+    pin_arrays_.push_back(Pin(pin_name,pin_number));
+    pins_.update();
+    pin_index_.update();
     const ConstantString * hardware_name_ptr = hardware_info_array_.back()->name_ptr;
     pins_.back().setHardwareName(*hardware_name_ptr);
+    pins_.back().setContext(context_);
     return pins_.back();
   }
   return dummy_pin_;
@@ -251,16 +478,6 @@ Pin & Server::pin(const ConstantString & pin_name)
   return dummy_pin_;
 }
 
-Pin * Server::findPinPtrByChars(const char * pin_name)
-{
-  int pin_index = findPinIndex(pin_name);
-  if ((pin_index >= 0) && (pin_index < (int)pins_.size()))
-  {
-    return &pins_[pin_index];
-  }
-  return NULL;
-}
-
 Pin * Server::findPinPtrByConstantString(const ConstantString & pin_name)
 {
   int pin_index = findPinIndex(pin_name);
@@ -319,6 +536,426 @@ void Server::setPinValue(const ConstantString & pin_name,
   return pin_ptr->setValue(pin_value);
 }
 
+#if MODULAR_SERVER_REQUEST_TRACE_COUNT_MAX > 0
+void Server::beginRequestTrace()
+{
+  request_trace_phase_time_ = micros();
+  request_trace_.request_number = request_count_;
+  request_trace_.time = millis();
+  request_trace_.method_index = -1;
+  request_trace_.stream_index = server_stream_index_;
+  request_trace_.bytes_read = 0;
+  request_trace_.error_code = 0;
+  request_trace_.read_duration = 0;
+  request_trace_.sanitize_duration = 0;
+  request_trace_.deserialize_duration = 0;
+  request_trace_.lookup_duration = 0;
+  request_trace_.check_duration = 0;
+  request_trace_.handler_duration = 0;
+  request_trace_.end_duration = 0;
+}
+
+unsigned long Server::endRequestTracePhase()
+{
+  unsigned long time = micros();
+  unsigned long phase_duration = time - request_trace_phase_time_;
+  request_trace_phase_time_ = time;
+  return phase_duration;
+}
+
+void Server::endRequestTrace()
+{
+  request_trace_.error_code = response_.getErrorCode();
+  request_traces_[request_trace_index_] = request_trace_;
+  request_trace_index_ = (request_trace_index_ + 1) % constants::REQUEST_TRACE_COUNT_MAX;
+  ++request_count_;
+}
+#endif
+
+void Server::updateLoopPeriod(unsigned long time)
+{
+  unsigned long loop_period = time - loop_time_;
+  loop_time_ = time;
+  ++loop_count_;
+  if (loop_period > loop_period_max_)
+  {
+    loop_period_max_ = loop_period;
+  }
+  if ((loop_period_deadline_ > 0) && (loop_period > loop_period_deadline_))
+  {
+    ++deadline_miss_count_;
+  }
+  size_t bin = 0;
+  unsigned long period = loop_period >> 1;
+  while ((period > 0) && (bin < (constants::LOOP_PERIOD_HISTOGRAM_BIN_COUNT - 1)))
+  {
+    period >>= 1;
+    ++bin;
+  }
+  ++loop_period_histogram_[bin];
+}
+
+void Server::updateServerDuration(unsigned long server_duration)
+{
+  if (server_duration > server_duration_max_)
+  {
+    server_duration_max_ = server_duration;
+  }
+}
+
+void Server::writeTimingInfoToResponse()
+{
+  if (response_.error())
+  {
+    return;
+  }
+
+  response_.beginObject();
+
+  response_.write(constants::timing_monitor_enabled_constant_string,timing_monitor_enabled_);
+  response_.write(constants::loop_count_constant_string,loop_count_);
+  response_.write(constants::loop_period_max_constant_string,loop_period_max_);
+  response_.write(constants::loop_period_deadline_constant_string,loop_period_deadline_);
+  response_.write(constants::deadline_miss_count_constant_string,deadline_miss_count_);
+  response_.write(constants::server_duration_max_constant_string,server_duration_max_);
+  response_.write(constants::loop_period_histogram_constant_string,loop_period_histogram_);
+
+  response_.writeKey(constants::pins_constant_string);
+  response_.beginArray();
+  for (size_t i=0; i<pins_.size(); ++i)
+  {
+    Pin & pin = pins_[i];
+    if (pin.getCallbackPtr())
+    {
+      response_.beginObject();
+      response_.write(constants::name_constant_string,pin.getName());
+      response_.write(constants::callback_duration_max_constant_string,pin.getCallbackDurationMax());
+      response_.endObject();
+    }
+  }
+  response_.endArray();
+
+  response_.endObject();
+}
+
+void Server::writeUsageToResponse(const ConstantString & key,
+  size_t used,
+  size_t max)
+{
+  response_.writeKey(key);
+  response_.beginObject();
+  response_.write(constants::used_constant_string,used);
+  response_.write(constants::max_constant_string,max);
+  response_.endObject();
+}
+
+void Server::writeSubsetUsageToResponse(Parameter & parameter)
+{
+  if (!parameter.subsetIsSet())
+  {
+    return;
+  }
+  response_.beginObject();
+  response_.write(constants::name_constant_string,parameter.getName());
+  response_.write(constants::used_constant_string,parameter.getSubsetSize());
+  response_.write(constants::max_constant_string,parameter.getSubsetMaxSize());
+  response_.endObject();
+}
+
+void Server::writeMemoryUsageToResponse()
+{
+  if (response_.error())
+  {
+    return;
+  }
+
+  response_.beginObject();
+
+  writeUsageToResponse(constants::firmware_constant_string,firmware_info_array_.size(),firmware_info_array_.max_size());
+  writeUsageToResponse(constants::hardware_constant_string,hardware_info_array_.size(),hardware_info_array_.max_size());
+  writeUsageToResponse(constants::properties_constant_string,properties_.size(),properties_.max_size());
+  writeUsageToResponse(constants::parameters_constant_string,parameters_.size(),parameters_.max_size());
+  writeUsageToResponse(constants::functions_constant_string,functions_.size(),functions_.max_size());
+  writeUsageToResponse(constants::callbacks_constant_string,callbacks_.size(),callbacks_.max_size());
+  writeUsageToResponse(constants::pins_constant_string,pins_.size(),pins_.max_size());
+  writeUsageToResponse(constants::streams_constant_string,server_stream_ptrs_.size(),server_stream_ptrs_.max_size());
+  writeUsageToResponse(constants::request_constant_string,request_length_max_,constants::STRING_LENGTH_REQUEST-1);
+  writeUsageToResponse(constants::json_document_constant_string,json_document_usage_max_,constants::JSON_DOCUMENT_SIZE);
+  writeUsageToResponse(constants::arena_constant_string,request_arena_.getHighWater(),request_arena_.getSize());
+
+  response_.writeKey(constants::subsets_constant_string);
+  response_.beginArray();
+  for (size_t i=0; i<parameters_.size(); ++i)
+  {
+    writeSubsetUsageToResponse(parameters_[i]);
+  }
+  for (size_t i=0; i<properties_.size(); ++i)
+  {
+    writeSubsetUsageToResponse(properties_[i].parameter());
+  }
+  response_.endArray();
+
+  response_.write(constants::stack_high_water_constant_string,response_.getStackHighWater());
+
+#ifdef __AVR__
+  response_.write(constants::memory_free_constant_string,freeMemory());
+#endif
+
+  response_.endObject();
+}
+
+#if MODULAR_SERVER_REQUEST_TRACE_COUNT_MAX > 0
+void Server::writeRequestTraceToResponse(const constants::RequestTrace & request_trace)
+{
+  if (response_.error())
+  {
+    return;
+  }
+
+  response_.beginObject();
+
+  response_.write(constants::request_number_constant_string,request_trace.request_number);
+  response_.write(constants::time_constant_string,request_trace.time);
+  response_.write(constants::method_index_constant_string,request_trace.method_index);
+  response_.write(constants::stream_index_constant_string,request_trace.stream_index);
+  response_.write(constants::bytes_read_constant_string,request_trace.bytes_read);
+  response_.write(constants::error_code_constant_string,request_trace.error_code);
+  response_.write(constants::read_duration_constant_string,request_trace.read_duration);
+  response_.write(constants::sanitize_duration_constant_string,request_trace.sanitize_duration);
+  response_.write(constants::deserialize_duration_constant_string,request_trace.deserialize_duration);
+  response_.write(constants::lookup_duration_constant_string,request_trace.lookup_duration);
+  response_.write(constants::check_duration_constant_string,request_trace.check_duration);
+  response_.write(constants::handler_duration_constant_string,request_trace.handler_duration);
+  response_.write(constants::end_duration_constant_string,request_trace.end_duration);
+
+  response_.endObject();
+}
+#endif
+
+#if MODULAR_SERVER_SEQUENCE_COUNT_MAX > 0
+int Server::findSequenceIndex(const char * sequence_name)
+{
+  int sequence_index = -1;
+  for (size_t i=0; i<constants::SEQUENCE_COUNT_MAX; ++i)
+  {
+    if ((sequences_[i].name[0] != '\0') && (strcmp(sequences_[i].name,sequence_name) == 0))
+    {
+      sequence_index = i;
+      break;
+    }
+  }
+  return sequence_index;
+}
+
+bool Server::sequenceStepsValid(ArduinoJson::JsonArray sequence_steps)
+{
+  for (ArduinoJson::JsonVariant step : sequence_steps)
+  {
+    if (!step.is<ArduinoJson::JsonArray>() || (step.as<ArduinoJson::JsonArray>().size() == 0))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+void Server::replaceSequencePlaceholders(ArduinoJson::JsonArray request_array,
+  ArduinoJson::JsonArray sequence_arguments)
+{
+  for (ArduinoJson::JsonVariant element : request_array)
+  {
+    if (element.is<ArduinoJson::JsonArray>())
+    {
+      replaceSequencePlaceholders(element.as<ArduinoJson::JsonArray>(),sequence_arguments);
+    }
+    else if (element.is<const char *>())
+    {
+      const char * element_str = element.as<const char *>();
+      if ((element_str[0] == '$') &&
+        (element_str[1] >= '0') && (element_str[1] <= '9') &&
+        (element_str[2] == '\0'))
+      {
+        size_t argument_index = element_str[1] - '0';
+        if (argument_index < sequence_arguments.size())
+        {
+          element.set(sequence_arguments[argument_index]);
+        }
+      }
+    }
+  }
+}
+#endif
+
+#if MODULAR_SERVER_TELEMETRY_COUNT_MAX > 0
+void Server::updateTelemetry()
+{
+  unsigned long time = millis();
+  for (size_t i=0; i<constants::TELEMETRY_COUNT_MAX; ++i)
+  {
+    constants::Telemetry & telemetry = telemetry_[i];
+    if (!telemetry.active ||
+      (telemetry.stream_index >= server_stream_ptrs_.size()) ||
+      pipe_forwards_[telemetry.stream_index].active() ||
+      ((long)(time - telemetry.next_time) < 0))
+    {
+      continue;
+    }
+    // late telemetry is rescheduled instead of caught up in a burst
+    telemetry.next_time += telemetry.period;
+    if ((long)(time - telemetry.next_time) >= 0)
+    {
+      telemetry.next_time = time + telemetry.period;
+    }
+    writeTelemetry(i,time);
+    return;
+  }
+}
+
+void Server::writeTelemetry(size_t telemetry_id,
+  unsigned long time)
+{
+  constants::Telemetry & telemetry = telemetry_[telemetry_id];
+  size_t server_stream_index = server_stream_index_;
+  server_stream_index_ = telemetry.stream_index;
+  server_json_stream_.setStream(*server_stream_ptrs_[server_stream_index_]);
+  response_.setStackTop((const char *)__builtin_frame_address(0));
+
+  // parsed from a const string so the stored request is copied, not modified
+  ArenaJsonDocument json_document(constants::JSON_DOCUMENT_SIZE,ArenaAllocator(&request_arena_));
+  const char * request = telemetry.request;
+  ArduinoJson::DeserializationError error = deserializeJson(json_document,request);
+
+  response_.setCompactPrint();
+  beginResponseFrame();
+  response_.begin();
+  response_.write(constants::telemetry_constant_string,telemetry_id);
+  response_.write(constants::sequence_constant_string,telemetry.sequence++);
+  response_.write(constants::time_constant_string,time);
+  if (!error)
+  {
+    // telemetry results are written directly, never forwarded from a pipe
+    request_json_array_ = json_document.as<ArduinoJson::JsonArray>();
+    response_.disablePipeAsync();
+    processRequestArray();
+    response_.enablePipeAsync();
+  }
+  else
+  {
+    response_.returnRequestParseError(request);
+  }
+  response_.end();
+  endResponseFrame();
+  response_.setStackTop(NULL);
+
+  server_stream_index_ = server_stream_index;
+  server_json_stream_.setStream(*server_stream_ptrs_[server_stream_index_]);
+}
+#endif
+
+#if MODULAR_SERVER_RULE_COUNT_MAX > 0
+bool Server::setRuleCondition(Rule & rule,
+  ArduinoJson::JsonArray rule_condition)
+{
+  const char * condition = rule_condition[0];
+  const char * element_name = rule_condition[1];
+  if ((condition == NULL) || (element_name == NULL))
+  {
+    return false;
+  }
+  rule.condition_pin_ptr = NULL;
+  rule.condition_property_ptr = NULL;
+  rule.threshold = 0;
+  if ((rule_condition.size() == 2) && (condition == constants::pin_constant_string))
+  {
+    Pin * pin_ptr = pin_index_.findPinPtr(element_name);
+    if ((pin_ptr == NULL) || (pin_ptr->getInterruptNumber() == NOT_AN_INTERRUPT))
+    {
+      return false;
+    }
+    rule.condition = constants::RULE_CONDITION_PIN;
+    rule.condition_pin_ptr = pin_ptr;
+    return true;
+  }
+  if ((rule_condition.size() != 4) || !(condition == constants::property_constant_string))
+  {
+    return false;
+  }
+  int property_index = findPropertyIndex(element_name);
+  if (property_index < 0)
+  {
+    return false;
+  }
+  Property & property = properties_[property_index];
+  if ((property.getType() != JsonStream::LONG_TYPE) &&
+    (property.getType() != JsonStream::DOUBLE_TYPE))
+  {
+    return false;
+  }
+  const char * comparison = rule_condition[2];
+  if (comparison == NULL)
+  {
+    return false;
+  }
+  if (comparison == constants::greater_than_constant_string)
+  {
+    rule.condition = constants::RULE_CONDITION_PROPERTY_ABOVE;
+  }
+  else if (comparison == constants::less_than_constant_string)
+  {
+    rule.condition = constants::RULE_CONDITION_PROPERTY_BELOW;
+  }
+  else
+  {
+    return false;
+  }
+  if (!rule_condition[3].is<double>())
+  {
+    return false;
+  }
+  rule.condition_property_ptr = &property;
+  rule.threshold = rule_condition[3].as<double>();
+  return true;
+}
+
+bool Server::setRuleAction(Rule & rule,
+  ArduinoJson::JsonArray rule_action)
+{
+  const char * action = rule_action[0];
+  const char * element_name = rule_action[1];
+  if ((action == NULL) || (element_name == NULL))
+  {
+    return false;
+  }
+  rule.action_pin_ptr = NULL;
+  rule.action_callback_ptr = NULL;
+  rule.action_value = 0;
+  if ((rule_action.size() == 3) && (action == constants::set_pin_value_function_name))
+  {
+    Pin * pin_ptr = pin_index_.findPinPtr(element_name);
+    if ((pin_ptr == NULL) || !RuleEngine::pinModeIsOutput(*pin_ptr) || !rule_action[2].is<long>())
+    {
+      return false;
+    }
+    rule.action = constants::RULE_ACTION_SET_PIN_VALUE;
+    rule.action_pin_ptr = pin_ptr;
+    rule.action_value = rule_action[2].as<long>();
+    return true;
+  }
+  if ((rule_action.size() == 2) && (action == callback::trigger_function_name))
+  {
+    int callback_index = findCallbackIndex(element_name);
+    if (callback_index < 0)
+    {
+      return false;
+    }
+    rule.action = constants::RULE_ACTION_TRIGGER_CALLBACK;
+    rule.action_callback_ptr = &callbacks_[callback_index];
+    return true;
+  }
+  return false;
+}
+#endif
+
 // Firmware
 
 // Properties
@@ -332,15 +969,79 @@ Property & Server::property(const ConstantString & property_name)
   return dummy_property_;
 }
 
+void Server::setupProperty(const constants::PropertyInfo & property_info)
+{
+  constants::PropertyInfo property_info_copy;
+  memcpy_P(&property_info_copy,&property_info,sizeof(property_info_copy));
+  int property_index = findPropertyIndex(*property_info_copy.name_ptr);
+  if (property_index < 0)
+  {
+    setApiTableError(NULL,
+      constants::api_table_property_not_found_error_data,
+      *property_info_copy.name_ptr);
+    return;
+  }
+  Property & property = properties_[property_index];
+  if (property_info_copy.units_ptr)
+  {
+    property.setUnits(*property_info_copy.units_ptr);
+  }
+  if (property_info_copy.subset_ptr)
+  {
+    property.setSubset(property_info_copy.subset_ptr,
+      property_info_copy.subset_size,
+      property_info_copy.subset_size);
+  }
+  if (property_info_copy.range_is_set)
+  {
+    if ((property_info_copy.type == JsonStream::DOUBLE_TYPE) ||
+      ((property_info_copy.type == JsonStream::ARRAY_TYPE) &&
+        (property_info_copy.array_element_type == JsonStream::DOUBLE_TYPE)))
+    {
+      property.setRange(property_info_copy.min.d,property_info_copy.max.d);
+    }
+    else
+    {
+      property.setRange(property_info_copy.min.l,property_info_copy.max.l);
+    }
+  }
+  if (property_info_copy.array_length_range_is_set)
+  {
+    property.setArrayLengthRange(property_info_copy.array_length_min,
+      property_info_copy.array_length_max);
+  }
+}
+
 // Parameters
 Parameter & Server::createParameter(const ConstantString & parameter_name)
 {
   int parameter_index = findParameterIndex(parameter_name);
   if (parameter_index < 0)
   {
-    parameters_.push_back(Parameter(parameter_name));
+    parameter_arrays_.push_back(Parameter(parameter_name));
+    parameters_.update();
     const ConstantString * firmware_name_ptr = firmware_info_array_.back()->name_ptr;
     parameters_.back().setFirmwareName(*firmware_name_ptr);
+    parameters_.back().setFirmwareIndex(firmware_info_array_.size() - 1);
+    parameters_.back().setContext(context_);
+    return parameters_.back();
+  }
+  return dummy_parameter_;
+}
+
+Parameter & Server::createParameter(const constants::ParameterInfo & parameter_info)
+{
+  constants::ParameterInfo parameter_info_copy;
+  memcpy_P(&parameter_info_copy,&parameter_info,sizeof(parameter_info_copy));
+  int parameter_index = findParameterIndex(*parameter_info_copy.name_ptr);
+  if (parameter_index < 0)
+  {
+    parameter_arrays_.push_back(Parameter(parameter_info_copy));
+    parameters_.update();
+    const ConstantString * firmware_name_ptr = firmware_info_array_.back()->name_ptr;
+    parameters_.back().setFirmwareName(*firmware_name_ptr);
+    parameters_.back().setFirmwareIndex(firmware_info_array_.size() - 1);
+    parameters_.back().setContext(context_);
     return parameters_.back();
   }
   return dummy_parameter_;
@@ -359,7 +1060,8 @@ Parameter & Server::parameter(const ConstantString & parameter_name)
 Parameter & Server::copyParameter(Parameter parameter,
   const ConstantString & parameter_name)
 {
-  parameters_.push_back(parameter);
+  parameter_arrays_.push_back(parameter);
+  parameters_.update();
   parameters_.back().setName(parameter_name);
   return parameters_.back();
 }
@@ -370,14 +1072,53 @@ Function & Server::createFunction(const ConstantString & function_name)
   int function_index = findFunctionIndex(function_name);
   if (function_index < 0)
   {
-    functions_.push_back(Function(function_name));
+    function_arrays_.push_back(Function(function_name));
+    functions_.update();
     const ConstantString * firmware_name_ptr = firmware_info_array_.back()->name_ptr;
     functions_.back().setFirmwareName(*firmware_name_ptr);
+    functions_.back().setFirmwareIndex(firmware_info_array_.size() - 1);
+    functions_.back().setContext(context_);
     return functions_.back();
   }
   return dummy_function_;
 }
 
+Function & Server::createFunction(const constants::FunctionInfo & function_info)
+{
+  constants::FunctionInfo function_info_copy;
+  memcpy_P(&function_info_copy,&function_info,sizeof(function_info_copy));
+  int function_index = findFunctionIndex(*function_info_copy.name_ptr);
+  if (function_index < 0)
+  {
+    Function & function = createFunction(*function_info_copy.name_ptr);
+    for (size_t i=0; i<function_info_copy.parameter_count; ++i)
+    {
+      const ConstantString * parameter_name_ptr;
+      memcpy_P(&parameter_name_ptr,&function_info_copy.parameter_name_ptrs[i],sizeof(parameter_name_ptr));
+      int parameter_index = findParameterIndex(*parameter_name_ptr);
+      if (parameter_index < 0)
+      {
+        setApiTableError(function_info_copy.name_ptr,
+          constants::api_table_parameter_not_found_error_data,
+          *parameter_name_ptr);
+        continue;
+      }
+      function.addParameter(parameters_[parameter_index]);
+    }
+    function.setResultType(function_info_copy.result_type);
+    if (function_info_copy.result_type == JsonStream::ARRAY_TYPE)
+    {
+      function.setResultType(function_info_copy.result_array_element_type);
+    }
+    if (function_info_copy.result_units_ptr)
+    {
+      function.setResultUnits(*function_info_copy.result_units_ptr);
+    }
+    return function;
+  }
+  return dummy_function_;
+}
+
 Function & Server::function(const ConstantString & function_name)
 {
   int function_index = findFunctionIndex(function_name);
@@ -391,7 +1132,8 @@ Function & Server::function(const ConstantString & function_name)
 Function & Server::copyFunction(Function function,
   const ConstantString & function_name)
 {
-  functions_.push_back(function);
+  function_arrays_.push_back(function);
+  functions_.update();
   functions_.back().setName(function_name);
   return functions_.back();
 }
@@ -402,14 +1144,24 @@ Callback & Server::createCallback(const ConstantString & callback_name)
   int callback_index = findCallbackIndex(callback_name);
   if (callback_index < 0)
   {
-    callbacks_.push_back(Callback(callback_name));
+    callback_arrays_.push_back(Callback(callback_name));
+    callbacks_.update();
     const ConstantString * firmware_name_ptr = firmware_info_array_.back()->name_ptr;
     callbacks_.back().setFirmwareName(*firmware_name_ptr);
+    callbacks_.back().setFirmwareIndex(firmware_info_array_.size() - 1);
+    callbacks_.back().setContext(context_);
     return callbacks_.back();
   }
   return dummy_callback_;
 }
 
+Callback & Server::createCallback(const constants::CallbackInfo & callback_info)
+{
+  constants::CallbackInfo callback_info_copy;
+  memcpy_P(&callback_info_copy,&callback_info,sizeof(callback_info_copy));
+  return createCallback(*callback_info_copy.name_ptr);
+}
+
 Callback & Server::callback(const ConstantString & callback_name)
 {
   int callback_index = findCallbackIndex(callback_name);
@@ -447,12 +1199,45 @@ void Server::stopServer()
 
 void Server::handleRequest()
 {
-  if (server_running_ && (server_stream_ptrs_.size() > 0) && (server_json_stream_.available() > 0))
+  unsigned long time = micros();
+  if (timing_monitor_enabled_)
+  {
+    updateLoopPeriod(time);
+  }
+  updatePipeForwards();
+#if MODULAR_SERVER_TELEMETRY_COUNT_MAX > 0
+  if (server_running_)
   {
-    char request[constants::STRING_LENGTH_REQUEST];
-    long bytes_read = server_json_stream_.readJsonIntoBuffer(request);
+    updateTelemetry();
+  }
+#endif
+  // a stream waiting on a pipe forward is not read until its response is complete
+  if (server_running_ && (server_stream_ptrs_.size() > 0) &&
+    !pipe_forwards_[server_stream_index_].active() &&
+    (server_json_stream_.available() > 0))
+  {
+    response_.setStackTop((const char *)__builtin_frame_address(0));
+#if MODULAR_SERVER_REQUEST_TRACE_COUNT_MAX > 0
+    beginRequestTrace();
+#endif
+    typedef char RequestBuffer[constants::STRING_LENGTH_REQUEST];
+    RequestBuffer * request_ptr = static_cast<RequestBuffer *>(request_arena_.allocate(sizeof(RequestBuffer)));
+    long bytes_read = -1;
+    if (request_ptr)
+    {
+      bytes_read = server_json_stream_.readJsonIntoBuffer(*request_ptr);
+    }
+    char * request = (char *)request_ptr;
+#if MODULAR_SERVER_REQUEST_TRACE_COUNT_MAX > 0
+    request_trace_.bytes_read = bytes_read;
+    request_trace_.read_duration = endRequestTracePhase();
+#endif
     if (bytes_read > 0)
     {
+      if ((size_t)bytes_read > request_length_max_)
+      {
+        request_length_max_ = bytes_read;
+      }
       JsonSanitizer<constants::JSON_TOKEN_MAX> sanitizer;
       if (sanitizer.firstCharIsValidJson(request))
       {
@@ -462,9 +1247,13 @@ void Server::handleRequest()
       {
         response_.setPrettyPrint();
       }
+      beginResponseFrame();
       response_.begin();
       sanitizer.sanitizeBuffer(request);
-      StaticJsonDocument<constants::JSON_DOCUMENT_SIZE> json_document;
+#if MODULAR_SERVER_REQUEST_TRACE_COUNT_MAX > 0
+      request_trace_.sanitize_duration = endRequestTracePhase();
+#endif
+      ArenaJsonDocument json_document(constants::JSON_DOCUMENT_SIZE,ArenaAllocator(&request_arena_));
       if (sanitizer.firstCharIsValidJsonObject(request))
       {
         response_.returnError(constants::object_request_error_data);
@@ -472,27 +1261,97 @@ void Server::handleRequest()
       else
       {
         ArduinoJson::DeserializationError error = deserializeJson(json_document,request);
+#if MODULAR_SERVER_REQUEST_TRACE_COUNT_MAX > 0
+        request_trace_.deserialize_duration = endRequestTracePhase();
+#endif
+        if (json_document.memoryUsage() > json_document_usage_max_)
+        {
+          json_document_usage_max_ = json_document.memoryUsage();
+        }
         if (!error)
         {
           request_json_array_ = json_document.as<ArduinoJson::JsonArray>();
           processRequestArray();
+#if MODULAR_SERVER_REQUEST_TRACE_COUNT_MAX > 0
+          request_trace_.handler_duration += endRequestTracePhase();
+#endif
         }
         else
         {
           response_.returnRequestParseError(request);
         }
       }
-      response_.end();
+      if (response_.pipe_stream_ptr_ && !response_.error())
+      {
+        beginPipeForward();
+      }
+      else
+      {
+        response_.end();
+        endResponseFrame();
+      }
+#if MODULAR_SERVER_REQUEST_TRACE_COUNT_MAX > 0
+      request_trace_.end_duration = endRequestTracePhase();
+      endRequestTrace();
+#endif
     }
     else if (bytes_read < 0)
     {
       response_.setCompactPrint();
+      beginResponseFrame();
       response_.begin();
       response_.returnError(constants::request_length_error_data);
       response_.end();
+      endResponseFrame();
+#if MODULAR_SERVER_REQUEST_TRACE_COUNT_MAX > 0
+      request_trace_.end_duration = endRequestTracePhase();
+      endRequestTrace();
+#endif
+    }
+    else
+    {
+      // no request was read so no response resets the arena
+      request_arena_.reset();
     }
+    response_.setStackTop(NULL);
   }
   incrementServerStream();
+  if (timing_monitor_enabled_)
+  {
+    updateServerDuration(micros() - time);
+  }
+}
+
+// Timing Monitor
+void Server::enableTimingMonitor(unsigned long loop_period_deadline)
+{
+  loop_period_deadline_ = loop_period_deadline;
+  resetTimingMonitor();
+  timing_monitor_enabled_ = true;
+  Pin::enableCallbackTiming();
+}
+
+void Server::disableTimingMonitor()
+{
+  timing_monitor_enabled_ = false;
+  Pin::disableCallbackTiming();
+}
+
+void Server::resetTimingMonitor()
+{
+  loop_time_ = micros();
+  loop_count_ = 0;
+  loop_period_max_ = 0;
+  deadline_miss_count_ = 0;
+  server_duration_max_ = 0;
+  for (size_t i=0; i<constants::LOOP_PERIOD_HISTOGRAM_BIN_COUNT; ++i)
+  {
+    loop_period_histogram_[i] = 0;
+  }
+  for (size_t i=0; i<pins_.size(); ++i)
+  {
+    pins_[i].resetCallbackDurationMax();
+  }
 }
 
 // private
@@ -512,7 +1371,7 @@ ArduinoJson::JsonVariant Server::getParameterValue(const ConstantString & parame
     {
       int callback_index = request_method_index_ - functions_.size();
       Callback & callback = callbacks_[callback_index];
-      Function & function = callback.functions_[callback_function_index_];
+      Function & function = callback.tables().functions[callback_function_index_];
 
       // index 0 is the request method, index 1 is the callback function
       parameter_index += findFunctionParameterIndex(function,parameter_name) + 1;
@@ -524,7 +1383,7 @@ ArduinoJson::JsonVariant Server::getParameterValue(const ConstantString & parame
     {
       int property_index = request_method_index_ - functions_.size() - callbacks_.size();
       Property & property = properties_[property_index];
-      Function & function = property.functions_[property_function_index_];
+      Function & function = property.tables().functions[property_function_index_];
 
       // index 0 is the request method, index 1 is the property function
       parameter_index += findFunctionParameterIndex(function,parameter_name) + 1;
@@ -548,6 +1407,13 @@ const char * Server::getRequestElementAsString(size_t element_index,
 
 void Server::processRequestArray()
 {
+  if (api_table_error_data_ptr_)
+  {
+    response_.returnApiTableError(api_table_element_name_ptr_,
+      *api_table_error_data_ptr_,
+      *api_table_name_ptr_);
+    return;
+  }
   size_t request_element_count = request_json_array_.size();
   if ((0 < request_element_count) && request_json_array_[0].is<signed int>())
   {
@@ -559,28 +1425,28 @@ void Server::processRequestArray()
     const char * method_string = getRequestElementAsString(0,request_element_count);
     request_method_index_ = findMethodIndex(method_string);
   }
+#if MODULAR_SERVER_REQUEST_TRACE_COUNT_MAX > 0
+  request_trace_.method_index = request_method_index_;
+  request_trace_.lookup_duration = endRequestTracePhase();
+#endif
   const char * parameter0_string = getRequestElementAsString(1,request_element_count);
   const char * parameter1_string = getRequestElementAsString(2,request_element_count);
   const char * parameter2_string = getRequestElementAsString(3,request_element_count);
   if (request_method_index_ >= 0)
   {
     size_t parameter_count = (request_element_count > 0) ? (request_element_count - 1) : 0;
-    char question_str[constants::question_constant_string.length()+1];
-    constants::question_constant_string.copy(question_str);
-    char question_double_str[constants::question_double_constant_string.length()+1];
-    constants::question_double_constant_string.copy(question_double_str);
     if (request_method_index_ < (int)functions_.size())
     {
       int function_index = request_method_index_;
       Function & function = functions_[function_index];
       // function ?
-      if ((parameter_count == 1) && (strcmp(parameter0_string,question_str) == 0))
+      if ((parameter_count == 1) && (constants::question_constant_string == parameter0_string))
       {
         response_.writeResultKey();
         function.writeApi(response_,false,true,false);
       }
       // function ??
-      else if ((parameter_count == 1) && (strcmp(parameter0_string,question_double_str) == 0))
+      else if ((parameter_count == 1) && (constants::question_double_constant_string == parameter0_string))
       {
         response_.writeResultKey();
         function.writeApi(response_,false,true,true);
@@ -588,8 +1454,8 @@ void Server::processRequestArray()
       // function parameter ?
       // function parameter ??
       else if ((parameter_count == 2) &&
-        ((strcmp(parameter1_string,question_str) == 0) ||
-          (strcmp(parameter1_string,question_double_str) == 0)))
+        ((constants::question_constant_string == parameter1_string) ||
+          (constants::question_double_constant_string == parameter1_string)))
       {
         int parameter_index = processParameterString(function,parameter0_string);
         if (parameter_index >= 0)
@@ -626,13 +1492,13 @@ void Server::processRequestArray()
       int callback_index = request_method_index_ - functions_.size();
       Callback & callback = callbacks_[callback_index];
       // callback ?
-      if ((parameter_count == 1) && (strcmp(parameter0_string,question_str) == 0))
+      if ((parameter_count == 1) && (constants::question_constant_string == parameter0_string))
       {
         response_.writeResultKey();
         callback.writeApi(response_,false,true,false,false,true);
       }
       // callback ??
-      else if ((parameter_count == 1) && (strcmp(parameter0_string,question_double_str) == 0))
+      else if ((parameter_count == 1) && (constants::question_double_constant_string == parameter0_string))
       {
         response_.writeResultKey();
         callback.writeApi(response_,false,true,true,true,true);
@@ -660,18 +1526,18 @@ void Server::processRequestArray()
           return;
         }
 
-        Function & function = callback.functions_[callback_function_index_];
+        Function & function = callback.tables().functions[callback_function_index_];
 
         size_t callback_parameter_count = (parameter_count > 0) ? (parameter_count - 1) : 0;
 
         // callback function ?
-        if ((callback_parameter_count == 1) && (strcmp(parameter1_string,question_str) == 0))
+        if ((callback_parameter_count == 1) && (constants::question_constant_string == parameter1_string))
         {
           response_.writeResultKey();
           function.writeApi(response_,false,true,false);
         }
         // callback function ??
-        else if ((callback_parameter_count == 1) && (strcmp(parameter1_string,question_double_str) == 0))
+        else if ((callback_parameter_count == 1) && (constants::question_double_constant_string == parameter1_string))
         {
           response_.writeResultKey();
           function.writeApi(response_,false,true,true);
@@ -679,8 +1545,8 @@ void Server::processRequestArray()
         // callback function parameter ?
         // callback function parameter ??
         else if ((callback_parameter_count == 2) &&
-          ((strcmp(parameter2_string,question_str) == 0) ||
-            (strcmp(parameter2_string,question_double_str) == 0)))
+          ((constants::question_constant_string == parameter2_string) ||
+            (constants::question_double_constant_string == parameter2_string)))
         {
           int parameter_index = processParameterString(function,parameter1_string);
           if (parameter_index >= 0)
@@ -713,13 +1579,13 @@ void Server::processRequestArray()
       int property_index = request_method_index_ - functions_.size() - callbacks_.size();
       Property & property = properties_[property_index];
       // property ?
-      if ((parameter_count == 1) && (strcmp(parameter0_string,question_str) == 0))
+      if ((parameter_count == 1) && (constants::question_constant_string == parameter0_string))
       {
         response_.writeResultKey();
         property.writeApi(response_,false,true,false,true);
       }
       // property ??
-      else if ((parameter_count == 1) && (strcmp(parameter0_string,question_double_str) == 0))
+      else if ((parameter_count == 1) && (constants::question_double_constant_string == parameter0_string))
       {
         response_.writeResultKey();
         property.writeApi(response_,false,true,true,true);
@@ -747,18 +1613,18 @@ void Server::processRequestArray()
           return;
         }
 
-        Function & function = property.functions_[property_function_index_];
+        Function & function = property.tables().functions[property_function_index_];
 
         size_t property_parameter_count = (parameter_count > 0) ? (parameter_count - 1) : 0;
 
         // property function ?
-        if ((property_parameter_count == 1) && (strcmp(parameter1_string,question_str) == 0))
+        if ((property_parameter_count == 1) && (constants::question_constant_string == parameter1_string))
         {
           response_.writeResultKey();
           function.writeApi(response_,false,true,false);
         }
         // property function ??
-        else if ((property_parameter_count == 1) && (strcmp(parameter1_string,question_double_str) == 0))
+        else if ((property_parameter_count == 1) && (constants::question_double_constant_string == parameter1_string))
         {
           response_.writeResultKey();
           function.writeApi(response_,false,true,true);
@@ -766,8 +1632,8 @@ void Server::processRequestArray()
         // property function parameter ?
         // property function parameter ??
         else if ((property_parameter_count == 2) &&
-          ((strcmp(parameter2_string,question_str) == 0) ||
-            (strcmp(parameter2_string,question_double_str) == 0)))
+          ((constants::question_constant_string == parameter2_string) ||
+            (constants::question_double_constant_string == parameter2_string)))
         {
           int parameter_index = processParameterString(function,parameter1_string);
           if (parameter_index >= 0)
@@ -844,9 +1710,7 @@ int Server::processParameterString(Function & function,
 {
   int parameter_index = -1;
   int parameter_id = atoi(parameter_string);
-  char zero_str[constants::zero_constant_string.length()+1];
-  constants::zero_constant_string.copy(zero_str);
-  if (strcmp(parameter_string,zero_str) == 0)
+  if (constants::zero_constant_string == parameter_string)
   {
     parameter_index = 0;
   }
@@ -871,6 +1735,10 @@ int Server::processParameterString(Function & function,
 bool Server::checkParameters(Function & function,
   size_t request_array_start_index)
 {
+#if MODULAR_SERVER_REQUEST_TRACE_COUNT_MAX > 0
+  request_trace_.handler_duration += endRequestTracePhase();
+#endif
+  bool parameters_ok = true;
   size_t parameter_index = 0;
   size_t request_array_index = 0;
   for (ArduinoJson::JsonVariant value : request_json_array_)
@@ -887,15 +1755,25 @@ bool Server::checkParameters(Function & function,
     }
     else
     {
-      return false;
+      parameters_ok = false;
+      break;
     }
   }
-  return true;
+#if MODULAR_SERVER_REQUEST_TRACE_COUNT_MAX > 0
+  request_trace_.check_duration += endRequestTracePhase();
+#endif
+  return parameters_ok;
 }
 
 bool Server::checkParameter(Parameter & parameter,
   ArduinoJson::JsonVariant json_value)
 {
+  // the validator chosen when the parameter constraints were set accepts
+  // valid values without formatting any error text
+  if (parameter.validate(json_value))
+  {
+    return true;
+  }
   bool correct_type = true;
   bool in_subset = true;
   bool in_range = true;
@@ -944,8 +1822,8 @@ bool Server::checkParameter(Parameter & parameter,
         in_range = false;
         double min = parameter.getRangeMin().d;
         double max = parameter.getRangeMax().d;
-        dtostrf(min,0,JsonStream::DOUBLE_DIGITS_DEFAULT,min_str);
-        dtostrf(max,0,JsonStream::DOUBLE_DIGITS_DEFAULT,max_str);
+        DoubleFormatter::format(min_str,JsonStream::STRING_LENGTH_DOUBLE,min);
+        DoubleFormatter::format(max_str,JsonStream::STRING_LENGTH_DOUBLE,max);
       }
       break;
     }
@@ -1002,6 +1880,17 @@ bool Server::checkParameter(Parameter & parameter,
         dtostrf(array_length_max,0,0,max_str);
         break;
       }
+      JsonStream::JsonTypes array_element_type = parameter.getArrayElementType();
+      if (array_element_type == JsonStream::LONG_TYPE)
+      {
+        array_elements_ok = checkArrayParameterElementBlocks<long>(parameter,json_array,array_length);
+        break;
+      }
+      if (array_element_type == JsonStream::DOUBLE_TYPE)
+      {
+        array_elements_ok = checkArrayParameterElementBlocks<double>(parameter,json_array,array_length);
+        break;
+      }
       for (ArduinoJson::JsonVariant value : json_array)
       {
         bool parameter_ok = checkArrayParameterElement(parameter,value);
@@ -1025,14 +1914,16 @@ bool Server::checkParameter(Parameter & parameter,
   else if (!in_subset)
   {
     Vector<constants::SubsetMemberType> & subset = parameter.getSubset();
-    char subset_str[constants::STRING_LENGTH_ERROR];
-    subset_str[0] = '\0';
-    subsetToString(subset_str,
-      subset,
-      parameter.getType(),
-      parameter.getArrayElementType(),
-      constants::STRING_LENGTH_ERROR-1);
-    response_.returnParameterNotInSubsetError(subset_str,
+    char * subset_str = request_arena_.allocateString(constants::STRING_LENGTH_ERROR-1);
+    if (subset_str)
+    {
+      subsetToString(subset_str,
+        subset,
+        parameter.getType(),
+        parameter.getArrayElementType(),
+        constants::STRING_LENGTH_ERROR-1);
+    }
+    response_.returnParameterNotInSubsetError((subset_str ? subset_str : empty_string_),
       parameter.getType());
   }
   else if (!in_range)
@@ -1046,6 +1937,7 @@ bool Server::checkParameter(Parameter & parameter,
   {
     response_.returnParameterArrayLengthError(parameter.getName(),min_str,max_str);
   }
+  response_.updateStackHighWater();
   bool parameter_ok = in_subset && in_range && array_length_in_range && array_elements_ok;
   return parameter_ok;
 }
@@ -1117,8 +2009,8 @@ bool Server::checkArrayParameterElement(Parameter & parameter,
             in_range = false;
             double min = parameter.getRangeMin().d;
             double max = parameter.getRangeMax().d;
-            dtostrf(min,0,JsonStream::DOUBLE_DIGITS_DEFAULT,min_str);
-            dtostrf(max,0,JsonStream::DOUBLE_DIGITS_DEFAULT,max_str);
+            DoubleFormatter::format(min_str,JsonStream::STRING_LENGTH_DOUBLE,min);
+            DoubleFormatter::format(max_str,JsonStream::STRING_LENGTH_DOUBLE,max);
           }
           break;
         }
@@ -1162,14 +2054,16 @@ bool Server::checkArrayParameterElement(Parameter & parameter,
   if (!in_subset)
   {
     Vector<constants::SubsetMemberType> & subset = parameter.getSubset();
-    char subset_str[constants::STRING_LENGTH_ERROR];
-    subset_str[0] = '\0';
-    subsetToString(subset_str,
-      subset,
-      parameter.getType(),
-      parameter.getArrayElementType(),
-      constants::STRING_LENGTH_ERROR-1);
-    response_.returnParameterNotInSubsetError(subset_str,
+    char * subset_str = request_arena_.allocateString(constants::STRING_LENGTH_ERROR-1);
+    if (subset_str)
+    {
+      subsetToString(subset_str,
+        subset,
+        parameter.getType(),
+        parameter.getArrayElementType(),
+        constants::STRING_LENGTH_ERROR-1);
+    }
+    response_.returnParameterNotInSubsetError((subset_str ? subset_str : empty_string_),
       parameter.getType());
   }
   else if (!in_range)
@@ -1179,6 +2073,7 @@ bool Server::checkArrayParameterElement(Parameter & parameter,
       min_str,
       max_str);
   }
+  response_.updateStackHighWater();
   bool parameter_ok = in_subset && in_range;
   return parameter_ok;
 }
@@ -1190,6 +2085,19 @@ long Server::getSerialNumber()
   return serial_number;
 }
 
+void Server::setApiTableError(const ConstantString * element_name_ptr,
+  const ConstantString & error_data,
+  const ConstantString & name)
+{
+  // every request is answered with the first error until the table is fixed
+  if (api_table_error_data_ptr_ == NULL)
+  {
+    api_table_error_data_ptr_ = &error_data;
+    api_table_element_name_ptr_ = element_name_ptr;
+    api_table_name_ptr_ = &name;
+  }
+}
+
 void Server::initializeEeprom()
 {
   if (!eeprom_initialized_sv_.valueIsDefault())
@@ -1209,6 +2117,141 @@ void Server::incrementServerStream()
   }
 }
 
+void Server::beginResponseFrame()
+{
+  if (!response_framing_[server_stream_index_])
+  {
+    return;
+  }
+  framed_stream_.setStream(*server_stream_ptrs_[server_stream_index_]);
+  framed_stream_.beginFrame();
+  server_json_stream_.setStream(framed_stream_);
+  response_frame_open_ = true;
+}
+
+void Server::endResponseFrame()
+{
+  if (!response_frame_open_)
+  {
+    return;
+  }
+  framed_stream_.endFrame();
+  server_json_stream_.setStream(*server_stream_ptrs_[server_stream_index_]);
+  response_frame_open_ = false;
+}
+
+void Server::beginPipeForward()
+{
+  Stream & server_stream = *server_stream_ptrs_[server_stream_index_];
+  bool framed = response_frame_open_;
+  if (framed)
+  {
+    framed_stream_.flushChunk();
+  }
+  // close the response in the json stream without writing it so other streams
+  // may be served, endPipeForward writes the rest once the result has arrived
+  Stream * pipe_stream_ptr = response_.pipe_stream_ptr_;
+  unsigned long pipe_timeout = response_.pipe_timeout_;
+  server_json_stream_.setStream(null_stream_);
+  response_.end();
+  server_json_stream_.setStream(server_stream);
+  response_frame_open_ = false;
+
+  pipe_forwards_[server_stream_index_].begin(*pipe_stream_ptr,
+    server_stream,
+    framed,
+    response_.compact_print_,
+    pipe_timeout,
+    pipe_forward_sequence_++);
+}
+
+void Server::endPipeForward(PipeForward & pipe_forward)
+{
+  Stream & server_stream = *pipe_forward.getUpstreamPtr();
+  // open the response again in the json stream without writing it, as far as
+  // the id written before the forward began, then end it on the server stream
+  server_json_stream_.setStream(null_stream_);
+  if (pipe_forward.compactPrint())
+  {
+    response_.setCompactPrint();
+  }
+  else
+  {
+    response_.setPrettyPrint();
+  }
+  response_.begin();
+  response_.write(constants::id_constant_string,0L);
+  if (pipe_forward.framed())
+  {
+    framed_stream_.setStream(server_stream);
+    framed_stream_.beginFrame();
+    server_json_stream_.setStream(framed_stream_);
+  }
+  else
+  {
+    server_json_stream_.setStream(server_stream);
+  }
+
+  if (!pipe_forward.responseComplete())
+  {
+    response_.returnError(constants::pipe_response_timeout_error_data);
+  }
+  else if (pipe_forward.responseTooLong())
+  {
+    response_.returnError(constants::pipe_response_too_long_error_data);
+  }
+  else
+  {
+    response_.returnPipedResult(pipe_forward.getResponse());
+  }
+  response_.end();
+
+  if (pipe_forward.framed())
+  {
+    framed_stream_.endFrame();
+  }
+  if (server_stream_ptrs_.size() > 0)
+  {
+    server_json_stream_.setStream(*server_stream_ptrs_[server_stream_index_]);
+  }
+  pipe_forward.end();
+}
+
+void Server::updatePipeForwards()
+{
+  for (size_t i=0; i<constants::SERVER_STREAM_COUNT_MAX; ++i)
+  {
+    PipeForward & pipe_forward = pipe_forwards_[i];
+    if (!pipe_forward.active())
+    {
+      continue;
+    }
+    // downstream responses arrive in request order so only the oldest
+    // forward on each downstream stream may read from it
+    bool oldest = true;
+    for (size_t j=0; j<constants::SERVER_STREAM_COUNT_MAX; ++j)
+    {
+      PipeForward & other_pipe_forward = pipe_forwards_[j];
+      if ((j != i) &&
+        other_pipe_forward.active() &&
+        (other_pipe_forward.getDownstreamPtr() == pipe_forward.getDownstreamPtr()) &&
+        ((long)(other_pipe_forward.getSequence() - pipe_forward.getSequence()) < 0))
+      {
+        oldest = false;
+        break;
+      }
+    }
+    if (!oldest)
+    {
+      pipe_forward.hold();
+    }
+    else if (pipe_forward.update())
+    {
+      endPipeForward(pipe_forward);
+    }
+  }
+}
+
 void Server::help(bool verbose)
 {
   if (response_.error())
@@ -1237,15 +2280,13 @@ void Server::help(bool verbose)
 
     response_.writeKey(constants::api_constant_string);
 
-    ArduinoJson::StaticJsonDocument<constants::FIRMWARE_NAME_JSON_DOCUMENT_SIZE> json_document;
+    ArenaJsonDocument json_document(constants::FIRMWARE_NAME_JSON_DOCUMENT_SIZE,ArenaAllocator(&request_arena_));
     ArduinoJson::JsonArray firmware_name_array = json_document.to<ArduinoJson::JsonArray>();
 
     if (verbose)
     {
       // Write ALL firmware API to response
-      char all_str[constants::all_constant_string.length() + 1];
-      all_str[0] = '\0';
-      constants::all_constant_string.copy(all_str);
+      char * all_str = request_arena_.allocateString(constants::all_constant_string);
       firmware_name_array.add<char *>(all_str);
       writeApiToResponse(constants::verbosity_names,firmware_name_array);
     }
@@ -1253,9 +2294,7 @@ void Server::help(bool verbose)
     {
       // Write only the highest level firmware API to response
       constants::SubsetMemberType firmware_name = firmware_name_array_.back();
-      char firmware_name_str[firmware_name.cs_ptr->length() + 1];
-      firmware_name_str[0] = '\0';
-      firmware_name.cs_ptr->copy(firmware_name_str);
+      char * firmware_name_str = request_arena_.allocateString(*firmware_name.cs_ptr);
       firmware_name_array.add<char *>(firmware_name_str);
       writeApiToResponse(constants::verbosity_names,firmware_name_array);
     }
@@ -1354,7 +2393,7 @@ void Server::help(bool verbose)
         if (property_function_index >= 0)
         {
           param_error = false;
-          Function & function = property.functions_[property_function_index];
+          Function & function = property.tables().functions[property_function_index];
 
           response_.writeResultKey();
           function.writeApi(response_,false,true,verbose);
@@ -1385,7 +2424,7 @@ void Server::help(bool verbose)
       int property_function_index = property.findFunctionIndex(parameter1_string);
       if (property_function_index >= 0)
       {
-        Function & function = property.functions_[property_function_index];
+        Function & function = property.tables().functions[property_function_index];
         int parameter_index = processParameterString(function,parameter2_string);
         if (parameter_index >= 0)
         {
@@ -1496,7 +2535,7 @@ void Server::writeHardwareInfoToResponse()
       response_.write(constants::version_constant_string,version_str);
     }
 
-    Vector<Pin> & pins = pins_.subVector(i);
+    Vector<Pin> & pins = pin_arrays_.subVector(i);
     if (pins.size() > 0)
     {
       response_.writeKey(constants::pins_constant_string);
@@ -1587,13 +2626,15 @@ void Server::writeApiToResponse(const ConstantString & verbosity,
     write_instance_details = true;
   }
 
+  constants::FirmwareMask firmware_mask = getFirmwareMask(firmware_name_array);
+
   bool write_firmware = false;
   if (containsAllOrMoreThanOne(firmware_name_array))
   {
     write_firmware = true;
   }
 
-  size_t functions_count = getFunctionsCount(firmware_name_array);
+  size_t functions_count = getFunctionsCount(firmware_mask);
   if (functions_count > 0)
   {
     response_.writeKey(constants::functions_constant_string);
@@ -1603,7 +2644,7 @@ void Server::writeApiToResponse(const ConstantString & verbosity,
       if (function_index > private_function_index_)
       {
         Function & function = functions_[function_index];
-        if (function.firmwareNameInArray(firmware_name_array))
+        if (function.firmwareInMask(firmware_mask))
         {
           function.writeApi(response_,write_names_only,write_firmware,false);
         }
@@ -1612,7 +2653,7 @@ void Server::writeApiToResponse(const ConstantString & verbosity,
     response_.endArray();
   }
 
-  size_t parameters_count = getParametersCount(firmware_name_array);
+  size_t parameters_count = getParametersCount(firmware_mask);
   if (parameters_count > 0)
   {
     response_.writeKey(constants::parameters_constant_string);
@@ -1620,7 +2661,7 @@ void Server::writeApiToResponse(const ConstantString & verbosity,
     for (size_t parameter_index=0; parameter_index<parameters_.size(); ++parameter_index)
     {
       Parameter & parameter = parameters_[parameter_index];
-      if (parameter.firmwareNameInArray(firmware_name_array))
+      if (parameter.firmwareInMask(firmware_mask))
       {
         parameter.writeApi(response_,write_names_only,false,write_firmware,write_instance_details);
       }
@@ -1628,7 +2669,7 @@ void Server::writeApiToResponse(const ConstantString & verbosity,
     response_.endArray();
   }
 
-  size_t properties_count = getPropertiesCount(firmware_name_array);
+  size_t properties_count = getPropertiesCount(firmware_mask);
   if (properties_count > 0)
   {
     response_.writeKey(constants::properties_constant_string);
@@ -1636,7 +2677,7 @@ void Server::writeApiToResponse(const ConstantString & verbosity,
     for (size_t property_index=0; property_index<properties_.size(); ++property_index)
     {
       Property & property = properties_[property_index];
-      if (property.firmwareNameInArray(firmware_name_array))
+      if (property.firmwareInMask(firmware_mask))
       {
         property.writeApi(response_,write_names_only,write_firmware,true,write_instance_details);
       }
@@ -1644,7 +2685,7 @@ void Server::writeApiToResponse(const ConstantString & verbosity,
     response_.endArray();
   }
 
-  size_t callbacks_count = getCallbacksCount(firmware_name_array);
+  size_t callbacks_count = getCallbacksCount(firmware_mask);
   if (callbacks_count > 0)
   {
     response_.writeKey(constants::callbacks_constant_string);
@@ -1652,7 +2693,7 @@ void Server::writeApiToResponse(const ConstantString & verbosity,
     for (size_t callback_index=0; callback_index<callbacks_.size(); ++callback_index)
     {
       Callback & callback = callbacks_[callback_index];
-      if (callback.firmwareNameInArray(firmware_name_array))
+      if (callback.firmwareInMask(firmware_mask))
       {
         callback.writeApi(response_,write_names_only,write_firmware,true,false,write_instance_details);
       }
@@ -1680,12 +2721,12 @@ bool Server::containsAllOrMoreThanOne(ArduinoJson::JsonArray firmware_name_array
   return false;
 }
 
-size_t Server::getPropertiesCount(ArduinoJson::JsonArray firmware_name_array)
+size_t Server::getPropertiesCount(constants::FirmwareMask firmware_mask)
 {
   size_t count = 0;
   for (size_t property_index=0; property_index<properties_.size(); ++property_index)
   {
-    if (properties_[property_index].firmwareNameInArray(firmware_name_array))
+    if (properties_[property_index].firmwareInMask(firmware_mask))
     {
       ++count;
     }
@@ -1693,12 +2734,12 @@ size_t Server::getPropertiesCount(ArduinoJson::JsonArray firmware_name_array)
   return count;
 }
 
-size_t Server::getParametersCount(ArduinoJson::JsonArray firmware_name_array)
+size_t Server::getParametersCount(constants::FirmwareMask firmware_mask)
 {
   size_t count = 0;
   for (size_t property_index=0; property_index<parameters_.size(); ++property_index)
   {
-    if (parameters_[property_index].firmwareNameInArray(firmware_name_array))
+    if (parameters_[property_index].firmwareInMask(firmware_mask))
     {
       ++count;
     }
@@ -1706,12 +2747,12 @@ size_t Server::getParametersCount(ArduinoJson::JsonArray firmware_name_array)
   return count;
 }
 
-size_t Server::getFunctionsCount(ArduinoJson::JsonArray firmware_name_array)
+size_t Server::getFunctionsCount(constants::FirmwareMask firmware_mask)
 {
   size_t count = 0;
   for (size_t property_index=0; property_index<functions_.size(); ++property_index)
   {
-    if (functions_[property_index].firmwareNameInArray(firmware_name_array))
+    if (functions_[property_index].firmwareInMask(firmware_mask))
     {
       ++count;
     }
@@ -1719,12 +2760,12 @@ size_t Server::getFunctionsCount(ArduinoJson::JsonArray firmware_name_array)
   return count;
 }
 
-size_t Server::getCallbacksCount(ArduinoJson::JsonArray firmware_name_array)
+size_t Server::getCallbacksCount(constants::FirmwareMask firmware_mask)
 {
   size_t count = 0;
   for (size_t property_index=0; property_index<callbacks_.size(); ++property_index)
   {
-    if (callbacks_[property_index].firmwareNameInArray(firmware_name_array))
+    if (callbacks_[property_index].firmwareInMask(firmware_mask))
     {
       ++count;
     }
@@ -1794,9 +2835,7 @@ void Server::subsetToString(char * destination,
   {
     return;
   }
-  char array_open_str[length + 1];
-  constants::array_open_constant_string.copy(array_open_str);
-  strcat(destination,array_open_str);
+  constants::array_open_constant_string.copy(destination + strlen(destination));
   length_left -= length;
 
   char value_str[constants::STRING_LENGTH_SUBSET_ELEMENT];
@@ -1809,9 +2848,7 @@ void Server::subsetToString(char * destination,
       {
         return;
       }
-      char array_separator_str[length + 1];
-      constants::array_separator_constant_string.copy(array_separator_str);
-      strcat(destination,array_separator_str);
+      constants::array_separator_constant_string.copy(destination + strlen(destination));
       length_left -= length;
     }
     value_str[0] = '\0';
@@ -1836,9 +2873,13 @@ void Server::subsetToString(char * destination,
       }
       case JsonStream::STRING_TYPE:
       {
-        char cs_str[subset[i].cs_ptr->length() + 1];
-        subset[i].cs_ptr->copy(cs_str);
-        strncat(value_str,cs_str,constants::STRING_LENGTH_SUBSET_ELEMENT - 2);
+        size_t mark = request_arena_.getMark();
+        char * cs_str = request_arena_.allocateString(*subset[i].cs_ptr);
+        if (cs_str)
+        {
+          strncat(value_str,cs_str,constants::STRING_LENGTH_SUBSET_ELEMENT - 2);
+        }
+        request_arena_.rewind(mark);
         break;
       }
       case JsonStream::OBJECT_TYPE:
@@ -1868,9 +2909,8 @@ void Server::subsetToString(char * destination,
   {
     return;
   }
-  char array_close_str[length + 1];
-  constants::array_close_constant_string.copy(array_close_str);
-  strcat(destination,array_close_str);
+  constants::array_close_constant_string.copy(destination + strlen(destination));
+  response_.updateStackHighWater();
 }
 
 // Handlers
@@ -1959,13 +2999,14 @@ void Server::getPropertyDefaultValuesHandler()
 {
   ArduinoJson::JsonArray firmware_name_array;
   parameter(constants::firmware_constant_string).getValue(firmware_name_array);
+  constants::FirmwareMask firmware_mask = getFirmwareMask(firmware_name_array);
 
   response_.writeResultKey();
   response_.beginObject();
   for (size_t i=0; i<properties_.size(); ++i)
   {
     Property & property = properties_[i];
-    if (property.parameter().firmwareNameInArray(firmware_name_array))
+    if (property.firmwareInMask(firmware_mask))
     {
       property.writeValue(response_,true,true);
     }
@@ -1977,13 +3018,14 @@ void Server::getPropertyValuesHandler()
 {
   ArduinoJson::JsonArray firmware_name_array;
   parameter(constants::firmware_constant_string).getValue(firmware_name_array);
+  constants::FirmwareMask firmware_mask = getFirmwareMask(firmware_name_array);
 
   response_.writeResultKey();
   response_.beginObject();
   for (size_t i=0; i<properties_.size(); ++i)
   {
     Property & property = properties_[i];
-    if (property.parameter().firmwareNameInArray(firmware_name_array))
+    if (property.firmwareInMask(firmware_mask))
     {
       property.writeValue(response_,true,false);
     }
@@ -2044,4 +3086,368 @@ void Server::setPinValueHandler()
   response_.returnResult(pin_value);
 }
 
+#if MODULAR_SERVER_REQUEST_TRACE_COUNT_MAX > 0
+void Server::getRequestTraceHandler()
+{
+  size_t trace_count = request_count_;
+  if (trace_count > constants::REQUEST_TRACE_COUNT_MAX)
+  {
+    trace_count = constants::REQUEST_TRACE_COUNT_MAX;
+  }
+  // oldest first
+  size_t trace_index = (request_trace_index_ + constants::REQUEST_TRACE_COUNT_MAX - trace_count) % constants::REQUEST_TRACE_COUNT_MAX;
+
+  response_.writeResultKey();
+  response_.beginArray();
+  for (size_t i=0; i<trace_count; ++i)
+  {
+    writeRequestTraceToResponse(request_traces_[trace_index]);
+    trace_index = (trace_index + 1) % constants::REQUEST_TRACE_COUNT_MAX;
+  }
+  response_.endArray();
+}
+#endif
+
+void Server::getTimingInfoHandler()
+{
+  response_.writeResultKey();
+  writeTimingInfoToResponse();
+}
+
+void Server::getMemoryUsageHandler()
+{
+  response_.writeResultKey();
+  writeMemoryUsageToResponse();
+}
+
+void Server::resetStackHighWaterHandler()
+{
+  response_.resetStackHighWater();
+}
+
+void Server::setResponseFramingHandler()
+{
+  bool response_framing;
+  parameter(constants::response_framing_parameter_name).getValue(response_framing);
+
+  // takes effect with the next response so this one stays unframed
+  response_framing_[server_stream_index_] = response_framing;
+}
+
+#if MODULAR_SERVER_SEQUENCE_COUNT_MAX > 0
+void Server::setSequenceHandler()
+{
+  const char * sequence_name;
+  parameter(constants::sequence_name_parameter_name).getValue(sequence_name);
+
+  ArduinoJson::JsonArray sequence_steps;
+  parameter(constants::sequence_steps_parameter_name).getValue(sequence_steps);
+
+  int sequence_index = findSequenceIndex(sequence_name);
+
+  // an empty sequence removes it
+  if (sequence_steps.size() == 0)
+  {
+    if (sequence_index >= 0)
+    {
+      sequences_[sequence_index].name[0] = '\0';
+      sequences_[sequence_index].steps[0] = '\0';
+    }
+    return;
+  }
+  if (!sequenceStepsValid(sequence_steps))
+  {
+    response_.returnError(constants::sequence_step_error_data);
+    return;
+  }
+  if ((strlen(sequence_name) >= constants::STRING_LENGTH_SEQUENCE_NAME) ||
+    (measureJson(sequence_steps) >= constants::STRING_LENGTH_SEQUENCE))
+  {
+    response_.returnError(constants::sequence_too_long_error_data);
+    return;
+  }
+  for (size_t i=0; (sequence_index < 0) && (i<constants::SEQUENCE_COUNT_MAX); ++i)
+  {
+    if (sequences_[i].name[0] == '\0')
+    {
+      sequence_index = i;
+    }
+  }
+  if (sequence_index < 0)
+  {
+    response_.returnError(constants::sequence_storage_full_error_data);
+    return;
+  }
+  constants::Sequence & sequence = sequences_[sequence_index];
+  strcpy(sequence.name,sequence_name);
+  serializeJson(sequence_steps,sequence.steps,constants::STRING_LENGTH_SEQUENCE);
+}
+
+void Server::runSequenceHandler()
+{
+  const char * sequence_name;
+  parameter(constants::sequence_name_parameter_name).getValue(sequence_name);
+
+  ArduinoJson::JsonArray sequence_arguments;
+  parameter(constants::sequence_arguments_parameter_name).getValue(sequence_arguments);
+
+  if (sequence_running_)
+  {
+    response_.returnError(constants::sequence_nested_error_data);
+    return;
+  }
+  int sequence_index = findSequenceIndex(sequence_name);
+  if (sequence_index < 0)
+  {
+    response_.returnError(constants::sequence_not_found_error_data);
+    return;
+  }
+
+  // parsed from a const string so the stored steps are copied, not modified
+  ArenaJsonDocument json_document(constants::SEQUENCE_JSON_DOCUMENT_SIZE,ArenaAllocator(&request_arena_));
+  const char * sequence_steps_str = sequences_[sequence_index].steps;
+  ArduinoJson::DeserializationError error = deserializeJson(json_document,sequence_steps_str);
+  if (error)
+  {
+    response_.returnError(constants::sequence_too_long_error_data);
+    return;
+  }
+  ArduinoJson::JsonArray sequence_steps = json_document.as<ArduinoJson::JsonArray>();
+
+  ArduinoJson::JsonArray request_json_array = request_json_array_;
+  int request_method_index = request_method_index_;
+  sequence_running_ = true;
+  response_.disablePipeAsync();
+
+  response_.writeResultKey();
+  response_.beginArray();
+  for (ArduinoJson::JsonVariant step : sequence_steps)
+  {
+    request_json_array_ = step.as<ArduinoJson::JsonArray>();
+    replaceSequencePlaceholders(request_json_array_,sequence_arguments);
+    response_.beginStep();
+    processRequestArray();
+    if (!response_.endStep())
+    {
+      break;
+    }
+  }
+  response_.endArray();
+
+  response_.enablePipeAsync();
+  sequence_running_ = false;
+  request_json_array_ = request_json_array;
+  request_method_index_ = request_method_index;
+#if MODULAR_SERVER_REQUEST_TRACE_COUNT_MAX > 0
+  request_trace_.method_index = request_method_index;
+#endif
+}
+
+void Server::getSequencesHandler()
+{
+  response_.writeResultKey();
+  response_.beginArray();
+  for (size_t i=0; i<constants::SEQUENCE_COUNT_MAX; ++i)
+  {
+    if (sequences_[i].name[0] != '\0')
+    {
+      response_.write(sequences_[i].name);
+    }
+  }
+  response_.endArray();
+}
+#endif
+
+#if MODULAR_SERVER_TELEMETRY_COUNT_MAX > 0
+void Server::addTelemetryHandler()
+{
+  ArduinoJson::JsonArray telemetry_request;
+  parameter(constants::telemetry_request_parameter_name).getValue(telemetry_request);
+
+  long telemetry_period;
+  parameter(constants::telemetry_period_parameter_name).getValue(telemetry_period);
+
+  if (measureJson(telemetry_request) >= constants::STRING_LENGTH_TELEMETRY_REQUEST)
+  {
+    response_.returnError(constants::telemetry_request_too_long_error_data);
+    return;
+  }
+  int telemetry_id = -1;
+  for (size_t i=0; i<constants::TELEMETRY_COUNT_MAX; ++i)
+  {
+    if (!telemetry_[i].active)
+    {
+      telemetry_id = i;
+      break;
+    }
+  }
+  if (telemetry_id < 0)
+  {
+    response_.returnError(constants::telemetry_storage_full_error_data);
+    return;
+  }
+  constants::Telemetry & telemetry = telemetry_[telemetry_id];
+  serializeJson(telemetry_request,telemetry.request,constants::STRING_LENGTH_TELEMETRY_REQUEST);
+  telemetry.stream_index = server_stream_index_;
+  telemetry.period = telemetry_period;
+  telemetry.next_time = millis() + telemetry_period;
+  telemetry.sequence = 0;
+  telemetry.active = true;
+
+  response_.returnResult(telemetry_id);
+}
+
+void Server::removeTelemetryHandler()
+{
+  long telemetry_id;
+  parameter(constants::telemetry_id_parameter_name).getValue(telemetry_id);
+
+  telemetry_[telemetry_id].active = false;
+}
+#endif
+
+#if MODULAR_SERVER_RULE_COUNT_MAX > 0
+void Server::addRuleHandler()
+{
+  ArduinoJson::JsonArray rule_condition;
+  parameter(constants::rule_condition_parameter_name).getValue(rule_condition);
+
+  ArduinoJson::JsonArray rule_action;
+  parameter(constants::rule_action_parameter_name).getValue(rule_action);
+
+  Rule rule;
+  if (!setRuleCondition(rule,rule_condition))
+  {
+    response_.returnError(constants::rule_condition_error_data);
+    return;
+  }
+  if (!setRuleAction(rule,rule_action))
+  {
+    response_.returnError(constants::rule_action_error_data);
+    return;
+  }
+  int rule_id = rule_engine_.add(rule);
+  if (rule_id < 0)
+  {
+    response_.returnError(constants::rule_storage_full_error_data);
+    return;
+  }
+  response_.returnResult(rule_id);
+}
+
+void Server::removeRuleHandler()
+{
+  long rule_id;
+  parameter(constants::rule_id_parameter_name).getValue(rule_id);
+
+  rule_engine_.remove(rule_id);
+}
+
+void Server::getRulesHandler()
+{
+  response_.writeResultKey();
+  response_.beginArray();
+  Rule rule;
+  for (size_t i=0; i<constants::RULE_COUNT_MAX; ++i)
+  {
+    if (!rule_engine_.getRule(i,rule))
+    {
+      continue;
+    }
+    response_.beginObject();
+    response_.write(constants::rule_constant_string,i);
+    if (rule.condition == constants::RULE_CONDITION_PIN)
+    {
+      response_.write(constants::condition_constant_string,rule.condition_pin_ptr->getName());
+    }
+    else
+    {
+      response_.write(constants::condition_constant_string,rule.condition_property_ptr->getName());
+    }
+    if (rule.action == constants::RULE_ACTION_SET_PIN_VALUE)
+    {
+      response_.write(constants::action_constant_string,rule.action_pin_ptr->getName());
+    }
+    else
+    {
+      response_.write(constants::action_constant_string,rule.action_callback_ptr->getName());
+    }
+    response_.write(constants::hit_count_constant_string,rule.hit_count);
+    response_.write(constants::latency_constant_string,rule.latency);
+    response_.write(constants::latency_max_constant_string,rule.latency_max);
+    response_.endObject();
+  }
+  response_.endArray();
+}
+#endif
+
+#if MODULAR_SERVER_WAVEFORM_CHANNEL_COUNT_MAX > 0
+void Server::setupWaveformHandler()
+{
+  ArduinoJson::JsonArray waveform_pins;
+  parameter(constants::waveform_pins_parameter_name).getValue(waveform_pins);
+
+  long waveform_period;
+  parameter(constants::waveform_period_parameter_name).getValue(waveform_period);
+
+  // pulse modes are excluded since they add events from the timer interrupt
+  Array<Pin *,constants::WAVEFORM_CHANNEL_COUNT_MAX> pin_ptrs;
+  for (const char * pin_name : waveform_pins)
+  {
+    Pin * pin_ptr = pin_index_.findPinPtr(pin_name);
+    if ((pin_ptr == NULL) ||
+      ((pin_ptr->mode_ptr_ != &constants::pin_mode_digital_output) &&
+        (pin_ptr->mode_ptr_ != &constants::pin_mode_analog_output)))
+    {
+      response_.returnError(constants::waveform_pins_error_data);
+      return;
+    }
+    pin_ptrs.push_back(pin_ptr);
+  }
+  waveform_player_.setup(pin_ptrs,waveform_period);
+}
+
+void Server::addWaveformSamplesHandler()
+{
+  ArduinoJson::JsonArray waveform_samples;
+  parameter(constants::waveform_samples_parameter_name).getValue(waveform_samples);
+
+  size_t channel_count = waveform_player_.getChannelCount();
+  if ((channel_count == 0) || ((waveform_samples.size() % channel_count) != 0))
+  {
+    response_.returnError(constants::waveform_samples_error_data);
+    return;
+  }
+  if (!waveform_player_.addSamples(waveform_samples))
+  {
+    response_.returnError(constants::waveform_queue_full_error_data);
+    return;
+  }
+  response_.returnResult(waveform_player_.getUnderrunCount());
+}
+
+void Server::playWaveformHandler()
+{
+  waveform_player_.play();
+}
+
+void Server::stopWaveformHandler()
+{
+  waveform_player_.stop();
+}
+
+void Server::getWaveformStatusHandler()
+{
+  response_.writeResultKey();
+  response_.beginObject();
+  response_.write(constants::playing_constant_string,waveform_player_.playing());
+  response_.write(constants::channel_count_constant_string,waveform_player_.getChannelCount());
+  response_.write(constants::period_constant_string,waveform_player_.getPeriod());
+  response_.write(constants::frame_count_constant_string,waveform_player_.getFrameCount());
+  response_.write(constants::free_block_count_constant_string,waveform_player_.getFreeBlockCount());
+  response_.write(constants::underrun_count_constant_string,waveform_player_.getUnderrunCount());
+  response_.endObject();
+}
+#endif
+
 }
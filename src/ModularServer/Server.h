@@ -26,6 +26,16 @@
 #include "Callback.h"
 #include "Response.h"
 #include "Pin.h"
+#include "Arena.h"
+#include "DoubleFormatter.h"
+#include "FramedStream.h"
+#include "NullStream.h"
+#include "PipeForward.h"
+#include "ElementIndex.h"
+#include "PinIndex.h"
+#include "RuleEngine.h"
+#include "WaveformPlayer.h"
+#include "ServerContext.h"
 #include "Constants.h"
 
 
@@ -75,23 +85,35 @@ public:
   Property & createProperty(const ConstantString & property_name,
     const T (&default_value)[N]);
   Property & property(const ConstantString & property_name);
+  void setupProperty(const constants::PropertyInfo & property_info);
+  template <size_t N>
+  void setupProperties(const constants::PropertyInfo (&property_info_table)[N]);
   template <typename T>
   void setPropertiesToDefaults(T & firmware_name_array);
 
   // Parameters
   Parameter & createParameter(const ConstantString & parameter_name);
+  Parameter & createParameter(const constants::ParameterInfo & parameter_info);
+  template <size_t N>
+  void createParameters(const constants::ParameterInfo (&parameter_info_table)[N]);
   Parameter & parameter(const ConstantString & parameter_name);
   Parameter & copyParameter(Parameter parameter,
     const ConstantString & parameter_name);
 
   // Functions
   Function & createFunction(const ConstantString & function_name);
+  Function & createFunction(const constants::FunctionInfo & function_info);
+  template <size_t N>
+  void createFunctions(const constants::FunctionInfo (&function_info_table)[N]);
   Function & function(const ConstantString & function_name);
   Function & copyFunction(Function function,
     const ConstantString & function_name);
 
   // Callbacks
   Callback & createCallback(const ConstantString & callback_name);
+  Callback & createCallback(const constants::CallbackInfo & callback_info);
+  template <size_t N>
+  void createCallbacks(const constants::CallbackInfo (&callback_info_table)[N]);
   Callback & callback(const ConstantString & callback_name);
 
   // Response
@@ -102,28 +124,53 @@ public:
   void stopServer();
   void handleRequest();
 
+  // Timing Monitor
+  void enableTimingMonitor(unsigned long loop_period_deadline);
+  void disableTimingMonitor();
+  void resetTimingMonitor();
+
 private:
   Array<Stream *,constants::SERVER_STREAM_COUNT_MAX> server_stream_ptrs_;
   size_t server_stream_index_;
+  bool response_framing_[constants::SERVER_STREAM_COUNT_MAX];
+  FramedStream framed_stream_;
+  bool response_frame_open_;
+  PipeForward pipe_forwards_[constants::SERVER_STREAM_COUNT_MAX];
+  unsigned long pipe_forward_sequence_;
+  NullStream null_stream_;
   JsonStream server_json_stream_;
 
   ArduinoJson::JsonArray request_json_array_;
 
   Response response_;
 
+  char request_arena_storage_[constants::REQUEST_ARENA_SIZE];
+  Arena request_arena_;
+
+  ServerContext context_;
+  PropertyTables property_tables_;
+  CallbackTables callback_tables_;
+
   Array<const constants::HardwareInfo *,constants::HARDWARE_COUNT_MAX> hardware_info_array_;
   Pin dummy_pin_;
-  ConcatenatedArray<Pin,constants::HARDWARE_COUNT_MAX> pins_;
+  ConcatenatedArray<Pin,constants::HARDWARE_COUNT_MAX> pin_arrays_;
+  PinElementIndex pins_;
+  PinIndex pin_index_;
   Array<constants::SubsetMemberType,constants::PIN_COUNT_MAX+1> pin_name_array_;
+  constants::SubsetIndexEntry pin_name_subset_index_[constants::PIN_COUNT_MAX+1];
 
   Property server_properties_[constants::SERVER_PROPERTY_COUNT_MAX];
   Parameter server_parameters_[constants::SERVER_PARAMETER_COUNT_MAX];
   Function server_functions_[constants::SERVER_FUNCTION_COUNT_MAX];
   Callback server_callbacks_[constants::SERVER_CALLBACK_COUNT_MAX];
-  ConcatenatedArray<Property,constants::FIRMWARE_COUNT_MAX> properties_;
-  ConcatenatedArray<Parameter,constants::FIRMWARE_COUNT_MAX> parameters_;
-  ConcatenatedArray<Function,constants::FIRMWARE_COUNT_MAX> functions_;
-  ConcatenatedArray<Callback,constants::FIRMWARE_COUNT_MAX> callbacks_;
+  ConcatenatedArray<Property,constants::FIRMWARE_COUNT_MAX> property_arrays_;
+  ConcatenatedArray<Parameter,constants::FIRMWARE_COUNT_MAX> parameter_arrays_;
+  ConcatenatedArray<Function,constants::FIRMWARE_COUNT_MAX> function_arrays_;
+  ConcatenatedArray<Callback,constants::FIRMWARE_COUNT_MAX> callback_arrays_;
+  ElementIndex<Property,constants::PROPERTY_COUNT_MAX,constants::FIRMWARE_COUNT_MAX> properties_;
+  ElementIndex<Parameter,constants::PARAMETER_COUNT_MAX,constants::FIRMWARE_COUNT_MAX> parameters_;
+  ElementIndex<Function,constants::FUNCTION_COUNT_MAX,constants::FIRMWARE_COUNT_MAX> functions_;
+  ElementIndex<Callback,constants::CALLBACK_COUNT_MAX,constants::FIRMWARE_COUNT_MAX> callbacks_;
   Property dummy_property_;
   Parameter dummy_parameter_;
   Function dummy_function_;
@@ -133,6 +180,7 @@ private:
   const ConstantString * form_factor_ptr_;
   Array<const constants::FirmwareInfo *,constants::FIRMWARE_COUNT_MAX> firmware_info_array_;
   Array<constants::SubsetMemberType,constants::FIRMWARE_COUNT_MAX+1> firmware_name_array_;
+  constants::SubsetIndexEntry firmware_name_subset_index_[constants::FIRMWARE_COUNT_MAX+1];
 
   int request_method_index_;
   int property_function_index_;
@@ -141,6 +189,46 @@ private:
   SavedVariable eeprom_initialized_sv_;
   bool server_running_;
   const char * empty_string_ = "";
+  const ConstantString * api_table_error_data_ptr_;
+  const ConstantString * api_table_element_name_ptr_;
+  const ConstantString * api_table_name_ptr_;
+
+#if MODULAR_SERVER_REQUEST_TRACE_COUNT_MAX > 0
+  constants::RequestTrace request_traces_[constants::REQUEST_TRACE_COUNT_MAX];
+  size_t request_trace_index_;
+  unsigned long request_count_;
+  constants::RequestTrace request_trace_;
+  unsigned long request_trace_phase_time_;
+#endif
+
+  bool timing_monitor_enabled_;
+  unsigned long loop_period_deadline_;
+  unsigned long loop_time_;
+  unsigned long loop_count_;
+  unsigned long loop_period_max_;
+  unsigned long deadline_miss_count_;
+  unsigned long server_duration_max_;
+  unsigned long loop_period_histogram_[constants::LOOP_PERIOD_HISTOGRAM_BIN_COUNT];
+
+  size_t request_length_max_;
+  size_t json_document_usage_max_;
+
+#if MODULAR_SERVER_SEQUENCE_COUNT_MAX > 0
+  constants::Sequence sequences_[constants::SEQUENCE_COUNT_MAX];
+  bool sequence_running_;
+#endif
+
+#if MODULAR_SERVER_TELEMETRY_COUNT_MAX > 0
+  constants::Telemetry telemetry_[constants::TELEMETRY_COUNT_MAX];
+#endif
+
+#if MODULAR_SERVER_RULE_COUNT_MAX > 0
+  RuleEngine rule_engine_;
+#endif
+
+#if MODULAR_SERVER_WAVEFORM_CHANNEL_COUNT_MAX > 0
+  WaveformPlayer waveform_player_;
+#endif
 
   template <typename T>
   int findPinIndex(T const & pin_name);
@@ -169,9 +257,21 @@ private:
     ArduinoJson::JsonVariant json_value);
   bool checkArrayParameterElement(Parameter & parameter,
     ArduinoJson::JsonVariant json_value);
+  template <typename T>
+  bool checkArrayParameterElementBlocks(Parameter & parameter,
+    ArduinoJson::JsonArray json_array,
+    size_t array_length);
   long getSerialNumber();
+  void setApiTableError(const ConstantString * element_name_ptr,
+    const ConstantString & error_data,
+    const ConstantString & name);
   void initializeEeprom();
   void incrementServerStream();
+  void beginResponseFrame();
+  void endResponseFrame();
+  void beginPipeForward();
+  void endPipeForward(PipeForward & pipe_forward);
+  void updatePipeForwards();
   void help(bool verbose);
   void writeDeviceIdToResponse();
   void writeFirmwareInfoToResponse();
@@ -181,10 +281,12 @@ private:
   void writeApiToResponse(const ConstantString & verbosity,
     ArduinoJson::JsonArray firmware_name_array);
   bool containsAllOrMoreThanOne(ArduinoJson::JsonArray firmware_name_array);
-  size_t getPropertiesCount(ArduinoJson::JsonArray firmware_name_array);
-  size_t getParametersCount(ArduinoJson::JsonArray firmware_name_array);
-  size_t getFunctionsCount(ArduinoJson::JsonArray firmware_name_array);
-  size_t getCallbacksCount(ArduinoJson::JsonArray firmware_name_array);
+  template <typename T>
+  constants::FirmwareMask getFirmwareMask(T & firmware_name_array);
+  size_t getPropertiesCount(constants::FirmwareMask firmware_mask);
+  size_t getParametersCount(constants::FirmwareMask firmware_mask);
+  size_t getFunctionsCount(constants::FirmwareMask firmware_mask);
+  size_t getCallbacksCount(constants::FirmwareMask firmware_mask);
   void versionToString(char * destination,
     long major,
     long minor,
@@ -195,13 +297,43 @@ private:
     const JsonStream::JsonTypes & parameter_type,
     const JsonStream::JsonTypes & parameter_array_element_type,
     size_t num);
-  Pin * findPinPtrByChars(const char * pin_name);
   Pin * findPinPtrByConstantString(const ConstantString & pin_name);
   void setPinMode(const ConstantString & pin_name,
     const ConstantString & pin_mode);
   int getPinValue(const ConstantString & pin_name);
   void setPinValue(const ConstantString & pin_name,
     int pin_value);
+#if MODULAR_SERVER_REQUEST_TRACE_COUNT_MAX > 0
+  void beginRequestTrace();
+  unsigned long endRequestTracePhase();
+  void endRequestTrace();
+  void writeRequestTraceToResponse(const constants::RequestTrace & request_trace);
+#endif
+  void updateLoopPeriod(unsigned long time);
+  void updateServerDuration(unsigned long server_duration);
+  void writeTimingInfoToResponse();
+  void writeUsageToResponse(const ConstantString & key,
+    size_t used,
+    size_t max);
+  void writeSubsetUsageToResponse(Parameter & parameter);
+  void writeMemoryUsageToResponse();
+#if MODULAR_SERVER_SEQUENCE_COUNT_MAX > 0
+  int findSequenceIndex(const char * sequence_name);
+  bool sequenceStepsValid(ArduinoJson::JsonArray sequence_steps);
+  void replaceSequencePlaceholders(ArduinoJson::JsonArray request_array,
+    ArduinoJson::JsonArray sequence_arguments);
+#endif
+#if MODULAR_SERVER_TELEMETRY_COUNT_MAX > 0
+  void updateTelemetry();
+  void writeTelemetry(size_t telemetry_id,
+    unsigned long time);
+#endif
+#if MODULAR_SERVER_RULE_COUNT_MAX > 0
+  bool setRuleCondition(Rule & rule,
+    ArduinoJson::JsonArray rule_condition);
+  bool setRuleAction(Rule & rule,
+    ArduinoJson::JsonArray rule_action);
+#endif
 
   // Handlers
   void getMethodIdsHandler();
@@ -218,6 +350,34 @@ private:
   void setPinModeHandler();
   void getPinValueHandler();
   void setPinValueHandler();
+#if MODULAR_SERVER_REQUEST_TRACE_COUNT_MAX > 0
+  void getRequestTraceHandler();
+#endif
+  void getTimingInfoHandler();
+  void getMemoryUsageHandler();
+  void resetStackHighWaterHandler();
+  void setResponseFramingHandler();
+#if MODULAR_SERVER_SEQUENCE_COUNT_MAX > 0
+  void setSequenceHandler();
+  void runSequenceHandler();
+  void getSequencesHandler();
+#endif
+#if MODULAR_SERVER_TELEMETRY_COUNT_MAX > 0
+  void addTelemetryHandler();
+  void removeTelemetryHandler();
+#endif
+#if MODULAR_SERVER_RULE_COUNT_MAX > 0
+  void addRuleHandler();
+  void removeRuleHandler();
+  void getRulesHandler();
+#endif
+#if MODULAR_SERVER_WAVEFORM_CHANNEL_COUNT_MAX > 0
+  void setupWaveformHandler();
+  void addWaveformSamplesHandler();
+  void playWaveformHandler();
+  void stopWaveformHandler();
+  void getWaveformStatusHandler();
+#endif
 
 };
 }
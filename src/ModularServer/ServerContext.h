@@ -0,0 +1,43 @@
+// ----------------------------------------------------------------------------
+// ServerContext.h
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_SERVER_CONTEXT_H_
+#define _MODULAR_SERVER_SERVER_CONTEXT_H_
+#include <Arduino.h>
+#include <ConstantVariable.h>
+#include <ArduinoJson.h>
+#include <Array.h>
+#include <Functor.h>
+
+#include "Constants.h"
+
+
+namespace modular_server
+{
+class Arena;
+class Response;
+class PinIndex;
+class RuleEngine;
+struct PropertyTables;
+struct CallbackTables;
+
+// State each server shares with the elements it creates, so that several
+// servers may exist in one program without sharing requests or lookups
+struct ServerContext
+{
+  Arena * arena_ptr;
+  Response * response_ptr;
+  Functor1wRet<const ConstantString &,ArduinoJson::JsonVariant> get_parameter_value_functor;
+  Array<constants::SubsetMemberType,constants::PIN_COUNT_MAX+1> * pin_name_array_ptr;
+  PinIndex * pin_index_ptr;
+  PropertyTables * property_tables_ptr;
+  CallbackTables * callback_tables_ptr;
+  RuleEngine * rule_engine_ptr;
+};
+}
+
+#endif
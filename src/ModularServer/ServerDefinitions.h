@@ -23,7 +23,9 @@ void Server::addHardware(const constants::HardwareInfo & hardware_info,
   Pin (&pins)[PINS_MAX_SIZE])
 {
   hardware_info_array_.push_back(&hardware_info);
-  pins_.addArray(pins);
+  pin_arrays_.addArray(pins);
+  pins_.rebuild();
+  pin_index_.rebuild();
 }
 
 // Pins
@@ -47,10 +49,14 @@ void Server::addFirmware(const constants::FirmwareInfo & firmware_info,
   firmware_parameter.addValueToSubset(firmware_name_array_.back());
   // array length ranges is 1 less than subset size because one value is ALL
   firmware_parameter.setArrayLengthRange(1,(firmware_parameter.getSubsetSize() - 1));
-  properties_.addArray(properties);
-  parameters_.addArray(parameters);
-  functions_.addArray(functions);
-  callbacks_.addArray(callbacks);
+  property_arrays_.addArray(properties);
+  parameter_arrays_.addArray(parameters);
+  function_arrays_.addArray(functions);
+  callback_arrays_.addArray(callbacks);
+  properties_.rebuild();
+  parameters_.rebuild();
+  functions_.rebuild();
+  callbacks_.rebuild();
 }
 
 // Properties
@@ -61,10 +67,13 @@ Property & Server::createProperty(const ConstantString & property_name,
   int property_index = findPropertyIndex(property_name);
   if (property_index < 0)
   {
-    properties_.push_back(Property(property_name,
+    property_arrays_.push_back(Property(property_name,
         default_value));
+    properties_.update();
     const ConstantString * firmware_name_ptr = firmware_info_array_.back()->name_ptr;
     properties_.back().parameter().setFirmwareName(*firmware_name_ptr);
+    properties_.back().parameter().setFirmwareIndex(firmware_info_array_.size() - 1);
+    properties_.back().setContext(context_);
     return properties_.back();
   }
   return properties_[0]; // bad reference
@@ -78,22 +87,35 @@ Property & Server::createProperty(const ConstantString & property_name,
   int property_index = findPropertyIndex(property_name);
   if (property_index < 0)
   {
-    properties_.push_back(Property(property_name,
+    property_arrays_.push_back(Property(property_name,
         default_value));
+    properties_.update();
     const ConstantString * firmware_name_ptr = firmware_info_array_.back()->name_ptr;
     properties_.back().parameter().setFirmwareName(*firmware_name_ptr);
+    properties_.back().parameter().setFirmwareIndex(firmware_info_array_.size() - 1);
+    properties_.back().setContext(context_);
     return properties_.back();
   }
   return properties_[0]; // bad reference
 }
 
+template <size_t N>
+void Server::setupProperties(const constants::PropertyInfo (&property_info_table)[N])
+{
+  for (size_t i=0; i<N; ++i)
+  {
+    setupProperty(property_info_table[i]);
+  }
+}
+
 template <typename T>
 void Server::setPropertiesToDefaults(T & firmware_name_array)
 {
+  constants::FirmwareMask firmware_mask = getFirmwareMask(firmware_name_array);
   for (size_t i=0; i<properties_.size(); ++i)
   {
     Property & property = properties_[i];
-    if (property.parameter().firmwareNameInArray(firmware_name_array))
+    if (property.firmwareInMask(firmware_mask))
     {
       property.setValueToDefault();
     }
@@ -101,10 +123,34 @@ void Server::setPropertiesToDefaults(T & firmware_name_array)
 }
 
 // Parameters
+template <size_t N>
+void Server::createParameters(const constants::ParameterInfo (&parameter_info_table)[N])
+{
+  for (size_t i=0; i<N; ++i)
+  {
+    createParameter(parameter_info_table[i]);
+  }
+}
 
 // Functions
+template <size_t N>
+void Server::createFunctions(const constants::FunctionInfo (&function_info_table)[N])
+{
+  for (size_t i=0; i<N; ++i)
+  {
+    createFunction(function_info_table[i]);
+  }
+}
 
 // Callbacks
+template <size_t N>
+void Server::createCallbacks(const constants::CallbackInfo (&callback_info_table)[N])
+{
+  for (size_t i=0; i<N; ++i)
+  {
+    createCallback(callback_info_table[i]);
+  }
+}
 
 // Response
 
@@ -112,16 +158,7 @@ void Server::setPropertiesToDefaults(T & firmware_name_array)
 template <typename T>
 int Server::findPinIndex(T const & pin_name)
 {
-  int pin_index = -1;
-  for (size_t i=0; i<pins_.size(); ++i)
-  {
-    if (pins_[i].compareName(pin_name))
-    {
-      pin_index = i;
-      break;
-    }
-  }
-  return pin_index;
+  return pin_index_.findPinIndex(pin_name);
 }
 
 template <typename T>
@@ -202,6 +239,61 @@ int Server::findCallbackIndex(T const & callback_name)
   return callback_index;
 }
 
+template <typename T>
+constants::FirmwareMask Server::getFirmwareMask(T & firmware_name_array)
+{
+  // resolve the firmware names once so elements are filtered with one AND
+  constants::FirmwareMask firmware_mask = 0;
+  for (size_t i=0; i<firmware_info_array_.size(); ++i)
+  {
+    FirmwareElement firmware_element;
+    firmware_element.setFirmwareName(*(firmware_info_array_[i]->name_ptr));
+    if (firmware_element.firmwareNameInArray(firmware_name_array))
+    {
+      firmware_mask |= ((constants::FirmwareMask)1 << i);
+    }
+  }
+  return firmware_mask;
+}
+
+template <typename T>
+bool Server::checkArrayParameterElementBlocks(Parameter & parameter,
+  ArduinoJson::JsonArray json_array,
+  size_t array_length)
+{
+  // elements are checked a block at a time and a failing block is checked
+  // again element by element to write the error for its first bad element
+  T block[constants::ARRAY_VALUE_BLOCK_SIZE];
+  size_t block_size = 0;
+  size_t element_count = 0;
+  ArduinoJson::JsonArray::iterator block_begin = json_array.begin();
+  for (ArduinoJson::JsonArray::iterator it=json_array.begin(); it!=json_array.end(); ++it)
+  {
+    ArduinoJson::JsonVariant value = *it;
+    block[block_size++] = value.as<T>();
+    ++element_count;
+    if ((block_size < constants::ARRAY_VALUE_BLOCK_SIZE) && (element_count < array_length))
+    {
+      continue;
+    }
+    if (!parameter.valuesInSubset(block,block_size) || !parameter.valuesInRange(block,block_size))
+    {
+      ArduinoJson::JsonArray::iterator block_it = block_begin;
+      for (size_t i=0; i<block_size; ++i,++block_it)
+      {
+        if (!checkArrayParameterElement(parameter,*block_it))
+        {
+          return false;
+        }
+      }
+    }
+    block_size = 0;
+    block_begin = it;
+    ++block_begin;
+  }
+  return true;
+}
+
 }
 
 #endif
@@ -0,0 +1,255 @@
+// ----------------------------------------------------------------------------
+// SocketHost.cpp
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#include "SocketHost.h"
+#if defined(EPOXY_DUINO)
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#include "../ModularServer.h"
+
+
+namespace modular_server
+{
+// public
+SocketHost::SocketHost()
+{
+  modular_server_ptr_ = NULL;
+  listen_fd_ = -1;
+  epoll_fd_ = -1;
+}
+
+SocketHost::~SocketHost()
+{
+  close();
+}
+
+bool SocketHost::listenUnix(const char * path)
+{
+  struct sockaddr_un address;
+  if (strlen(path) >= sizeof(address.sun_path))
+  {
+    return false;
+  }
+  int listen_fd = ::socket(AF_UNIX,SOCK_STREAM,0);
+  if (listen_fd < 0)
+  {
+    return false;
+  }
+  memset(&address,0,sizeof(address));
+  address.sun_family = AF_UNIX;
+  strcpy(address.sun_path,path);
+  ::unlink(path);
+  if (::bind(listen_fd,(struct sockaddr *)&address,sizeof(address)) < 0)
+  {
+    ::close(listen_fd);
+    return false;
+  }
+  return listen(listen_fd);
+}
+
+bool SocketHost::listenTcp(uint16_t port)
+{
+  int listen_fd = ::socket(AF_INET,SOCK_STREAM,0);
+  if (listen_fd < 0)
+  {
+    return false;
+  }
+  int reuse = 1;
+  ::setsockopt(listen_fd,SOL_SOCKET,SO_REUSEADDR,&reuse,sizeof(reuse));
+  struct sockaddr_in address;
+  memset(&address,0,sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = htons(port);
+  if (::bind(listen_fd,(struct sockaddr *)&address,sizeof(address)) < 0)
+  {
+    ::close(listen_fd);
+    return false;
+  }
+  return listen(listen_fd);
+}
+
+int SocketHost::connectPair()
+{
+  if (!openEpoll())
+  {
+    return -1;
+  }
+  int socket_fds[2];
+  if (::socketpair(AF_UNIX,SOCK_STREAM,0,socket_fds) < 0)
+  {
+    return -1;
+  }
+  if (!addSocket(socket_fds[0]))
+  {
+    ::close(socket_fds[0]);
+    ::close(socket_fds[1]);
+    return -1;
+  }
+  // the caller owns the other end and is the client
+  return socket_fds[1];
+}
+
+void SocketHost::attach(ModularServer & modular_server)
+{
+  modular_server_ptr_ = &modular_server;
+  for (size_t i=0; i<constants::SERVER_STREAM_COUNT_MAX; ++i)
+  {
+    modular_server.addServerStream(socket_streams_[i]);
+  }
+}
+
+void SocketHost::poll(int timeout)
+{
+  if ((epoll_fd_ < 0) || (modular_server_ptr_ == NULL))
+  {
+    return;
+  }
+  // requests already buffered must not wait on the next socket event
+  if (dataBuffered())
+  {
+    timeout = 0;
+  }
+  struct epoll_event events[constants::SERVER_STREAM_COUNT_MAX + 1];
+  int event_count = ::epoll_wait(epoll_fd_,events,constants::SERVER_STREAM_COUNT_MAX + 1,timeout);
+  for (int i=0; i<event_count; ++i)
+  {
+    if (events[i].data.ptr == NULL)
+    {
+      accept();
+      continue;
+    }
+    SocketStream & socket_stream = *static_cast<SocketStream *>(events[i].data.ptr);
+    if ((socket_stream.receive() < 0) || (events[i].events & (EPOLLHUP | EPOLLERR)))
+    {
+      disconnect(socket_stream);
+    }
+  }
+  // the server handles one stream per call, so one call per stream visits each
+  // stream that has data once
+  if (dataBuffered())
+  {
+    for (size_t i=0; i<constants::SERVER_STREAM_COUNT_MAX; ++i)
+    {
+      modular_server_ptr_->handleServerRequests();
+    }
+  }
+}
+
+void SocketHost::close()
+{
+  for (size_t i=0; i<constants::SERVER_STREAM_COUNT_MAX; ++i)
+  {
+    socket_streams_[i].close();
+  }
+  if (listen_fd_ >= 0)
+  {
+    ::close(listen_fd_);
+    listen_fd_ = -1;
+  }
+  if (epoll_fd_ >= 0)
+  {
+    ::close(epoll_fd_);
+    epoll_fd_ = -1;
+  }
+}
+
+int SocketHost::getEpollFd()
+{
+  return epoll_fd_;
+}
+
+bool SocketHost::dataBuffered()
+{
+  for (size_t i=0; i<constants::SERVER_STREAM_COUNT_MAX; ++i)
+  {
+    if (socket_streams_[i].available() > 0)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// private
+bool SocketHost::listen(int listen_fd)
+{
+  close();
+  if ((::listen(listen_fd,constants::SERVER_STREAM_COUNT_MAX) < 0) ||
+    !openEpoll())
+  {
+    ::close(listen_fd);
+    return false;
+  }
+  listen_fd_ = listen_fd;
+  struct epoll_event event;
+  event.events = EPOLLIN;
+  event.data.ptr = NULL;
+  ::epoll_ctl(epoll_fd_,EPOLL_CTL_ADD,listen_fd_,&event);
+  return true;
+}
+
+bool SocketHost::openEpoll()
+{
+  if (epoll_fd_ < 0)
+  {
+    epoll_fd_ = ::epoll_create1(0);
+  }
+  return (epoll_fd_ >= 0);
+}
+
+void SocketHost::accept()
+{
+  int socket_fd = ::accept(listen_fd_,NULL,NULL);
+  if (socket_fd < 0)
+  {
+    return;
+  }
+  if (!addSocket(socket_fd))
+  {
+    // every server stream is in use
+    ::close(socket_fd);
+  }
+}
+
+bool SocketHost::addSocket(int socket_fd)
+{
+  for (size_t i=0; i<constants::SERVER_STREAM_COUNT_MAX; ++i)
+  {
+    SocketStream & socket_stream = socket_streams_[i];
+    if (!socket_stream.connected())
+    {
+      int no_delay = 1;
+      ::setsockopt(socket_fd,IPPROTO_TCP,TCP_NODELAY,&no_delay,sizeof(no_delay));
+      socket_stream.setSocket(socket_fd);
+      struct epoll_event event;
+      event.events = EPOLLIN | EPOLLRDHUP;
+      event.data.ptr = &socket_stream;
+      ::epoll_ctl(epoll_fd_,EPOLL_CTL_ADD,socket_fd,&event);
+      return true;
+    }
+  }
+  return false;
+}
+
+void SocketHost::disconnect(SocketStream & socket_stream)
+{
+  if (socket_stream.connected())
+  {
+    ::epoll_ctl(epoll_fd_,EPOLL_CTL_DEL,socket_stream.getSocket(),NULL);
+    socket_stream.close();
+  }
+}
+
+}
+#endif
@@ -0,0 +1,55 @@
+// ----------------------------------------------------------------------------
+// SocketHost.h
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_SOCKET_HOST_H_
+#define _MODULAR_SERVER_SOCKET_HOST_H_
+#if defined(EPOXY_DUINO)
+#include <Arduino.h>
+
+#include "SocketStream.h"
+#include "Constants.h"
+
+
+namespace modular_server
+{
+class ModularServer;
+
+// Accepts local clients on a unix socket or loopback tcp port, or connects
+// one end of a socketpair, one per server stream, and runs the server only when
+// epoll reports request data
+class SocketHost
+{
+public:
+  SocketHost();
+  ~SocketHost();
+
+  bool listenUnix(const char * path);
+  bool listenTcp(uint16_t port);
+  int connectPair();
+  void attach(ModularServer & modular_server);
+  void poll(int timeout);
+  void close();
+
+  // several hosts may be waited on at once by polling this descriptor
+  int getEpollFd();
+  bool dataBuffered();
+
+private:
+  ModularServer * modular_server_ptr_;
+  int listen_fd_;
+  int epoll_fd_;
+  SocketStream socket_streams_[constants::SERVER_STREAM_COUNT_MAX];
+  bool listen(int listen_fd);
+  bool openEpoll();
+  void accept();
+  bool addSocket(int socket_fd);
+  void disconnect(SocketStream & socket_stream);
+};
+}
+
+#endif
+#endif
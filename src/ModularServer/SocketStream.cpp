@@ -0,0 +1,156 @@
+// ----------------------------------------------------------------------------
+// SocketStream.cpp
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#include "SocketStream.h"
+#if defined(EPOXY_DUINO)
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+
+namespace modular_server
+{
+// public
+SocketStream::SocketStream()
+{
+  socket_fd_ = -1;
+  read_start_ = 0;
+  read_end_ = 0;
+  write_size_ = 0;
+}
+
+void SocketStream::setSocket(int socket_fd)
+{
+  socket_fd_ = socket_fd;
+  read_start_ = 0;
+  read_end_ = 0;
+  write_size_ = 0;
+}
+
+int SocketStream::getSocket()
+{
+  return socket_fd_;
+}
+
+bool SocketStream::connected()
+{
+  return (socket_fd_ >= 0);
+}
+
+void SocketStream::close()
+{
+  if (socket_fd_ >= 0)
+  {
+    ::close(socket_fd_);
+  }
+  setSocket(-1);
+}
+
+long SocketStream::receive()
+{
+  if (!connected())
+  {
+    return -1;
+  }
+  if (read_start_ == read_end_)
+  {
+    read_start_ = 0;
+    read_end_ = 0;
+  }
+  else if (read_start_ > 0)
+  {
+    memmove(read_buffer_,read_buffer_ + read_start_,read_end_ - read_start_);
+    read_end_ -= read_start_;
+    read_start_ = 0;
+  }
+  if (read_end_ == sizeof(read_buffer_))
+  {
+    return 0;
+  }
+  ssize_t bytes_received = ::recv(socket_fd_,
+    read_buffer_ + read_end_,
+    sizeof(read_buffer_) - read_end_,
+    MSG_DONTWAIT);
+  if (bytes_received > 0)
+  {
+    read_end_ += bytes_received;
+    return bytes_received;
+  }
+  if ((bytes_received < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR)))
+  {
+    return 0;
+  }
+  // peer closed the connection or the socket failed
+  close();
+  return -1;
+}
+
+int SocketStream::available()
+{
+  return read_end_ - read_start_;
+}
+
+int SocketStream::read()
+{
+  if (read_start_ == read_end_)
+  {
+    return -1;
+  }
+  return read_buffer_[read_start_++];
+}
+
+int SocketStream::peek()
+{
+  if (read_start_ == read_end_)
+  {
+    return -1;
+  }
+  return read_buffer_[read_start_];
+}
+
+size_t SocketStream::write(uint8_t byte)
+{
+  if (!connected())
+  {
+    return 0;
+  }
+  write_buffer_[write_size_++] = byte;
+  // responses end with a newline so each one is sent as soon as it is complete
+  if ((write_size_ == sizeof(write_buffer_)) || (byte == '\n'))
+  {
+    flush();
+  }
+  return 1;
+}
+
+void SocketStream::flush()
+{
+  size_t bytes_sent = 0;
+  while (connected() && (bytes_sent < write_size_))
+  {
+    ssize_t result = ::send(socket_fd_,
+      write_buffer_ + bytes_sent,
+      write_size_ - bytes_sent,
+      MSG_NOSIGNAL);
+    if (result > 0)
+    {
+      bytes_sent += result;
+    }
+    else if ((result < 0) && (errno == EINTR))
+    {
+      continue;
+    }
+    else
+    {
+      close();
+    }
+  }
+  write_size_ = 0;
+}
+
+}
+#endif
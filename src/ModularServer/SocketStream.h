@@ -0,0 +1,49 @@
+// ----------------------------------------------------------------------------
+// SocketStream.h
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_SOCKET_STREAM_H_
+#define _MODULAR_SERVER_SOCKET_STREAM_H_
+#if defined(EPOXY_DUINO)
+#include <Arduino.h>
+
+#include "Constants.h"
+
+
+namespace modular_server
+{
+// Stream over a connected unix or tcp socket for host builds, so a server may
+// be driven by local clients instead of serial hardware
+class SocketStream : public Stream
+{
+public:
+  SocketStream();
+
+  void setSocket(int socket_fd);
+  int getSocket();
+  bool connected();
+  void close();
+  long receive();
+
+  virtual int available();
+  virtual int read();
+  virtual int peek();
+  virtual size_t write(uint8_t byte);
+  virtual void flush();
+  using Print::write;
+
+private:
+  int socket_fd_;
+  uint8_t read_buffer_[constants::SOCKET_STREAM_BUFFER_SIZE];
+  size_t read_start_;
+  size_t read_end_;
+  uint8_t write_buffer_[constants::SOCKET_STREAM_BUFFER_SIZE];
+  size_t write_size_;
+};
+}
+
+#endif
+#endif
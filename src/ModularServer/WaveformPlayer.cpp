@@ -0,0 +1,182 @@
+// ----------------------------------------------------------------------------
+// WaveformPlayer.cpp
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#include "WaveformPlayer.h"
+#include "Pin.h"
+
+
+namespace modular_server
+{
+#if MODULAR_SERVER_WAVEFORM_CHANNEL_COUNT_MAX > 0
+// public
+WaveformPlayer::WaveformPlayer()
+{
+  period_ = 0;
+  playing_ = false;
+  clear();
+}
+
+void WaveformPlayer::setup(const Array<Pin *,constants::WAVEFORM_CHANNEL_COUNT_MAX> & pin_ptrs,
+  unsigned long period)
+{
+  stop();
+  pin_ptrs_ = pin_ptrs;
+  period_ = period;
+  clear();
+}
+
+bool WaveformPlayer::addSamples(ArduinoJson::JsonArray samples)
+{
+  // blocks are filled in the order they are played, so the block to fill is
+  // always the next one the timer will need once it is free
+  if (blocks_full_[fill_block_])
+  {
+    return false;
+  }
+  size_t channel_count = pin_ptrs_.size();
+  if ((channel_count == 0) ||
+    (samples.size() < channel_count) ||
+    (samples.size() > constants::WAVEFORM_BLOCK_SAMPLE_COUNT_MAX))
+  {
+    return false;
+  }
+  int * block = blocks_[fill_block_];
+  size_t block_size = 0;
+  for (long sample : samples)
+  {
+    block[block_size++] = sample;
+  }
+  // a trailing partial frame is never played
+  block_size -= block_size % channel_count;
+  block_sizes_[fill_block_] = block_size;
+  blocks_full_[fill_block_] = true;
+  fill_block_ = (fill_block_ + 1) % constants::WAVEFORM_BLOCK_COUNT;
+  return true;
+}
+
+void WaveformPlayer::play()
+{
+  if (playing_ || (pin_ptrs_.size() == 0) || (period_ == 0))
+  {
+    return;
+  }
+  event_id_ = Pin::pin_pulse_event_controller_.addInfiniteRecurringEventUsingDelay(makeFunctor((Functor1<int> *)0,*this,&WaveformPlayer::playFrameHandler),
+    0,
+    period_);
+  Pin::pin_pulse_event_controller_.enable(event_id_);
+  playing_ = true;
+}
+
+void WaveformPlayer::stop()
+{
+  if (!playing_)
+  {
+    return;
+  }
+  Pin::pin_pulse_event_controller_.remove(event_id_);
+  playing_ = false;
+  starved_ = false;
+}
+
+bool WaveformPlayer::playing()
+{
+  return playing_;
+}
+
+size_t WaveformPlayer::getChannelCount()
+{
+  return pin_ptrs_.size();
+}
+
+unsigned long WaveformPlayer::getPeriod()
+{
+  return period_;
+}
+
+unsigned long WaveformPlayer::getFrameCount()
+{
+  noInterrupts();
+  unsigned long frame_count = frame_count_;
+  interrupts();
+  return frame_count;
+}
+
+size_t WaveformPlayer::getFreeBlockCount()
+{
+  size_t free_block_count = 0;
+  for (size_t i=0; i<constants::WAVEFORM_BLOCK_COUNT; ++i)
+  {
+    if (!blocks_full_[i])
+    {
+      ++free_block_count;
+    }
+  }
+  return free_block_count;
+}
+
+unsigned long WaveformPlayer::getUnderrunCount()
+{
+  noInterrupts();
+  unsigned long underrun_count = underrun_count_;
+  interrupts();
+  return underrun_count;
+}
+
+// private
+void WaveformPlayer::clear()
+{
+  for (size_t i=0; i<constants::WAVEFORM_BLOCK_COUNT; ++i)
+  {
+    block_sizes_[i] = 0;
+    blocks_full_[i] = false;
+  }
+  fill_block_ = 0;
+  play_block_ = 0;
+  play_position_ = 0;
+  frame_count_ = 0;
+  underrun_count_ = 0;
+  starved_ = false;
+}
+
+void WaveformPlayer::playFrameHandler(int arg)
+{
+  size_t play_block = play_block_;
+  if (!blocks_full_[play_block])
+  {
+    // the pins hold the last frame until the block is refilled, waiting for
+    // the first block or after the last one is not an underrun
+    if (frame_count_ > 0)
+    {
+      starved_ = true;
+    }
+    return;
+  }
+  if (starved_)
+  {
+    // a block arrived after the previous one ran dry
+    ++underrun_count_;
+    starved_ = false;
+  }
+  const int * block = blocks_[play_block];
+  size_t channel_count = pin_ptrs_.size();
+  size_t play_position = play_position_;
+  for (size_t channel=0; channel<channel_count; ++channel)
+  {
+    pin_ptrs_[channel]->setValue(block[play_position + channel]);
+  }
+  ++frame_count_;
+  play_position += channel_count;
+  if ((play_position + channel_count) > block_sizes_[play_block])
+  {
+    play_position = 0;
+    blocks_full_[play_block] = false;
+    play_block_ = (play_block + 1) % constants::WAVEFORM_BLOCK_COUNT;
+  }
+  play_position_ = play_position;
+}
+#endif
+}
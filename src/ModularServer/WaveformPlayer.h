@@ -0,0 +1,67 @@
+// ----------------------------------------------------------------------------
+// WaveformPlayer.h
+//
+//
+// Authors:
+// Peter Polidoro peterpolidoro@gmail.com
+// ----------------------------------------------------------------------------
+#ifndef _MODULAR_SERVER_WAVEFORM_PLAYER_H_
+#define _MODULAR_SERVER_WAVEFORM_PLAYER_H_
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <Array.h>
+#include <Functor.h>
+#include <EventController.h>
+
+#include "Constants.h"
+
+
+namespace modular_server
+{
+#if MODULAR_SERVER_WAVEFORM_CHANNEL_COUNT_MAX > 0
+class Pin;
+
+// Writes one frame of samples to its output pins every period from the pin
+// pulse timer, playing one block while the other is refilled
+class WaveformPlayer
+{
+public:
+  WaveformPlayer();
+
+  void setup(const Array<Pin *,constants::WAVEFORM_CHANNEL_COUNT_MAX> & pin_ptrs,
+    unsigned long period);
+  bool addSamples(ArduinoJson::JsonArray samples);
+  void play();
+  void stop();
+
+  bool playing();
+  size_t getChannelCount();
+  unsigned long getPeriod();
+  unsigned long getFrameCount();
+  size_t getFreeBlockCount();
+  unsigned long getUnderrunCount();
+
+private:
+  Array<Pin *,constants::WAVEFORM_CHANNEL_COUNT_MAX> pin_ptrs_;
+  unsigned long period_;
+  int blocks_[constants::WAVEFORM_BLOCK_COUNT][constants::WAVEFORM_BLOCK_SAMPLE_COUNT_MAX];
+  size_t block_sizes_[constants::WAVEFORM_BLOCK_COUNT];
+  volatile bool blocks_full_[constants::WAVEFORM_BLOCK_COUNT];
+  size_t fill_block_;
+  volatile size_t play_block_;
+  volatile size_t play_position_;
+  volatile unsigned long frame_count_;
+  volatile unsigned long underrun_count_;
+  volatile bool starved_;
+  EventId event_id_;
+  bool playing_;
+
+  void clear();
+
+  // Handlers
+  void playFrameHandler(int arg);
+};
+#endif
+}
+
+#endif